@@ -21,6 +21,7 @@
 #include <ZLFile.h>
 
 #include "BookModel.h"
+#include "BookModelCache.h"
 #include "BookReader.h"
 
 #include "../formats/FormatPlugin.h"
@@ -29,10 +30,22 @@
 BookModel::BookModel(const shared_ptr<Book> book) : myBook(book) {
 	myBookTextModel = new ZLTextPlainModel(book->language(), 102400);
 	myContentsModel = new ContentsModel(book->language());
+	if (BookModelCache::load(*this)) {
+		return;
+	}
+
+	// cache could be loaded partially
+	myBookTextModel = new ZLTextPlainModel(book->language(), 102400);
+	myContentsModel = new ContentsModel(book->language());
+	myImages.clear();
+	myFootnotes.clear();
+	myInternalHyperlinks.clear();
+
 	ZLFile file(book->filePath());
 	shared_ptr<FormatPlugin> plugin = PluginCollection::Instance().plugin(file, false);
 	if (!plugin.isNull()) {
 		plugin->readModel(*this);
+		BookModelCache::save(*this);
 	}
 }
 
@@ -39,6 +39,8 @@ public:
 
 private:
 	std::map<const ZLTextTreeParagraph*,int> myReferenceByParagraph;
+
+friend class BookModelCache;
 };
 
 class BookModel : public ZLUserDataHolder {
@@ -82,6 +84,7 @@ private:
 	shared_ptr<HyperlinkMatcher> myHyperlinkMatcher;
 
 friend class BookReader;
+friend class BookModelCache;
 };
 
 inline shared_ptr<ZLTextModel> BookModel::bookTextModel() const { return myBookTextModel; }
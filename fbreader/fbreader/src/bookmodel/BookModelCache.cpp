@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <cstring>
+#include <algorithm>
+
+#include <ZLibrary.h>
+#include <ZLFile.h>
+#include <ZLDir.h>
+#include <ZLFileMapping.h>
+#include <ZLOutputStream.h>
+#include <ZLStringUtil.h>
+#include <ZLImage.h>
+#include <ZLFileImage.h>
+#include <ZLOptions.h>
+
+#include "BookModelCache.h"
+#include "BookModel.h"
+
+#include "../library/Book.h"
+#include "../formats/txt/PlainTextFormat.h"
+
+static const char CACHE_MAGIC[4] = { 'F', 'B', 'M', 'C' };
+static const int CACHE_VERSION = 3;
+static const size_t MAX_CACHE_FILES = 16;
+
+static const std::string OPTIONS_GROUP = "BookModelCache";
+static const std::string OPTION_AccessCounter = "AccessCounter";
+
+template <class T>
+static void appendValue(std::string &buffer, const T &value) {
+	buffer.append((const char*)&value, sizeof(T));
+}
+
+static void appendString(std::string &buffer, const std::string &str) {
+	appendValue(buffer, str.length());
+	buffer.append(str);
+}
+
+template <class T>
+static bool readValue(const char *&ptr, const char *end, T &value) {
+	if ((size_t)(end - ptr) < sizeof(T)) {
+		return false;
+	}
+	memcpy(&value, ptr, sizeof(T));
+	ptr += sizeof(T);
+	return true;
+}
+
+static bool readString(const char *&ptr, const char *end, std::string &str) {
+	size_t length;
+	if (!readValue(ptr, end, length) || (length > (size_t)(end - ptr))) {
+		return false;
+	}
+	str.assign(ptr, length);
+	ptr += length;
+	return true;
+}
+
+std::string BookModelCache::cacheDirectory() {
+	return ZLibrary::ApplicationWritableDirectory() + ZLibrary::FileNameDelimiter + "bookCache";
+}
+
+std::string BookModelCache::cacheFilePath(const BookModel &model) {
+	const std::string &path = model.book()->filePath();
+	unsigned int hash = 2166136261U;
+	for (std::string::const_iterator it = path.begin(); it != path.end(); ++it) {
+		hash = (hash ^ (unsigned char)*it) * 16777619U;
+	}
+	std::string name;
+	ZLStringUtil::appendNumber(name, hash);
+	return cacheDirectory() + ZLibrary::FileNameDelimiter + name + ".cache";
+}
+
+std::string BookModelCache::header(const BookModel &model) {
+	const Book &book = *model.book();
+	const ZLFile physicalFile(ZLFile(book.filePath()).physicalFilePath());
+
+	std::string buffer(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	appendValue(buffer, CACHE_VERSION);
+	appendValue(buffer, (int)sizeof(void*));
+	appendString(buffer, book.filePath());
+	appendString(buffer, book.encoding());
+	appendString(buffer, book.language());
+	appendValue(buffer, physicalFile.size());
+	appendValue(buffer, physicalFile.mtime());
+
+	// the plain text format options of the book change the way
+	// html, txt and some other plugins split the text into paragraphs
+	const PlainTextFormat format(book.filePath());
+	appendValue(buffer, format.initialized());
+	appendValue(buffer, format.breakType());
+	appendValue(buffer, format.ignoredIndent());
+	appendValue(buffer, format.emptyLinesBeforeNewSection());
+	appendValue(buffer, format.createContentsTable());
+	return buffer;
+}
+
+ZLIntegerOption *BookModelCache::accessOption(const std::string &path) {
+	return new ZLIntegerOption(ZLCategoryKey::STATE, OPTIONS_GROUP, ZLFile(path).name(false), 0);
+}
+
+void BookModelCache::markAccess(const std::string &path) {
+	ZLIntegerOption counterOption(ZLCategoryKey::STATE, OPTIONS_GROUP, OPTION_AccessCounter, 0);
+	const int counter = counterOption.value() + 1;
+	counterOption.setValue(counter);
+	shared_ptr<ZLIntegerOption> option = accessOption(path);
+	option->setValue(counter);
+}
+
+bool BookModelCache::load(BookModel &model) {
+	const std::string path = cacheFilePath(model);
+	ZLFile file(path);
+	if (!file.exists()) {
+		return false;
+	}
+	shared_ptr<ZLFileMapping> mapping = file.mapping();
+	if (mapping.isNull()) {
+		return false;
+	}
+
+	const std::string expected = header(model);
+	const char *ptr = mapping->data();
+	const char *end = ptr + mapping->size();
+	if ((mapping->size() < expected.length()) ||
+			(memcmp(ptr, expected.data(), expected.length()) != 0)) {
+		return false;
+	}
+	ptr += expected.length();
+
+	if (!model.myBookTextModel->readCache(mapping, ptr, model.myImages) ||
+			!model.myContentsModel->readCache(mapping, ptr, model.myImages)) {
+		return false;
+	}
+
+	ContentsModel &contentsModel = (ContentsModel&)*model.myContentsModel;
+	size_t referencesNumber;
+	if (!readValue(ptr, end, referencesNumber)) {
+		return false;
+	}
+	for (size_t i = 0; i < referencesNumber; ++i) {
+		size_t index;
+		int reference;
+		if (!readValue(ptr, end, index) || !readValue(ptr, end, reference) ||
+				(index >= contentsModel.paragraphsNumber())) {
+			return false;
+		}
+		contentsModel.setReference((const ZLTextTreeParagraph*)contentsModel[index], reference);
+	}
+
+	std::vector<shared_ptr<ZLTextModel> > footnotes;
+	size_t footnotesNumber;
+	if (!readValue(ptr, end, footnotesNumber)) {
+		return false;
+	}
+	for (size_t i = 0; i < footnotesNumber; ++i) {
+		std::string id;
+		if (!readString(ptr, end, id)) {
+			return false;
+		}
+		shared_ptr<ZLTextModel> footnote = new ZLTextPlainModel(model.myBookTextModel->language(), 8192);
+		if (!footnote->readCache(mapping, ptr, model.myImages)) {
+			return false;
+		}
+		model.myFootnotes.insert(std::make_pair(id, footnote));
+		footnotes.push_back(footnote);
+	}
+
+	while (true) {
+		bool hasImage;
+		if (!readValue(ptr, end, hasImage)) {
+			return false;
+		}
+		if (!hasImage) {
+			break;
+		}
+		std::string id;
+		std::string mimeType;
+		size_t size;
+		if (!readString(ptr, end, id) || !readString(ptr, end, mimeType) ||
+				!readValue(ptr, end, size) || (size == 0) || (size > (size_t)(end - ptr))) {
+			// an image of size 0 would be read as the whole cache file
+			return false;
+		}
+		model.myImages[id] = new ZLFileImage(mimeType, path, ptr - mapping->data(), size);
+		ptr += size;
+	}
+
+	size_t labelsNumber;
+	if (!readValue(ptr, end, labelsNumber)) {
+		return false;
+	}
+	for (size_t i = 0; i < labelsNumber; ++i) {
+		std::string label;
+		int modelIndex;
+		int paragraphNumber;
+		if (!readString(ptr, end, label) ||
+				!readValue(ptr, end, modelIndex) ||
+				!readValue(ptr, end, paragraphNumber) ||
+				(modelIndex < -1) || (modelIndex >= (int)footnotes.size() + 2)) {
+			return false;
+		}
+		shared_ptr<ZLTextModel> labelModel;
+		switch (modelIndex) {
+			case -1:
+				break;
+			case 0:
+				labelModel = model.myBookTextModel;
+				break;
+			case 1:
+				labelModel = model.myContentsModel;
+				break;
+			default:
+				labelModel = footnotes[modelIndex - 2];
+				break;
+		}
+		model.myInternalHyperlinks.insert(std::make_pair(label, BookModel::Label(labelModel, paragraphNumber)));
+	}
+
+	if (ptr != end) {
+		return false;
+	}
+	markAccess(path);
+	return true;
+}
+
+void BookModelCache::save(const BookModel &model) {
+	if (!model.myHyperlinkMatcher.isNull()) {
+		return;
+	}
+	for (ZLImageMap::const_iterator it = model.myImages.begin(); it != model.myImages.end(); ++it) {
+		if (it->second.isNull() || !it->second->isSingle()) {
+			return;
+		}
+	}
+
+	ZLFile(cacheDirectory()).directory(true);
+	removeOldFiles();
+
+	shared_ptr<ZLOutputStream> stream = ZLFile(cacheFilePath(model)).outputStream();
+	if (stream.isNull() || !stream->open()) {
+		return;
+	}
+
+	std::string buffer = header(model);
+	stream->write(buffer);
+	model.myBookTextModel->writeCache(*stream);
+	model.myContentsModel->writeCache(*stream);
+
+	buffer.erase();
+	const ContentsModel &contentsModel = (const ContentsModel&)*model.myContentsModel;
+	appendValue(buffer, contentsModel.myReferenceByParagraph.size());
+	const size_t contentsSize = contentsModel.paragraphsNumber();
+	for (size_t i = 0; i < contentsSize; ++i) {
+		const ZLTextTreeParagraph *paragraph = (const ZLTextTreeParagraph*)contentsModel[i];
+		std::map<const ZLTextTreeParagraph*,int>::const_iterator jt = contentsModel.myReferenceByParagraph.find(paragraph);
+		if (jt != contentsModel.myReferenceByParagraph.end()) {
+			appendValue(buffer, i);
+			appendValue(buffer, jt->second);
+		}
+	}
+	appendValue(buffer, model.myFootnotes.size());
+	stream->write(buffer);
+
+	std::map<const ZLTextModel*,int> modelIndices;
+	modelIndices[&*model.myBookTextModel] = 0;
+	modelIndices[&*model.myContentsModel] = 1;
+	int index = 2;
+	for (std::map<std::string,shared_ptr<ZLTextModel> >::const_iterator it = model.myFootnotes.begin(); it != model.myFootnotes.end(); ++it) {
+		buffer.erase();
+		appendString(buffer, it->first);
+		stream->write(buffer);
+		it->second->writeCache(*stream);
+		modelIndices[&*it->second] = index++;
+	}
+
+	// images without data are left out, the text model skips the
+	// images it can't find like the ones it can't decode; the number of
+	// the images isn't known before their data is read, so every entry
+	// is preceded by a flag and the list ends with a false one
+	for (ZLImageMap::const_iterator it = model.myImages.begin(); it != model.myImages.end(); ++it) {
+		const ZLSingleImage &image = (const ZLSingleImage&)*it->second;
+		shared_ptr<std::string> data = image.stringData();
+		if (data.isNull() || data->empty()) {
+			continue;
+		}
+		buffer.erase();
+		appendValue(buffer, true);
+		appendString(buffer, it->first);
+		appendString(buffer, image.mimeType());
+		appendValue(buffer, data->length());
+		stream->write(buffer);
+		stream->write(*data);
+	}
+	buffer.erase();
+	appendValue(buffer, false);
+	stream->write(buffer);
+
+	buffer.erase();
+	appendValue(buffer, model.myInternalHyperlinks.size());
+	for (std::map<std::string,BookModel::Label>::const_iterator it = model.myInternalHyperlinks.begin(); it != model.myInternalHyperlinks.end(); ++it) {
+		int modelIndex = -1;
+		if (!it->second.Model.isNull()) {
+			std::map<const ZLTextModel*,int>::const_iterator jt = modelIndices.find(&*it->second.Model);
+			if (jt != modelIndices.end()) {
+				modelIndex = jt->second;
+			}
+		}
+		appendString(buffer, it->first);
+		appendValue(buffer, modelIndex);
+		appendValue(buffer, it->second.ParagraphNumber);
+	}
+	stream->write(buffer);
+
+	stream->close();
+	markAccess(cacheFilePath(model));
+}
+
+void BookModelCache::removeOldFiles() {
+	shared_ptr<ZLDir> dir = ZLFile(cacheDirectory()).directory();
+	if (dir.isNull()) {
+		return;
+	}
+	std::vector<std::string> names;
+	dir->collectFiles(names, false);
+	if (names.size() < MAX_CACHE_FILES) {
+		return;
+	}
+	// least recently opened books go first
+	std::vector<std::pair<int,std::string> > files;
+	for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+		const std::string path = dir->itemPath(*it);
+		shared_ptr<ZLIntegerOption> option = accessOption(path);
+		files.push_back(std::make_pair(option->value(), path));
+	}
+	std::sort(files.begin(), files.end());
+	for (size_t i = 0; i + MAX_CACHE_FILES <= files.size(); ++i) {
+		ZLFile(files[i].second).remove();
+		shared_ptr<ZLIntegerOption> option = accessOption(files[i].second);
+		option->setValue(0);
+	}
+}
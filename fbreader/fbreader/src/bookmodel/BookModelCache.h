@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __BOOKMODELCACHE_H__
+#define __BOOKMODELCACHE_H__
+
+#include <string>
+
+class BookModel;
+class ZLIntegerOption;
+
+/*
+ * Parsed books are stored in ApplicationWritableDirectory()/bookCache,
+ * one file per book. A cache file is valid while the book file keeps its
+ * path, size and modification time and while the format options of the
+ * book are not changed; text models are restored by mapping the file into
+ * memory without any parsing. Least recently opened files are removed.
+ */
+class BookModelCache {
+
+public:
+	static bool load(BookModel &model);
+	static void save(const BookModel &model);
+
+private:
+	static std::string cacheDirectory();
+	static std::string cacheFilePath(const BookModel &model);
+	static std::string header(const BookModel &model);
+	static ZLIntegerOption *accessOption(const std::string &path);
+	static void markAccess(const std::string &path);
+	static void removeOldFiles();
+
+private:
+	BookModelCache();
+};
+
+#endif /* __BOOKMODELCACHE_H__ */
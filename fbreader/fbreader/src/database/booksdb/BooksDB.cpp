@@ -80,6 +80,10 @@ bool BooksDB::initDatabase() {
 		return false;
 	}
 
+	// a single user database does not need a full sync on every commit;
+	// failing to switch the journal mode is not an error
+	SQLiteFactory::createCommand(BooksDBQuery::TUNE_DATABASE, connection())->execute();
+
 	shared_ptr<DBRunnable> runnable = new InitBooksDBRunnable(connection());
 	if (!executeAsTransaction(*runnable)) {
 		myInitialized = false;
@@ -27,6 +27,14 @@ const std::string BooksDBQuery::PREINIT_DATABASE = \
 	"ATTACH @stateFile AS State; " \
 	"ATTACH @netFile AS Net; ";
 
+// statements are prepared all at once, so these cannot go into
+// PREINIT_DATABASE: the attached databases do not exist there yet
+const std::string BooksDBQuery::TUNE_DATABASE = \
+	"PRAGMA journal_mode = WAL; " \
+	"PRAGMA main.synchronous = NORMAL; " \
+	"PRAGMA State.synchronous = NORMAL; " \
+	"PRAGMA Net.synchronous = NORMAL; ";
+
 const std::string BooksDBQuery::INIT_DATABASE = \
 	"CREATE TABLE IF NOT EXISTS Files ( " \
 	"	file_id INTEGER PRIMARY KEY, " \
@@ -29,6 +29,7 @@ public:
 
 public:
 	static const std::string PREINIT_DATABASE;
+	static const std::string TUNE_DATABASE;
 	static const std::string INIT_DATABASE;
 	static const std::string SECOND_INIT_DATABASE;
 	static const std::string CLEAR_DATABASE;
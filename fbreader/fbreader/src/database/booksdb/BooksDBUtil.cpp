@@ -27,6 +27,10 @@
 
 using namespace std;
 
+// number of books whose database writes are committed together
+// while the library is being (re)built
+const size_t BooksDBUtil::BATCH_SIZE = 256;
+
 #include "../../library/Book.h"
 #include "../../library/Tag.h"
 #include "../../library/Author.h"
@@ -80,29 +84,55 @@ bool BooksDBUtil::getBooks(std::map<std::string, shared_ptr<Book> > &booksmap, b
 	if (!BooksDB::Instance().loadBooks(books)) {
 		return false;
 	}
-	for (BookList::iterator it = books.begin(); it != books.end(); ++it) {
-		Book &book = **it;
-		const std::string &filePath = book.filePath();
-		const std::string physicalFilePath = ZLFile(filePath).physicalFilePath();
-		ZLFile file(physicalFilePath);
-		if (!checkFile || file.exists()) {
-			if (!checkFile || checkInfo(file)) {
-				if (isBookFull(book)) {
-					booksmap.insert(std::make_pair(filePath, *it));
-					continue;
+	BookList::iterator it = books.begin();
+	while (it != books.end()) {
+		SQLiteDataBase::Transaction transaction(BooksDB::Instance());
+		if (!transaction.start()) {
+			return false;
+		}
+		for (size_t count = 0; (count < BATCH_SIZE) && (it != books.end()); ++it, ++count) {
+			Book &book = **it;
+			const std::string &filePath = book.filePath();
+			const std::string physicalFilePath = ZLFile(filePath).physicalFilePath();
+			ZLFile file(physicalFilePath);
+			if (!checkFile || file.exists()) {
+				if (!checkFile || checkInfo(file)) {
+					if (isBookFull(book)) {
+						booksmap.insert(std::make_pair(filePath, *it));
+						continue;
+					}
+				} else {
+					if (physicalFilePath != filePath) {
+						resetZipInfo(file);
+					}
+					saveInfo(file);
 				}
-			} else {
-				if (physicalFilePath != filePath) {
-					resetZipInfo(file);
+				shared_ptr<Book> bookptr = Book::loadFromFile(filePath);
+				if (!bookptr.isNull()) {
+					BooksDB::Instance().saveBook(bookptr);
+					booksmap.insert(std::make_pair(filePath, bookptr));
 				}
-				saveInfo(file);
 			}
-			shared_ptr<Book> bookptr = Book::loadFromFile(filePath);
-			if (!bookptr.isNull()) {
-				BooksDB::Instance().saveBook(bookptr);
-				booksmap.insert(std::make_pair(filePath, bookptr));
+		}
+		transaction.setSuccessful();
+	}
+	return true;
+}
+
+bool BooksDBUtil::getBooks(const std::vector<std::string> &fileNames, BookList &books) {
+	std::vector<std::string>::const_iterator it = fileNames.begin();
+	while (it != fileNames.end()) {
+		SQLiteDataBase::Transaction transaction(BooksDB::Instance());
+		if (!transaction.start()) {
+			return false;
+		}
+		for (size_t count = 0; (count < BATCH_SIZE) && (it != fileNames.end()); ++it, ++count) {
+			shared_ptr<Book> book = getBook(*it);
+			if (!book.isNull()) {
+				books.push_back(book);
 			}
 		}
+		transaction.setSuccessful();
 	}
 	return true;
 }
@@ -35,6 +35,7 @@ public:
 	static shared_ptr<Book> getBook(const std::string &fileName, bool checkFile = true);
 
 	static bool getBooks(std::map<std::string, shared_ptr<Book> > &booksmap, bool checkFile = true);
+	static bool getBooks(const std::vector<std::string> &fileNames, BookList &books);
 
 	static bool getRecentBooks(BookList &books);
 
@@ -55,6 +56,8 @@ public:
 	static bool canRemoveFile(const std::string &fileName);
 
 private:
+	static const size_t BATCH_SIZE;
+
 	static shared_ptr<Book> loadFromDB(const std::string &fileName);
 };
 
@@ -212,76 +212,85 @@ void SQLiteCommand::prepareBindContext() {
 }
 
 
-bool SQLiteCommand::bindParameters() {
+void SQLiteCommand::prepareBindPositions() {
 	prepareBindContext();
 
-	std::vector<DBCommandParameter> &params = parameters();
+	const std::vector<DBCommandParameter> &params = parameters();
 
-	bool res = true;
+	myBindPositions.clear();
+	myBindPositions.resize(params.size());
+	myBindPositionsAreComplete = true;
 	const size_t size = params.size();
 	for (size_t i = 0; i < size; ++i) {
-		DBCommandParameter &p = params[i];
+		const DBCommandParameter &p = params[i];
 		if (p.hasName()) {
-			const std::string &name = p.name();
-			if (!bindParameterByName(name, p.value())) {
-				res = false;
-			}
+			collectBindPositions(p.name(), myBindPositions[i]);
 		} else if (i < myBindContext.size()) {
-			BindParameter &bp = myBindContext[i];
-			if (myBindContext[i].hasName()) {
-				if (!bindParameterByName(bp.Name, p.value())) {
-					res = false;
-				}
+			const BindParameter &bp = myBindContext[i];
+			if (bp.hasName()) {
+				collectBindPositions(bp.Name, myBindPositions[i]);
 			} else {
-				if (!bindParameterByIndex(bp.Position, p.value())) {
-					res = false;
-				}
+				collectBindPositions(bp.Position, myBindPositions[i]);
 			}
 		} else {
-			res = false;
+			myBindPositionsAreComplete = false;
+		}
+	}
+}
+
+
+bool SQLiteCommand::bindParameters() {
+	const std::vector<DBCommandParameter> &params = parameters();
+
+	// parameter names are resolved once per prepared statement set,
+	// every execution binds values by position only
+	if (myBindPositions.size() != params.size()) {
+		prepareBindPositions();
+	}
+
+	bool res = myBindPositionsAreComplete;
+	const size_t size = params.size();
+	for (size_t i = 0; i < size; ++i) {
+		const shared_ptr<DBValue> value = params[i].value();
+		const BindPositions &positions = myBindPositions[i];
+		for (BindPositions::const_iterator it = positions.begin(); it != positions.end(); ++it) {
+			if (!bindParameter(myStatements[it->first], it->second, value)) {
+				res = false;
+			}
 		}
 	}
 	return res;
 }
 
 
-bool SQLiteCommand::bindParameterByName(const std::string &name, shared_ptr<DBValue> value) {
+void SQLiteCommand::collectBindPositions(const std::string &name, BindPositions &positions) const {
 	const size_t size = myStatements.size();
-	bool res = true;
-	bool binded = false;
 	for (size_t i = 0; i < size; ++i) {
-		sqlite3_stmt *statement = myStatements[i];
-		const int index = sqlite3_bind_parameter_index(statement, name.c_str());
-		if (index == 0) {
-			continue;
-		}
-		binded = true;
-		if (!bindParameter(statement, index, value)) {
-			res = false;
+		const int index = sqlite3_bind_parameter_index(myStatements[i], name.c_str());
+		if (index != 0) {
+			positions.push_back(std::make_pair(i, index));
 		}
 	}
-	if (!binded) {
+	if (positions.empty()) {
 		dumpError("parameter \"" + name + "\" is not found");
 	}
-	return res;
 }
 
-bool SQLiteCommand::bindParameterByIndex(size_t index, shared_ptr<DBValue> value) {
+void SQLiteCommand::collectBindPositions(size_t index, BindPositions &positions) const {
 	if (index == 0) {
-		return true;
+		return;
 	}
 	const size_t size = myStatements.size();
 	int number = index;
 	for (size_t i = 0; i < size; ++i) {
-		sqlite3_stmt *statement = myStatements[i];
-		const int count = sqlite3_bind_parameter_count(statement);
+		const int count = sqlite3_bind_parameter_count(myStatements[i]);
 		if (number > count) {
 			number -= count;
 			continue;
 		}
-		return bindParameter(statement, number, value);
+		positions.push_back(std::make_pair(i, number));
+		return;
 	}
-	return true;
 }
 
 bool SQLiteCommand::bindParameter(sqlite3_stmt *statement, int number, shared_ptr<DBValue> value) {
@@ -322,6 +331,7 @@ void SQLiteCommand::finalizeStatements() {
 		}
 	}
 	myStatements.clear();
+	myBindPositions.clear();
 }
 
 
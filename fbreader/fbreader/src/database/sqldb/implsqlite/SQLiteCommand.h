@@ -82,10 +82,14 @@ private:
 		const std::string myName;
 	};
 
+	// (statement index, parameter position) pairs a parameter is bound to
+	typedef std::vector<std::pair<size_t,int> > BindPositions;
+
 	void prepareBindContext();
+	void prepareBindPositions();
+	void collectBindPositions(const std::string &name, BindPositions &positions) const;
+	void collectBindPositions(size_t index, BindPositions &positions) const;
 	bool bindParameters();
-	bool bindParameterByName(const std::string &name, shared_ptr<DBValue> value);
-	bool bindParameterByIndex(size_t index, shared_ptr<DBValue> value);
 	bool bindParameter(sqlite3_stmt *statement, int number, shared_ptr<DBValue> value);
 	bool prepareStatements(SQLiteConnection &conn);
 
@@ -94,6 +98,8 @@ private:
 private:
 	std::vector<sqlite3_stmt *> myStatements;
 	std::vector<BindParameter> myBindContext;
+	std::vector<BindPositions> myBindPositions;
+	bool myBindPositionsAreComplete;
 	bool myLocked;
 
 private: // disable copying:
@@ -103,7 +109,7 @@ private: // disable copying:
 
 
 inline SQLiteCommand::SQLiteCommand(const std::string &command, DBConnection &connection) 
-	: DBCommand(SQLiteCommand::packCommand(command), connection), myStatements(), myLocked(false) {}
+	: DBCommand(SQLiteCommand::packCommand(command), connection), myStatements(), myBindPositionsAreComplete(true), myLocked(false) {}
 
 inline void SQLiteCommand::unlock() { myLocked = false; }
 inline std::vector<sqlite3_stmt *> &SQLiteCommand::statements() { return myStatements; }
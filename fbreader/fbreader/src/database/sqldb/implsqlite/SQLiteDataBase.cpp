@@ -41,9 +41,8 @@ bool SQLiteDataBase::Transaction::start() {
 	if (myDepth == 0) {
 		myStarted = myDataBase.myBeginTransaction->execute();
 	} else {
-		//((DBTextValue &) *myDataBase.myMakeSavePoint->parameter("@name").value()).setValue(name());
-		//myStarted = myDataBase.myMakeSavePoint->execute();
-		myStarted = true;
+		myDataBase.prepareSavePoints(myDepth);
+		myStarted = myDataBase.mySavePoints[myDepth - 1]->execute();
 	}
 	if (myStarted) {
 		++myDataBase.myTransactionDepth;
@@ -61,21 +60,13 @@ void SQLiteDataBase::Transaction::end(bool success) {
 		}
 	} else {
 		if (success) {
-			//((DBTextValue &) *myDataBase.myCommitSavePoint->parameter("@name").value()).setValue(name());
-			//myDataBase.myCommitSavePoint->execute();
+			myDataBase.myReleaseSavePoints[myDepth - 1]->execute();
 		} else {
-			//((DBTextValue &) *myDataBase.myRollbackSavePoint->parameter("@name").value()).setValue(name());
-			//myDataBase.myRollbackSavePoint->execute();
+			myDataBase.myRollbackSavePoints[myDepth - 1]->execute();
 		}
 	}
 }
 
-std::string SQLiteDataBase::Transaction::name() const {
-	std::string name = "tran";
-	ZLStringUtil::appendNumber(name, myDepth);
-	return name;
-}
-
 //----------- End Transaction subclass -----------------
 
 
@@ -84,9 +75,6 @@ SQLiteDataBase::SQLiteDataBase(const std::string &path) : DataBase( new SQLiteCo
 	myBeginTransaction    = SQLiteFactory::createCommand("BEGIN IMMEDIATE TRANSACTION", connection());
 	myCommitTransaction   = SQLiteFactory::createCommand("COMMIT TRANSACTION", connection());
 	myRollbackTransaction = SQLiteFactory::createCommand("ROLLBACK TRANSACTION", connection());
-	myMakeSavePoint       = SQLiteFactory::createCommand("SAVEPOINT @name", connection(), "@name", DBValue::DBTEXT);
-	myCommitSavePoint     = SQLiteFactory::createCommand("RELEASE @name", connection(), "@name", DBValue::DBTEXT);
-	myRollbackSavePoint   = SQLiteFactory::createCommand("ROLLBACK TO @name; RELEASE @name", connection(), "@name", DBValue::DBTEXT);
 }
 
 SQLiteDataBase::~SQLiteDataBase() {
@@ -95,6 +83,18 @@ SQLiteDataBase::~SQLiteDataBase() {
 	}
 }
 
+// savepoint names are identifiers, they cannot be bound as parameters,
+// so the commands are prepared once for every nesting depth
+void SQLiteDataBase::prepareSavePoints(unsigned int depth) {
+	while (mySavePoints.size() < depth) {
+		std::string name = "tran";
+		ZLStringUtil::appendNumber(name, mySavePoints.size() + 1);
+		mySavePoints.push_back(SQLiteFactory::createCommand("SAVEPOINT " + name, connection()));
+		myReleaseSavePoints.push_back(SQLiteFactory::createCommand("RELEASE " + name, connection()));
+		myRollbackSavePoints.push_back(SQLiteFactory::createCommand("ROLLBACK TO " + name + "; RELEASE " + name, connection()));
+	}
+}
+
 bool SQLiteDataBase::executeAsTransaction(DBRunnable &runnable) {
 	Transaction tran(*this);
 	if (tran.start() && runnable.run()) {
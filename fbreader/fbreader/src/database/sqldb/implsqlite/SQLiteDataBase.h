@@ -21,6 +21,8 @@
 #ifndef __SQLITEDATABASE_H__
 #define __SQLITEDATABASE_H__
 
+#include <vector>
+
 #include "../DataBase.h"
 #include "../DBCommand.h"
 
@@ -39,9 +41,15 @@ public:
 public:
 	bool executeAsTransaction(DBRunnable &runnable);
 
-private:
+public:
 	friend class Transaction;
 
+	/*
+	 * Transactions can be nested; only the outermost one is really started
+	 * and committed, so a caller can group many executeAsTransaction calls
+	 * into a single commit. Inner transactions are savepoints: a failed one
+	 * rolls back its own changes only.
+	 */
 	class Transaction {
 	public:
 		Transaction(SQLiteDataBase &db);
@@ -51,7 +59,6 @@ private:
 		void setSuccessful();
 	private:
 		void end(bool success);
-		std::string name() const;
 	private:
 		SQLiteDataBase &myDataBase;
 		bool mySuccess;
@@ -64,9 +71,12 @@ private: // Transaction handling
 	shared_ptr<DBCommand> myBeginTransaction;
 	shared_ptr<DBCommand> myCommitTransaction;
 	shared_ptr<DBCommand> myRollbackTransaction;
-	shared_ptr<DBCommand> myMakeSavePoint;
-	shared_ptr<DBCommand> myCommitSavePoint;
-	shared_ptr<DBCommand> myRollbackSavePoint;
+	// savepoint commands of the nested transactions, by depth - 1
+	std::vector<shared_ptr<DBCommand> > mySavePoints;
+	std::vector<shared_ptr<DBCommand> > myReleaseSavePoints;
+	std::vector<shared_ptr<DBCommand> > myRollbackSavePoints;
+
+	void prepareSavePoints(unsigned int depth);
 
 private: // disable copying:
 	SQLiteDataBase(const SQLiteDataBase &);
@@ -282,6 +282,16 @@ private:
 	shared_ptr<Book> myBook;
 };
 
+class BuildSearchIndexRunnable : public ZLRunnable {
+
+public:
+	BuildSearchIndexRunnable(shared_ptr<ZLTextModel> model) : myModel(model) {}
+	void run() { myModel->buildSearchIndex(); }
+
+private:
+	shared_ptr<ZLTextModel> myModel;
+};
+
 void FBReader::openBook(shared_ptr<Book> book) {
 	OpenBookRunnable runnable(book);
 	ZLDialogManager::Instance().wait(ZLResourceKey("loadingBook"), runnable);
@@ -314,6 +324,8 @@ void FBReader::openBookInternal(shared_ptr<Book> book) {
 		Library::Instance().addBookToRecentList(book);
 		((RecentBooksPopupData&)*myRecentBooksPopupData).updateId();
 		showBookTextView();
+
+		ZLTimeManager::Instance().addAutoRemovableTask(new BuildSearchIndexRunnable(myModel->bookTextModel()), 1000);
 	}
 }
 
@@ -19,12 +19,14 @@
 
 #include <queue>
 #include <algorithm>
+#include <ctime>
 
 #include <ZLibrary.h>
 #include <ZLStringUtil.h>
 #include <ZLFile.h>
 #include <ZLDir.h>
 #include <ZLDialogManager.h>
+#include <ZLLogger.h>
 #include <iostream>
 
 using namespace std;
@@ -60,10 +62,60 @@ Library::Library() :
 	BooksDBUtil::getRecentBooks(myRecentBooks);
 }
 
-void Library::collectBookFileNames(std::set<std::string> &bookFileNames) const {
+/*
+ * The stamp of a directory is made of its modification time and of the sizes
+ * and modification times of the zip archives it contains (an archive rewritten
+ * in place does not change its directory). It is stored in the size column of
+ * the directory's Files record; it is negated when books without meta info
+ * are collected, so toggling that option forces a full rescan.
+ * 0 means "unknown" and never matches. Modification times have a resolution
+ * of one second, so a directory or an archive changed in the second the scan
+ * started or later gets no stamp: the next change could keep the same time.
+ */
+int Library::directoryStamp(long mtime, const ZLDir &dir, const std::vector<std::string> &files, long scanStart) const {
+	if ((mtime <= 0) || (mtime >= scanStart)) {
+		return 0;
+	}
+	unsigned int stamp = (unsigned int)mtime;
+	for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+		const ZLFile file(dir.itemPath(*it));
+		if (file.extension() != "zip") {
+			continue;
+		}
+		const long archiveMTime = file.mtime();
+		if ((archiveMTime <= 0) || (archiveMTime >= scanStart)) {
+			return 0;
+		}
+		// summed up, so the order of the files does not matter
+		stamp += ((unsigned int)archiveMTime ^ ((unsigned int)file.size() * 2654435761U)) * 16777619U;
+	}
+	stamp &= 0x7fffffff;
+	if (stamp == 0) {
+		stamp = 1;
+	}
+	return CollectAllBooksOption.value() ? -(int)stamp : (int)stamp;
+}
+
+void Library::collectBookFileNames(std::set<std::string> &bookFileNames, const std::map<std::string,shared_ptr<Book> > &knownBooks, std::map<std::string,int> &dirStamps) const {
 	std::set<std::string> dirs;
 	collectDirNames(dirs);
 
+	// creating, removing or renaming a file always changes the modification
+	// time of its directory, so for an unchanged directory the books we have
+	// in the database are exactly the books it contains; files rewritten in
+	// place are refreshed by BooksDBUtil::getBooks that compares file sizes
+	std::map<std::string,std::vector<std::string> > knownBooksByDir;
+	for (std::map<std::string,shared_ptr<Book> >::const_iterator it = knownBooks.begin(); it != knownBooks.end(); ++it) {
+		const std::string physicalPath = ZLFile(it->first).physicalFilePath();
+		const size_t index = physicalPath.rfind(ZLibrary::FileNameDelimiter);
+		if (index != std::string::npos) {
+			knownBooksByDir[physicalPath.substr(0, index)].push_back(it->first);
+		}
+	}
+
+	const bool collectBookWithoutMetaInfo = CollectAllBooksOption.value();
+	const long scanStart = std::time(0);
+	size_t skippedDirsNumber = 0;
 	while (!dirs.empty()) {
 		std::string dirname = *dirs.begin();
 		dirs.erase(dirs.begin());
@@ -86,10 +138,22 @@ void Library::collectBookFileNames(std::set<std::string> &bookFileNames) const {
 			BooksDBUtil::listZipEntries(dirfile, files);
 			inZip = true;
 		} else {
+			// the modification time is taken before listing, a file
+			// created after that changes it again
+			const long mtime = dirfile.mtime();
 			dir->collectFiles(files, true);
+			const int stamp = directoryStamp(mtime, *dir, files, scanStart);
+			if ((stamp != 0) && (BooksDB::Instance().getFileSize(dirfile.path()) == stamp)) {
+				std::map<std::string,std::vector<std::string> >::const_iterator it = knownBooksByDir.find(dirfile.path());
+				if (it != knownBooksByDir.end()) {
+					bookFileNames.insert(it->second.begin(), it->second.end());
+				}
+				++skippedDirsNumber;
+				continue;
+			}
+			dirStamps[dirfile.path()] = stamp;
 		}
 		if (!files.empty()) {
-			const bool collectBookWithoutMetaInfo = CollectAllBooksOption.value();
 			for (std::vector<std::string>::const_iterator jt = files.begin(); jt != files.end(); ++jt) {
 				const std::string fileName = (inZip) ? (*jt) : (dir->itemPath(*jt));
 				ZLFile file(fileName);
@@ -104,6 +168,12 @@ void Library::collectBookFileNames(std::set<std::string> &bookFileNames) const {
 			}
 		}
 	}
+
+	std::string message = "skipped ";
+	ZLStringUtil::appendNumber(message, skippedDirsNumber);
+	message += " unchanged directories, scanned ";
+	ZLStringUtil::appendNumber(message, dirStamps.size());
+	ZLLogger::Instance().println("library", message);
 }
 
 void Library::rebuildBookSet() const {
@@ -114,18 +184,37 @@ void Library::rebuildBookSet() const {
 	BooksDBUtil::getBooks(booksMap);
 
 	std::set<std::string> fileNamesSet;
-	collectBookFileNames(fileNamesSet);
+	std::map<std::string,int> dirStamps;
+	collectBookFileNames(fileNamesSet, booksMap, dirStamps);
 
 	// collect books from book path
+	std::vector<std::string> newFileNames;
 	for (std::set<std::string>::iterator it = fileNamesSet.begin(); it != fileNamesSet.end(); ++it) {
 		std::map<std::string, shared_ptr<Book> >::iterator jt = booksMap.find(*it);
 		if (jt == booksMap.end()) {
-			insertIntoBookSet(BooksDBUtil::getBook(*it));
+			newFileNames.push_back(*it);
 		} else {
 			insertIntoBookSet(jt->second);
 			booksMap.erase(jt);
 		}
 	}
+	BookList newBooks;
+	const bool allBooksSaved = BooksDBUtil::getBooks(newFileNames, newBooks);
+	for (BookList::const_iterator it = newBooks.begin(); it != newBooks.end(); ++it) {
+		insertIntoBookSet(*it);
+	}
+
+	// directory stamps are stored only when all their books are in the
+	// database, otherwise an interrupted scan would hide the new books
+	SQLiteDataBase::Transaction transaction(BooksDB::Instance());
+	if (allBooksSaved && transaction.start()) {
+		for (std::map<std::string,int>::const_iterator it = dirStamps.begin(); it != dirStamps.end(); ++it) {
+			if (it->second != 0) {
+				BooksDB::Instance().setFileSize(it->first, it->second);
+			}
+		}
+		transaction.setSuccessful();
+	}
 
 	// other books from our database
 	for (std::map<std::string, shared_ptr<Book> >::iterator jt = booksMap.begin(); jt != booksMap.end(); ++jt) {
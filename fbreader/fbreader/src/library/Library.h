@@ -32,6 +32,8 @@
 #include "Lists.h"
 #include "Comparators.h"
 
+class ZLDir;
+
 class Library {
 
 public:
@@ -84,7 +86,8 @@ public:
 
 private:
 	void collectDirNames(std::set<std::string> &names) const;
-	void collectBookFileNames(std::set<std::string> &bookFileNames) const;
+	void collectBookFileNames(std::set<std::string> &bookFileNames, const std::map<std::string,shared_ptr<Book> > &knownBooks, std::map<std::string,int> &dirStamps) const;
+	int directoryStamp(long mtime, const ZLDir &dir, const std::vector<std::string> &files, long scanStart) const;
 
 	void synchronize() const;
 
@@ -10,7 +10,7 @@ CC = gcc
 AR = ar rsu
 LD = g++
 
-CFLAGS = -pipe -fno-exceptions -Wall -Wno-ctor-dtor-privacy -W -DLIBICONV_PLUG
+CFLAGS = -pipe -fno-exceptions -Wall -Wno-ctor-dtor-privacy -W -DLIBICONV_PLUG -DXMLCONFIG_BINARY_STORE
 LDFLAGS =
 
 ifeq "$(UI_TYPE)" "qt"
@@ -0,0 +1 @@
+../src/filesystem/ZLFileMapping.h
\ No newline at end of file
@@ -25,6 +25,10 @@
 
 ZLFSManager *ZLFSManager::ourInstance = 0;
 
+ZLFileMapping *ZLFSManager::createMapping(const std::string&) const {
+	return 0;
+}
+
 void ZLFSManager::deleteInstance() {
 	if (ourInstance != 0) {
 		delete ourInstance;
@@ -30,6 +30,7 @@ class ZLDir;
 class ZLFSDir;
 class ZLInputStream;
 class ZLOutputStream;
+class ZLFileMapping;
 
 class ZLFSManager {
 
@@ -52,6 +53,7 @@ protected:
 	virtual void normalizeRealPath(std::string &path) const = 0;
 	virtual ZLInputStream *createPlainInputStream(const std::string &path) const = 0;
 	virtual ZLOutputStream *createOutputStream(const std::string &path) const = 0;
+	virtual ZLFileMapping *createMapping(const std::string &path) const;
 	virtual ZLFSDir *createPlainDirectory(const std::string &path) const = 0;
 	virtual ZLFSDir *createNewDirectory(const std::string &path) const = 0;
 	virtual ZLFileInfo fileInfo(const std::string &path) const = 0;
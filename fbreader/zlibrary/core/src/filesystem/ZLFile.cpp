@@ -28,6 +28,7 @@ using namespace std;
 #include "ZLFile.h"
 #include "ZLFSDir.h"
 #include "ZLOutputStream.h"
+#include "ZLFileMapping.h"
 #include "zip/ZLZip.h"
 #include "tar/ZLTar.h"
 #include "bzip2/ZLBzip2InputStream.h"
@@ -150,6 +151,29 @@ shared_ptr<ZLDir> ZLFile::directory(bool createUnexisting) const {
 	return 0;
 }
 
+shared_ptr<ZLFileMapping> ZLFile::mapping() const {
+	if (!isCompressed() && (ZLFSManager::Instance().findArchiveFileNameDelimiter(myPath) == -1)) {
+		shared_ptr<ZLFileMapping> mapping = ZLFSManager::Instance().createMapping(myPath);
+		if (!mapping.isNull()) {
+			return mapping;
+		}
+	}
+
+	shared_ptr<ZLInputStream> stream = inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return 0;
+	}
+	const size_t size = stream->sizeOfOpened();
+	ZLFileMapping *mapping = new ZLFileMapping(new char[size], size);
+	const size_t readSize = stream->read(mapping->data(), size);
+	stream->close();
+	if (readSize != size) {
+		delete mapping;
+		return 0;
+	}
+	return mapping;
+}
+
 void ZLFile::fillInfo() const {
 	myInfoIsFilled = true;
 
@@ -233,6 +257,13 @@ size_t ZLFile::size() const {
 	return myInfo.Size;
 }
 
+long ZLFile::mtime() const {
+	if (!myInfoIsFilled) {
+		fillInfo();
+	}
+	return myInfo.Exists ? myInfo.MTime : 0;
+}
+
 bool ZLFile::isDirectory() const {
 	if (!myInfoIsFilled) {
 		fillInfo();
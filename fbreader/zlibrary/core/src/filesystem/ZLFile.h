@@ -29,6 +29,7 @@
 class ZLDir;
 class ZLInputStream;
 class ZLOutputStream;
+class ZLFileMapping;
 
 class ZLFile {
 
@@ -56,6 +57,7 @@ public:
 
 	bool exists() const;
 	size_t size() const;	
+	long mtime() const;
 
 	void forceArchiveType(ArchiveType type);
 
@@ -76,6 +78,7 @@ public:
 	shared_ptr<ZLInputStream> inputStream() const;
 	shared_ptr<ZLOutputStream> outputStream(bool writeThrough = false) const;
 	shared_ptr<ZLDir> directory(bool createUnexisting = false) const;
+	shared_ptr<ZLFileMapping> mapping() const;
 
 private:
 	void fillInfo() const;
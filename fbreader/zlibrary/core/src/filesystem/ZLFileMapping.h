@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLFILEMAPPING_H__
+#define __ZLFILEMAPPING_H__
+
+#include <string>
+
+/*
+ * Whole file contents in memory. The data is a private copy: it can be
+ * modified in place, changes are never written back to the file.
+ * The base class owns a buffer allocated with new[]; file system
+ * managers may return subclasses backed by memory-mapped files.
+ */
+class ZLFileMapping {
+
+public:
+	ZLFileMapping(char *data, size_t size);
+	virtual ~ZLFileMapping();
+
+	char *data() const;
+	size_t size() const;
+
+protected:
+	char *myData;
+	size_t mySize;
+
+private: // disable copying
+	ZLFileMapping(const ZLFileMapping&);
+	const ZLFileMapping &operator = (const ZLFileMapping&);
+};
+
+inline ZLFileMapping::ZLFileMapping(char *data, size_t size) : myData(data), mySize(size) {}
+inline ZLFileMapping::~ZLFileMapping() { delete[] myData; }
+inline char *ZLFileMapping::data() const { return myData; }
+inline size_t ZLFileMapping::size() const { return mySize; }
+
+#endif /* __ZLFILEMAPPING_H__ */
@@ -20,7 +20,7 @@
 #include "ZLZip.h"
 #include "ZLZDecompressor.h"
 
-ZLGzipInputStream::ZLGzipInputStream(shared_ptr<ZLInputStream> stream) : myBaseStream(new ZLInputStreamDecorator(stream)), myFileSize(0) {
+ZLGzipInputStream::ZLGzipInputStream(shared_ptr<ZLInputStream> stream) : myBaseStream(new ZLInputStreamDecorator(stream)), myFileSize(0), myOffset(0), myDataOffset(0) {
 }
 
 ZLGzipInputStream::~ZLGzipInputStream() {
@@ -79,7 +79,8 @@ bool ZLGzipInputStream::open() {
 		myBaseStream->seek(2, false);
 	}
 
-	myDecompressor = new ZLZDecompressor(myFileSize - myBaseStream->offset() - 8);
+	myDataOffset = myBaseStream->offset();
+	myDecompressor = new ZLZDecompressor(myFileSize - myDataOffset - 8, myCheckpoints.isNull() ? 0 : &*myCheckpoints);
 	myOffset = 0;
 
 	return true;
@@ -97,17 +98,33 @@ void ZLGzipInputStream::close() {
 }
 
 void ZLGzipInputStream::seek(int offset, bool absoluteOffset) {
-	if (absoluteOffset) {
-		offset -= this->offset();
-	}
-	if (offset > 0) {
-		read(0, offset);
-	} else if (offset < 0) {
+	if (!absoluteOffset) {
 		offset += this->offset();
+	}
+	if (offset < 0) {
 		open();
-		if (offset >= 0) {
-			read(0, offset);
+		return;
+	}
+	const size_t target = offset;
+
+	if (target < myOffset) {
+		if (myCheckpoints.isNull()) {
+			myCheckpoints = new ZLZDecompressor::CheckpointIndex();
 		}
+		if (!open()) {
+			return;
+		}
+	}
+	if (!myCheckpoints.isNull()) {
+		const ZLZDecompressor::Checkpoint *checkpoint = myCheckpoints->nearest(target);
+		if ((checkpoint != 0) && (checkpoint->Out > myOffset)) {
+			myBaseStream->seek(myDataOffset + checkpoint->In, true);
+			myDecompressor->restore(*checkpoint);
+			myOffset = checkpoint->Out;
+		}
+	}
+	if (target > myOffset) {
+		read(0, target - myOffset);
 	}
 }
 
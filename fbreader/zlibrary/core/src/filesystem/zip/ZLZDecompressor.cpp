@@ -26,8 +26,46 @@
 
 const size_t IN_BUFFER_SIZE = 2048;
 const size_t OUT_BUFFER_SIZE = 32768;
+const size_t WINDOW_SIZE = 32768;
+const size_t INITIAL_CHECKPOINT_SPAN = 256 * 1024;
+const size_t MAX_CHECKPOINTS = 32;
 
-ZLZDecompressor::ZLZDecompressor(size_t size) : myAvailableSize(size) {
+ZLZDecompressor::CheckpointIndex::CheckpointIndex() : mySpan(INITIAL_CHECKPOINT_SPAN) {
+}
+
+const ZLZDecompressor::Checkpoint *ZLZDecompressor::CheckpointIndex::nearest(size_t offset) const {
+	const Checkpoint *checkpoint = 0;
+	for (std::vector<Checkpoint>::const_iterator it = myCheckpoints.begin(); it != myCheckpoints.end(); ++it) {
+		if (it->Out > offset) {
+			break;
+		}
+		checkpoint = &*it;
+	}
+	return checkpoint;
+}
+
+bool ZLZDecompressor::CheckpointIndex::needsCheckpoint(size_t offset) const {
+	const size_t last = myCheckpoints.empty() ? 0 : myCheckpoints.back().Out;
+	return offset >= last + mySpan;
+}
+
+void ZLZDecompressor::CheckpointIndex::add(const Checkpoint &checkpoint) {
+	myCheckpoints.push_back(checkpoint);
+	if (myCheckpoints.size() > MAX_CHECKPOINTS) {
+		mySpan *= 2;
+		std::vector<Checkpoint> thinned;
+		size_t last = 0;
+		for (std::vector<Checkpoint>::const_iterator it = myCheckpoints.begin(); it != myCheckpoints.end(); ++it) {
+			if (it->Out >= last + mySpan) {
+				thinned.push_back(*it);
+				last = it->Out;
+			}
+		}
+		myCheckpoints.swap(thinned);
+	}
+}
+
+ZLZDecompressor::ZLZDecompressor(size_t size, CheckpointIndex *index) : myCompressedSize(size), myAvailableSize(size), myIndex(index), myTotalIn(0), myTotalOut(0), myLastByte(0) {
 	myZStream = new z_stream;
 	memset(myZStream, 0, sizeof(z_stream));
 	inflateInit2(myZStream, -MAX_WBITS);
@@ -45,35 +83,74 @@ ZLZDecompressor::~ZLZDecompressor() {
 }
 
 size_t ZLZDecompressor::decompress(ZLInputStream &stream, char *buffer, size_t maxSize) {
-	while ((myBuffer.length() < maxSize) && (myAvailableSize > 0)) {
-		size_t size = std::min(myAvailableSize, (size_t)IN_BUFFER_SIZE);
-
-		myZStream->next_in = (Bytef*)myInBuffer;
-		myZStream->avail_in = stream.read(myInBuffer, size);
-		if (myZStream->avail_in == size) {
-			myAvailableSize -= size;
-		} else {
-			myAvailableSize = 0;
-		}
-		while (myZStream->avail_in == 0) {
-			break;
-		}
-		while (myZStream->avail_in > 0) {
-			myZStream->avail_out = OUT_BUFFER_SIZE;
-			myZStream->next_out = (Bytef*)myOutBuffer;
-			int code = ::inflate(myZStream, Z_SYNC_FLUSH);
-			if ((code != Z_OK) && (code != Z_STREAM_END)) {
+	if ((buffer == 0) && (maxSize > OUT_BUFFER_SIZE)) {
+		// skip in small portions, do not keep the skipped data
+		size_t skipped = 0;
+		while (skipped < maxSize) {
+			const size_t size = decompress(stream, 0, std::min(maxSize - skipped, OUT_BUFFER_SIZE));
+			if (size == 0) {
 				break;
 			}
-			if (OUT_BUFFER_SIZE == myZStream->avail_out) {
+			skipped += size;
+		}
+		return skipped;
+	}
+
+	while (myBuffer.length() < maxSize) {
+		if (myZStream->avail_in == 0) {
+			if (myAvailableSize == 0) {
 				break;
 			}
-			myBuffer.append(myOutBuffer, OUT_BUFFER_SIZE - myZStream->avail_out);
-			if (code == Z_STREAM_END) {
+			const size_t size = std::min(myAvailableSize, (size_t)IN_BUFFER_SIZE);
+			const size_t readSize = stream.read(myInBuffer, size);
+			if (readSize == size) {
+				myAvailableSize -= size;
+			} else {
 				myAvailableSize = 0;
-				stream.seek(-myZStream->avail_in, false);
+			}
+			if (readSize == 0) {
 				break;
 			}
+			myZStream->next_in = (Bytef*)myInBuffer;
+			myZStream->avail_in = readSize;
+		}
+
+		myZStream->avail_out = OUT_BUFFER_SIZE;
+		myZStream->next_out = (Bytef*)myOutBuffer;
+		const size_t availableIn = myZStream->avail_in;
+		// Z_BLOCK makes inflate stop at block boundaries where checkpoints can be saved
+		const int code = ::inflate(myZStream, Z_BLOCK);
+		const size_t inSize = availableIn - myZStream->avail_in;
+		const size_t outSize = OUT_BUFFER_SIZE - myZStream->avail_out;
+		if (inSize > 0) {
+			myLastByte = *(myZStream->next_in - 1);
+			myTotalIn += inSize;
+		}
+		if (outSize > 0) {
+			myBuffer.append(myOutBuffer, outSize);
+			myTotalOut += outSize;
+			if (myIndex != 0) {
+				myWindow.append(myOutBuffer, outSize);
+				if (myWindow.length() > 2 * WINDOW_SIZE) {
+					myWindow.erase(0, myWindow.length() - WINDOW_SIZE);
+				}
+			}
+		}
+		if (code == Z_STREAM_END) {
+			myAvailableSize = 0;
+			stream.seek(-(int)myZStream->avail_in, false);
+			myZStream->avail_in = 0;
+			break;
+		}
+		if ((code != Z_OK) || ((inSize == 0) && (outSize == 0))) {
+			myAvailableSize = 0;
+			myZStream->avail_in = 0;
+			break;
+		}
+		if ((myIndex != 0) &&
+				(myZStream->data_type & 128) && !(myZStream->data_type & 64) &&
+				myIndex->needsCheckpoint(myTotalOut)) {
+			addCheckpoint();
 		}
 	}
 
@@ -84,3 +161,35 @@ size_t ZLZDecompressor::decompress(ZLInputStream &stream, char *buffer, size_t m
 	myBuffer.erase(0, realSize);
 	return realSize;
 }
+
+void ZLZDecompressor::addCheckpoint() {
+	Checkpoint checkpoint;
+	checkpoint.In = myTotalIn;
+	checkpoint.Out = myTotalOut;
+	checkpoint.Bits = myZStream->data_type & 7;
+	checkpoint.LastByte = myLastByte;
+	const size_t windowSize = std::min(myWindow.length(), WINDOW_SIZE);
+	checkpoint.Window.assign(myWindow, myWindow.length() - windowSize, windowSize);
+	myIndex->add(checkpoint);
+}
+
+void ZLZDecompressor::restore(const Checkpoint &checkpoint) {
+	inflateReset(myZStream);
+	if (checkpoint.Bits > 0) {
+		inflatePrime(myZStream, checkpoint.Bits, checkpoint.LastByte >> (8 - checkpoint.Bits));
+	}
+	if (!checkpoint.Window.empty()) {
+		inflateSetDictionary(myZStream, (const Bytef*)checkpoint.Window.data(), checkpoint.Window.length());
+	}
+	myZStream->avail_in = 0;
+	if (myCompressedSize != (size_t)-1) {
+		myAvailableSize = myCompressedSize - std::min(myCompressedSize, checkpoint.In);
+	}
+	myTotalIn = checkpoint.In;
+	myTotalOut = checkpoint.Out;
+	myLastByte = checkpoint.LastByte;
+	myBuffer.erase();
+	if (myIndex != 0) {
+		myWindow = checkpoint.Window;
+	}
+}
@@ -23,23 +23,68 @@
 #include <zlib.h>
 
 #include <string>
+#include <vector>
 
 class ZLInputStream;
 
 class ZLZDecompressor {
 
 public:
-	ZLZDecompressor(size_t size);
+	// inflater state at a deflate block boundary
+	struct Checkpoint {
+		size_t In;
+		size_t Out;
+		int Bits;
+		unsigned char LastByte;
+		std::string Window;
+	};
+
+	// Checkpoints saved during decompression let a stream resume
+	// inflating from the nearest one instead of the stream start.
+	// The index keeps at most MAX_CHECKPOINTS windows of 32K each;
+	// when it is full, the distance between checkpoints is doubled.
+	class CheckpointIndex {
+
+	public:
+		CheckpointIndex();
+		const Checkpoint *nearest(size_t offset) const;
+
+	private:
+		bool needsCheckpoint(size_t offset) const;
+		void add(const Checkpoint &checkpoint);
+
+	private:
+		size_t mySpan;
+		std::vector<Checkpoint> myCheckpoints;
+
+	friend class ZLZDecompressor;
+	};
+
+public:
+	ZLZDecompressor(size_t size, CheckpointIndex *index = 0);
 	~ZLZDecompressor();
 
 	size_t decompress(ZLInputStream &stream, char *buffer, size_t maxSize);
 
+	// stream must be positioned at checkpoint.In bytes after the data start
+	void restore(const Checkpoint &checkpoint);
+
+private:
+	void addCheckpoint();
+
 private:
 	z_stream *myZStream;
+	const size_t myCompressedSize;
 	size_t myAvailableSize;
 	char *myInBuffer;
 	char *myOutBuffer;
 	std::string myBuffer;
+
+	CheckpointIndex *myIndex;
+	size_t myTotalIn;
+	size_t myTotalOut;
+	unsigned char myLastByte;
+	std::string myWindow;
 };
 
 #endif /* __ZLZDECOMPRESSOR_H__ */
@@ -20,14 +20,15 @@
 #ifndef __ZLZIP_H__
 #define __ZLZIP_H__
 
-#include <map>
+#include <vector>
+#include <string>
 
 #include <shared_ptr.h>
 
 #include "../ZLInputStream.h"
 #include "../ZLDir.h"
+#include "ZLZDecompressor.h"
 
-class ZLZDecompressor;
 class ZLFile;
 
 class ZLZipEntryCache : public ZLUserData {
@@ -39,10 +40,11 @@ public:
 	struct Info {
 		Info();
 
+		// offset of the local file header
 		int Offset;
 		int CompressionMethod;
-		int CompressedSize;
-		int UncompressedSize;
+		size_t CompressedSize;
+		size_t UncompressedSize;
 	};
 
 public:
@@ -51,7 +53,22 @@ public:
 	void collectFileNames(std::vector<std::string> &names) const;
 
 private:
-	std::map<std::string,Info> myInfoMap;
+	bool readCentralDirectory(ZLInputStream &baseStream);
+	void scanLocalHeaders(ZLInputStream &baseStream);
+
+	void addEntry(const std::string &name, const Info &info);
+	int entryIndex(const std::string &name) const;
+	void rehash(size_t bucketsNumber);
+
+private:
+	struct Entry {
+		std::string Name;
+		Info EntryInfo;
+		int Next;
+	};
+
+	std::vector<Entry> myEntries;
+	std::vector<int> myBuckets;
 };
 
 class ZLZipInputStream : public ZLInputStream {
@@ -77,8 +94,11 @@ private:
 	size_t myUncompressedSize;
 	size_t myAvailableSize;
 	size_t myOffset;
+	size_t myDataOffset;
 
 	shared_ptr<ZLZDecompressor> myDecompressor;
+	// created on the first backward seek
+	shared_ptr<ZLZDecompressor::CheckpointIndex> myCheckpoints;
 
 friend class ZLFile;
 };
@@ -103,8 +123,11 @@ private:
 	size_t myFileSize;
 
 	size_t myOffset;
+	size_t myDataOffset;
 
 	shared_ptr<ZLZDecompressor> myDecompressor;
+	// created on the first backward seek
+	shared_ptr<ZLZDecompressor::CheckpointIndex> myCheckpoints;
 
 friend class ZLFile;
 };
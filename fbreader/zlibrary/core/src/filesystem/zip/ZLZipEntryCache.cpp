@@ -17,10 +17,13 @@
  * 02110-1301, USA.
  */
 
+#include <climits>
+#include <algorithm>
+
 #include "ZLZip.h"
 #include "ZLZipHeader.h"
 
-ZLZipEntryCache::Info::Info() : Offset(-1) {
+ZLZipEntryCache::Info::Info() : Offset(-1), CompressionMethod(0), CompressedSize(0), UncompressedSize(0) {
 }
 
 const ZLZipEntryCache &ZLZipEntryCache::cache(ZLInputStream &stream) {
@@ -37,36 +40,272 @@ ZLZipEntryCache::ZLZipEntryCache(ZLInputStream &baseStream) {
 	if (!baseStream.open()) {
 		return;
 	}
+	if (!readCentralDirectory(baseStream)) {
+		myEntries.clear();
+		myBuckets.clear();
+		baseStream.seek(0, true);
+		scanLocalHeaders(baseStream);
+	}
+	baseStream.close();
+}
+
+static unsigned int readShort(const char *ptr) {
+	return
+		(((unsigned int)ptr[1] & 0xFF) << 8) +
+		((unsigned int)ptr[0] & 0xFF);
+}
+
+static unsigned long readLong(const char *ptr) {
+	return
+		(((unsigned long)ptr[3] & 0xFF) << 24) +
+		(((unsigned long)ptr[2] & 0xFF) << 16) +
+		(((unsigned long)ptr[1] & 0xFF) << 8) +
+		((unsigned long)ptr[0] & 0xFF);
+}
+
+// returns false if the value does not fit into size_t
+static bool readLong64(const char *ptr, size_t &value) {
+	const unsigned long high = readLong(ptr + 4);
+	if ((sizeof(size_t) < 8) && (high != 0)) {
+		return false;
+	}
+	value = readLong(ptr);
+	if (high != 0) {
+		value += (size_t)high << 16 << 16;
+	}
+	return true;
+}
+
+static bool readBlock(ZLInputStream &stream, size_t offset, size_t size, std::string &buffer) {
+	if (offset > INT_MAX) {
+		return false;
+	}
+	buffer.resize(size);
+	stream.seek(offset, true);
+	return (stream.offset() == offset) && (stream.read((char*)buffer.data(), size) == size);
+}
+
+static const size_t END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+static const size_t ZIP64_LOCATOR_SIZE = 20;
+static const size_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIZE = 56;
+static const size_t CENTRAL_FILE_HEADER_SIZE = 46;
+static const size_t MAX_COMMENT_SIZE = 0xFFFF;
+
+bool ZLZipEntryCache::readCentralDirectory(ZLInputStream &baseStream) {
+	const size_t fileSize = baseStream.sizeOfOpened();
+	if (fileSize < END_OF_CENTRAL_DIRECTORY_SIZE) {
+		return false;
+	}
+
+	// the end of central directory record is followed only by the archive comment
+	const size_t tailSize = std::min(fileSize, END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT_SIZE);
+	const size_t tailOffset = fileSize - tailSize;
+	std::string tail;
+	if (!readBlock(baseStream, tailOffset, tailSize, tail)) {
+		return false;
+	}
+	size_t endOffset = tailSize - END_OF_CENTRAL_DIRECTORY_SIZE + 1;
+	while (endOffset-- > 0) {
+		const char *ptr = tail.data() + endOffset;
+		if ((readLong(ptr) == (unsigned long)ZLZipHeader::SignatureEndOfCentralDirectory) &&
+				(endOffset + END_OF_CENTRAL_DIRECTORY_SIZE + readShort(ptr + 20) <= tailSize)) {
+			break;
+		}
+	}
+	if (endOffset == (size_t)-1) {
+		return false;
+	}
+
+	const char *end = tail.data() + endOffset;
+	size_t entriesNumber = readShort(end + 10);
+	size_t directorySize = readLong(end + 12);
+	size_t directoryOffset = readLong(end + 16);
+	// where the central directory has to end if there is no data before the archive
+	size_t directoryEnd = tailOffset + endOffset;
+
+	if ((entriesNumber == 0xFFFF) || (directorySize == 0xFFFFFFFF) || (directoryOffset == 0xFFFFFFFF)) {
+		if (tailOffset + endOffset < ZIP64_LOCATOR_SIZE) {
+			return false;
+		}
+		std::string locator;
+		if (!readBlock(baseStream, tailOffset + endOffset - ZIP64_LOCATOR_SIZE, ZIP64_LOCATOR_SIZE, locator) ||
+				(readLong(locator.data()) != (unsigned long)ZLZipHeader::SignatureZip64Locator)) {
+			return false;
+		}
+		size_t zip64EndOffset;
+		std::string zip64End;
+		if (!readLong64(locator.data() + 8, zip64EndOffset) ||
+				!readBlock(baseStream, zip64EndOffset, ZIP64_END_OF_CENTRAL_DIRECTORY_SIZE, zip64End) ||
+				(readLong(zip64End.data()) != (unsigned long)ZLZipHeader::SignatureZip64EndOfCentralDirectory) ||
+				!readLong64(zip64End.data() + 32, entriesNumber) ||
+				!readLong64(zip64End.data() + 40, directorySize) ||
+				!readLong64(zip64End.data() + 48, directoryOffset)) {
+			return false;
+		}
+		directoryEnd = zip64EndOffset;
+	}
+
+	// self-extracting archives and the like have some data before the first entry
+	if ((directoryOffset > directoryEnd) || (directorySize > directoryEnd - directoryOffset)) {
+		return false;
+	}
+	const size_t shift = directoryEnd - directoryOffset - directorySize;
+
+	std::string directory;
+	if (!readBlock(baseStream, directoryOffset + shift, directorySize, directory)) {
+		return false;
+	}
+
+	if (entriesNumber <= directorySize / CENTRAL_FILE_HEADER_SIZE) {
+		myEntries.reserve(entriesNumber);
+		rehash(4 * entriesNumber);
+	}
+	const char *ptr = directory.data();
+	const char *directoryEndPtr = ptr + directorySize;
+	for (size_t i = 0; i < entriesNumber; ++i) {
+		if (((size_t)(directoryEndPtr - ptr) < CENTRAL_FILE_HEADER_SIZE) ||
+				(readLong(ptr) != (unsigned long)ZLZipHeader::SignatureCentralFile)) {
+			return false;
+		}
+		const size_t nameLength = readShort(ptr + 28);
+		const size_t extraLength = readShort(ptr + 30);
+		const size_t commentLength = readShort(ptr + 32);
+		const size_t recordSize = CENTRAL_FILE_HEADER_SIZE + nameLength + extraLength + commentLength;
+		if ((size_t)(directoryEndPtr - ptr) < recordSize) {
+			return false;
+		}
+
+		Info info;
+		info.CompressionMethod = readShort(ptr + 10);
+		size_t compressedSize = readLong(ptr + 20);
+		size_t uncompressedSize = readLong(ptr + 24);
+		size_t offset = readLong(ptr + 42);
+
+		const char *extra = ptr + CENTRAL_FILE_HEADER_SIZE + nameLength;
+		const char *extraEnd = extra + extraLength;
+		while (extraEnd - extra >= 4) {
+			const unsigned int id = readShort(extra);
+			const size_t size = readShort(extra + 2);
+			extra += 4;
+			if (size > (size_t)(extraEnd - extra)) {
+				break;
+			}
+			if (id == 0x0001) {
+				// ZIP64 extended information: only fields overflowed in the header are present
+				const char *field = extra;
+				const char *fieldEnd = extra + size;
+				size_t *values[] = { &uncompressedSize, &compressedSize, &offset };
+				for (int j = 0; j < 3; ++j) {
+					if (*values[j] != 0xFFFFFFFF) {
+						continue;
+					}
+					if ((fieldEnd - field < 8) || !readLong64(field, *values[j])) {
+						return false;
+					}
+					field += 8;
+				}
+			}
+			extra += size;
+		}
+
+		offset += shift;
+		if (offset <= INT_MAX) {
+			info.Offset = offset;
+			info.CompressedSize = compressedSize;
+			info.UncompressedSize = uncompressedSize;
+			if ((info.CompressionMethod == 0) && (compressedSize != uncompressedSize)) {
+				info.CompressedSize = uncompressedSize;
+			}
+			addEntry(std::string(ptr + CENTRAL_FILE_HEADER_SIZE, nameLength), info);
+		}
+		ptr += recordSize;
+	}
+	return true;
+}
 
+void ZLZipEntryCache::scanLocalHeaders(ZLInputStream &baseStream) {
 	ZLZipHeader header;
+	size_t headerOffset = baseStream.offset();
 	while (header.readFrom(baseStream)) {
-		Info *infoPtr = 0;
+		bool isEntry = false;
+		Info info;
+		std::string entryName;
 		if (header.Signature == ZLZipHeader::SignatureLocalFile) {
-			std::string entryName(header.NameLength, '\0');
+			entryName.assign(header.NameLength, '\0');
 			if ((unsigned int)baseStream.read((char*)entryName.data(), header.NameLength) == header.NameLength) {
-				Info &info = myInfoMap[entryName];
-				info.Offset = baseStream.offset() + header.ExtraLength;
+				info.Offset = headerOffset;
 				info.CompressionMethod = header.CompressionMethod;
 				info.CompressedSize = header.CompressedSize;
-				info.UncompressedSize = header.UncompressedSize;
-				infoPtr = &info;
+				isEntry = true;
 			}
 		}
 		ZLZipHeader::skipEntry(baseStream, header);
-		if (infoPtr != 0) {
-			infoPtr->UncompressedSize = header.UncompressedSize;
+		if (isEntry) {
+			info.UncompressedSize = header.UncompressedSize;
+			addEntry(entryName, info);
 		}
+		headerOffset = baseStream.offset();
 	}
-	baseStream.close();
+}
+
+static size_t nameHash(const std::string &name) {
+	size_t hash = 2166136261U;
+	for (std::string::const_iterator it = name.begin(); it != name.end(); ++it) {
+		hash = (hash ^ (unsigned char)*it) * 16777619U;
+	}
+	return hash;
+}
+
+void ZLZipEntryCache::rehash(size_t bucketsNumber) {
+	size_t size = 16;
+	while (size < bucketsNumber) {
+		size <<= 1;
+	}
+	myBuckets.assign(size, -1);
+	for (size_t i = 0; i < myEntries.size(); ++i) {
+		int &bucket = myBuckets[nameHash(myEntries[i].Name) & (size - 1)];
+		myEntries[i].Next = bucket;
+		bucket = i;
+	}
+}
+
+int ZLZipEntryCache::entryIndex(const std::string &name) const {
+	if (myBuckets.empty()) {
+		return -1;
+	}
+	int index = myBuckets[nameHash(name) & (myBuckets.size() - 1)];
+	while ((index != -1) && (myEntries[index].Name != name)) {
+		index = myEntries[index].Next;
+	}
+	return index;
+}
+
+void ZLZipEntryCache::addEntry(const std::string &name, const Info &info) {
+	// a later entry with the same name replaces the earlier one
+	const int index = entryIndex(name);
+	if (index != -1) {
+		myEntries[index].EntryInfo = info;
+		return;
+	}
+	if (2 * (myEntries.size() + 1) > myBuckets.size()) {
+		rehash(4 * (myEntries.size() + 1));
+	}
+	Entry entry;
+	entry.Name = name;
+	entry.EntryInfo = info;
+	int &bucket = myBuckets[nameHash(name) & (myBuckets.size() - 1)];
+	entry.Next = bucket;
+	bucket = myEntries.size();
+	myEntries.push_back(entry);
 }
 
 ZLZipEntryCache::Info ZLZipEntryCache::info(const std::string &entryName) const {
-	std::map<std::string,Info>::const_iterator it = myInfoMap.find(entryName);
-	return (it != myInfoMap.end()) ? it->second : Info();
+	const int index = entryIndex(entryName);
+	return (index != -1) ? myEntries[index].EntryInfo : Info();
 }
 
 void ZLZipEntryCache::collectFileNames(std::vector<std::string> &names) const {
-	for (std::map<std::string,Info>::const_iterator it = myInfoMap.begin(); it != myInfoMap.end(); ++it) {
-		names.push_back(it->first);
+	for (std::vector<Entry>::const_iterator it = myEntries.begin(); it != myEntries.end(); ++it) {
+		names.push_back(it->Name);
 	}
 }
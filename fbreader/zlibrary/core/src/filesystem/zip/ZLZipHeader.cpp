@@ -25,6 +25,10 @@
 
 const int ZLZipHeader::SignatureLocalFile = 0x04034B50;
 const int ZLZipHeader::SignatureData = 0x08074B50;
+const int ZLZipHeader::SignatureCentralFile = 0x02014B50;
+const int ZLZipHeader::SignatureEndOfCentralDirectory = 0x06054B50;
+const int ZLZipHeader::SignatureZip64EndOfCentralDirectory = 0x06064B50;
+const int ZLZipHeader::SignatureZip64Locator = 0x07064B50;
 
 bool ZLZipHeader::readFrom(ZLInputStream &stream) {
 	size_t startOffset = stream.offset();
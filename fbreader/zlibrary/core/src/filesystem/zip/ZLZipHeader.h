@@ -25,6 +25,10 @@ class ZLInputStream;
 struct ZLZipHeader {
 	static const int SignatureLocalFile;
 	static const int SignatureData;
+	static const int SignatureCentralFile;
+	static const int SignatureEndOfCentralDirectory;
+	static const int SignatureZip64EndOfCentralDirectory;
+	static const int SignatureZip64Locator;
 
 	unsigned long Signature;
 	unsigned short Version;
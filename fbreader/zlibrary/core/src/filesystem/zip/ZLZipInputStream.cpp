@@ -24,7 +24,7 @@
 #include "ZLZDecompressor.h"
 #include "../ZLFSManager.h"
 
-ZLZipInputStream::ZLZipInputStream(shared_ptr<ZLInputStream> &base, const std::string &entryName) : myBaseStream(new ZLInputStreamDecorator(base)), myEntryName(entryName), myUncompressedSize(0) {
+ZLZipInputStream::ZLZipInputStream(shared_ptr<ZLInputStream> &base, const std::string &entryName) : myBaseStream(new ZLInputStreamDecorator(base)), myEntryName(entryName), myIsDeflated(false), myUncompressedSize(0), myAvailableSize(0), myOffset(0), myDataOffset(0) {
 }
 
 ZLZipInputStream::~ZLZipInputStream() {
@@ -46,6 +46,13 @@ bool ZLZipInputStream::open() {
 		return false;
 	}
 	myBaseStream->seek(info.Offset, true);
+	ZLZipHeader header;
+	if (!header.readFrom(*myBaseStream) || (header.Signature != (unsigned long)ZLZipHeader::SignatureLocalFile)) {
+		close();
+		return false;
+	}
+	myBaseStream->seek(header.NameLength + header.ExtraLength, false);
+	myDataOffset = myBaseStream->offset();
 
 	if (info.CompressionMethod == 0) {
 		myIsDeflated = false;
@@ -62,7 +69,7 @@ bool ZLZipInputStream::open() {
 	}
 
 	if (myIsDeflated) {
-		myDecompressor = new ZLZDecompressor(myAvailableSize);
+		myDecompressor = new ZLZDecompressor(myAvailableSize, myCheckpoints.isNull() ? 0 : &*myCheckpoints);
 	}
 
 	myOffset = 0;
@@ -90,17 +97,46 @@ void ZLZipInputStream::close() {
 }
 
 void ZLZipInputStream::seek(int offset, bool absoluteOffset) {
-	if (absoluteOffset) {
-		offset -= this->offset();
-	}
-	if (offset > 0) {
-		read(0, offset);
-	} else if (offset < 0) {
+	if (!absoluteOffset) {
 		offset += this->offset();
+	}
+	if (offset < 0) {
 		open();
-		if (offset >= 0) {
-			read(0, offset);
+		return;
+	}
+	const size_t target = offset;
+
+	if (!myIsDeflated) {
+		if (target < myOffset) {
+			if (myAvailableSize != (size_t)-1) {
+				myAvailableSize += myOffset - target;
+			}
+			myBaseStream->seek(myDataOffset + target, true);
+			myOffset = target;
+		} else if (target > myOffset) {
+			read(0, target - myOffset);
 		}
+		return;
+	}
+
+	if (target < myOffset) {
+		if (myCheckpoints.isNull()) {
+			myCheckpoints = new ZLZDecompressor::CheckpointIndex();
+		}
+		if (!open()) {
+			return;
+		}
+	}
+	if (!myCheckpoints.isNull()) {
+		const ZLZDecompressor::Checkpoint *checkpoint = myCheckpoints->nearest(target);
+		if ((checkpoint != 0) && (checkpoint->Out > myOffset)) {
+			myBaseStream->seek(myDataOffset + checkpoint->In, true);
+			myDecompressor->restore(*checkpoint);
+			myOffset = checkpoint->Out;
+		}
+	}
+	if (target > myOffset) {
+		read(0, target - myOffset);
 	}
 }
 
@@ -29,6 +29,10 @@ shared_ptr<ZLExecutionData> ZLImage::synchronizationData() const {
 	return 0;
 }
 
+const shared_ptr<std::string> ZLSingleImage::headerData(size_t) const {
+	return stringData();
+}
+
 bool ZLSingleImage::good() const {
 	return !ZLImageManager::Instance().imageData(*this).isNull();
 }
@@ -49,9 +49,20 @@ public:
 	const std::string &mimeType() const;
 	bool good() const;
 	virtual const shared_ptr<std::string> stringData() const = 0;
+	// at least the first maxSize bytes of the image (all of them if
+	// the image is shorter); enough to read the image header
+	virtual const shared_ptr<std::string> headerData(size_t maxSize) const;
 
 private:
 	std::string myMimeType;
+
+	// dimensions read from the header by ZLImageManager::imageSize();
+	// zero width means the header format is unknown
+	mutable bool mySizeIsRead;
+	mutable unsigned int myWidth;
+	mutable unsigned int myHeight;
+
+friend class ZLImageManager;
 };
 
 class ZLMultiImage : public ZLImage {
@@ -71,7 +82,7 @@ public:
 inline ZLImage::ZLImage() {}
 inline ZLImage::~ZLImage() {}
 
-inline ZLSingleImage::ZLSingleImage(const std::string &mimeType) : myMimeType(mimeType) {}
+inline ZLSingleImage::ZLSingleImage(const std::string &mimeType) : myMimeType(mimeType), mySizeIsRead(false), myWidth(0), myHeight(0) {}
 inline ZLSingleImage::~ZLSingleImage() {}
 inline const std::string &ZLSingleImage::mimeType() const { return myMimeType; }
 
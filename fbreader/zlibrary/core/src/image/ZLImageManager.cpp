@@ -17,6 +17,7 @@
  * 02110-1301, USA.
  */
 
+#include <cstdlib>
 #include <algorithm>
 #include <vector>
 
@@ -319,3 +320,130 @@ shared_ptr<ZLImageData> ZLImageManager::imageData(const ZLImage &image) const {
 
 	return data;
 }
+
+inline static unsigned int bigEndian16(const unsigned char *ptr) {
+	return (ptr[0] << 8) | ptr[1];
+}
+
+inline static unsigned int bigEndian32(const unsigned char *ptr) {
+	return (ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3];
+}
+
+inline static unsigned int littleEndian16(const unsigned char *ptr) {
+	return ptr[0] | (ptr[1] << 8);
+}
+
+inline static int littleEndian32(const unsigned char *ptr) {
+	return ptr[0] | (ptr[1] << 8) | (ptr[2] << 16) | (ptr[3] << 24);
+}
+
+static bool jpegSize(const unsigned char *data, size_t length, unsigned int &width, unsigned int &height) {
+	size_t offset = 2;
+	while (offset + 4 <= length) {
+		if (data[offset] != 0xFF) {
+			return false;
+		}
+		const unsigned char marker = data[offset + 1];
+		if (marker == 0xFF) {
+			++offset;
+			continue;
+		}
+		if ((marker == 0x01) || ((marker >= 0xD0) && (marker <= 0xD8))) {
+			offset += 2;
+			continue;
+		}
+		if ((marker == 0xD9) || (marker == 0xDA)) {
+			return false;
+		}
+		const size_t segmentLength = bigEndian16(data + offset + 2);
+		if ((marker >= 0xC0) && (marker <= 0xCF) &&
+				(marker != 0xC4) && (marker != 0xC8) && (marker != 0xCC)) {
+			if (offset + 9 > length) {
+				return false;
+			}
+			height = bigEndian16(data + offset + 5);
+			width = bigEndian16(data + offset + 7);
+			return true;
+		}
+		offset += 2 + segmentLength;
+	}
+	return false;
+}
+
+// most headers fit into the first bytes; jpeg files can start with
+// large metadata segments, so they get a second, longer try
+static const size_t HEADER_SIZE = 4096;
+static const size_t LONG_HEADER_SIZE = 128 * 1024;
+
+static bool headerSize(const std::string &mimeType, const std::string &header, unsigned int &width, unsigned int &height) {
+	const unsigned char *data = (const unsigned char*)header.data();
+	const size_t length = header.length();
+
+	if (mimeType == "image/palm") {
+		// only the uncompressed images are supported by the decoder
+		if (length < 16) {
+			return false;
+		}
+		PalmImageHeader palmHeader(header);
+		if (palmHeader.CompressionType != 0xFF) {
+			return false;
+		}
+		width = palmHeader.Width;
+		height = palmHeader.Height;
+	} else if ((length >= 24) && (header.compare(0, 8, "\x89PNG\r\n\x1A\n") == 0)) {
+		width = bigEndian32(data + 16);
+		height = bigEndian32(data + 20);
+	} else if ((length >= 10) && (header.compare(0, 4, "GIF8") == 0)) {
+		width = littleEndian16(data + 6);
+		height = littleEndian16(data + 8);
+	} else if ((length >= 26) && (data[0] == 'B') && (data[1] == 'M')) {
+		if (littleEndian32(data + 14) == 12) {
+			width = littleEndian16(data + 18);
+			height = littleEndian16(data + 20);
+		} else {
+			width = abs(littleEndian32(data + 18));
+			height = abs(littleEndian32(data + 22));
+		}
+	} else if ((length >= 4) && (data[0] == 0xFF) && (data[1] == 0xD8)) {
+		if (!jpegSize(data, length, width, height)) {
+			return false;
+		}
+	} else {
+		return false;
+	}
+	return (width > 0) && (height > 0);
+}
+
+bool ZLImageManager::imageSize(const ZLImage &image, unsigned int &width, unsigned int &height) const {
+	if (!image.isSingle()) {
+		return false;
+	}
+	const ZLSingleImage &singleImage = (const ZLSingleImage&)image;
+	if (!singleImage.mySizeIsRead) {
+		singleImage.mySizeIsRead = true;
+		unsigned int w = 0;
+		unsigned int h = 0;
+		shared_ptr<std::string> header = singleImage.headerData(HEADER_SIZE);
+		if (!header.isNull() && !headerSize(singleImage.mimeType(), *header, w, h)) {
+			const bool isTruncatedJpeg =
+				(header->length() == HEADER_SIZE) &&
+				((unsigned char)(*header)[0] == 0xFF) &&
+				((unsigned char)(*header)[1] == 0xD8);
+			w = 0;
+			if (isTruncatedJpeg) {
+				header = singleImage.headerData(LONG_HEADER_SIZE);
+				if (!header.isNull() && !headerSize(singleImage.mimeType(), *header, w, h)) {
+					w = 0;
+				}
+			}
+		}
+		singleImage.myWidth = w;
+		singleImage.myHeight = h;
+	}
+	if (singleImage.myWidth == 0) {
+		return false;
+	}
+	width = singleImage.myWidth;
+	height = singleImage.myHeight;
+	return true;
+}
@@ -59,6 +59,9 @@ protected:
 	
 public:
 	shared_ptr<ZLImageData> imageData(const ZLImage &image) const;
+	// reads image dimensions from the image header without decoding pixels;
+	// returns false for multi-images and for formats it does not recognize
+	bool imageSize(const ZLImage &image, unsigned int &width, unsigned int &height) const;
 
 protected:
 	ZLImageManager() {}
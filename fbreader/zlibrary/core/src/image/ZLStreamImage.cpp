@@ -17,6 +17,8 @@
  * 02110-1301, USA.
  */
 
+#include <algorithm>
+
 #include <ZLFile.h>
 #include <ZLInputStream.h>
 
@@ -44,3 +46,22 @@ const shared_ptr<std::string> ZLStreamImage::stringData() const {
 
 	return imageData;
 }
+
+const shared_ptr<std::string> ZLStreamImage::headerData(size_t maxSize) const {
+	shared_ptr<ZLInputStream> stream = inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return 0;
+	}
+	// a compressed stream (e.g. a zip entry) is inflated up to maxSize only
+	const size_t size = (mySize != 0) ? std::min(mySize, maxSize) : maxSize;
+
+	shared_ptr<std::string> imageData = new std::string();
+
+	stream->seek(myOffset, false);
+	char *buffer = new char[size];
+	const size_t length = stream->read(buffer, size);
+	imageData->append(buffer, length);
+	delete[] buffer;
+
+	return imageData;
+}
@@ -30,6 +30,7 @@ class ZLStreamImage : public ZLSingleImage {
 public:
 	ZLStreamImage(const std::string &mimeType, size_t offset, size_t size = 0);
 	const shared_ptr<std::string> stringData() const;
+	const shared_ptr<std::string> headerData(size_t maxSize) const;
 
 private:
 	virtual shared_ptr<ZLInputStream> inputStream() const = 0;
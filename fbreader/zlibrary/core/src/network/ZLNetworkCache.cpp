@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <ctime>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
+#include <ZLibrary.h>
+#include <ZLFile.h>
+#include <ZLDir.h>
+#include <ZLInputStream.h>
+#include <ZLOutputStream.h>
+#include <ZLStringUtil.h>
+#include <ZLUnicodeUtil.h>
+
+#include "ZLNetworkCache.h"
+#include "ZLNetworkManager.h"
+#include "ZLNetworkUtil.h"
+
+const size_t ZLNetworkCache::MAX_SIZE = 8 * 1024 * 1024;
+const size_t ZLNetworkCache::MAX_ENTRY_SIZE = 1024 * 1024;
+
+static const std::string BODY_SUFFIX = ".body";
+
+std::string ZLNetworkCache::directory() {
+	return ZLNetworkManager::CacheDirectory() + ZLibrary::FileNameDelimiter + "http";
+}
+
+std::string ZLNetworkCache::entryPath(const std::string &url) {
+	// two independent FNV-1a hashes; the url itself is stored in the entry
+	// file, so a collision costs a cache miss only
+	unsigned int h1 = 2166136261U;
+	unsigned int h2 = 84696351U;
+	for (std::string::const_iterator it = url.begin(); it != url.end(); ++it) {
+		h1 = (h1 ^ (unsigned char)*it) * 16777619U;
+		h2 = (h2 ^ (unsigned char)*it) * 16777619U + 1;
+	}
+	static const char HEX[] = "0123456789abcdef";
+	std::string name;
+	for (int i = 28; i >= 0; i -= 4) {
+		name += HEX[(h1 >> i) & 0xF];
+	}
+	for (int i = 28; i >= 0; i -= 4) {
+		name += HEX[(h2 >> i) & 0xF];
+	}
+	return directory() + ZLibrary::FileNameDelimiter + name;
+}
+
+std::string ZLNetworkCache::bodyPath(const std::string &url) {
+	return entryPath(url) + BODY_SUFFIX;
+}
+
+bool ZLNetworkCache::find(const std::string &url, Entry &entry) {
+	shared_ptr<ZLInputStream> stream = ZLFile(entryPath(url)).inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return false;
+	}
+	std::string data;
+	char buffer[1024];
+	size_t len;
+	while ((len = stream->read(buffer, sizeof(buffer))) > 0) {
+		data.append(buffer, len);
+	}
+	stream->close();
+
+	std::vector<std::string> lines;
+	size_t start = 0;
+	for (size_t index = data.find('\n'); index != std::string::npos; index = data.find('\n', start)) {
+		lines.push_back(data.substr(start, index - start));
+		start = index + 1;
+	}
+	if ((lines.size() != 5) || (lines[0] != url) || !ZLFile(bodyPath(url)).exists()) {
+		return false;
+	}
+	entry.ETag = lines[1];
+	entry.LastModified = lines[2];
+	entry.ContentEncoding = lines[3];
+	entry.FreshUntil = std::atol(lines[4].c_str());
+	return true;
+}
+
+bool ZLNetworkCache::readBody(const std::string &url, std::string &body) {
+	body.erase();
+	shared_ptr<ZLInputStream> stream = ZLFile(bodyPath(url)).inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return false;
+	}
+	char buffer[8192];
+	size_t len;
+	while ((body.size() <= MAX_ENTRY_SIZE) && ((len = stream->read(buffer, sizeof(buffer))) > 0)) {
+		body.append(buffer, len);
+	}
+	stream->close();
+	return !body.empty() && (body.size() <= MAX_ENTRY_SIZE);
+}
+
+bool ZLNetworkCache::saveEntry(const std::string &url, const Entry &entry) {
+	if ((url.find('\n') != std::string::npos) ||
+			(entry.ETag.find('\n') != std::string::npos) ||
+			(entry.LastModified.find('\n') != std::string::npos) ||
+			(entry.ContentEncoding.find('\n') != std::string::npos)) {
+		return false;
+	}
+	shared_ptr<ZLOutputStream> stream = ZLFile(entryPath(url)).outputStream();
+	if (stream.isNull() || !stream->open()) {
+		return false;
+	}
+	std::string freshUntil;
+	ZLStringUtil::appendNumber(freshUntil, (unsigned int)std::max(entry.FreshUntil, 0L));
+	stream->write(url + '\n');
+	stream->write(entry.ETag + '\n');
+	stream->write(entry.LastModified + '\n');
+	stream->write(entry.ContentEncoding + '\n');
+	stream->write(freshUntil + '\n');
+	stream->close();
+	return true;
+}
+
+void ZLNetworkCache::store(const std::string &url, const Entry &entry, const std::string &body) {
+	if (body.size() > MAX_ENTRY_SIZE) {
+		remove(url);
+		return;
+	}
+	ZLFile(directory()).directory(true);
+	shared_ptr<ZLOutputStream> stream = ZLFile(bodyPath(url)).outputStream();
+	if (stream.isNull() || !stream->open()) {
+		return;
+	}
+	stream->write(body);
+	stream->close();
+	if (!saveEntry(url, entry)) {
+		remove(url);
+		return;
+	}
+	shrink();
+}
+
+void ZLNetworkCache::refresh(const std::string &url, const Entry &entry) {
+	saveEntry(url, entry);
+}
+
+void ZLNetworkCache::remove(const std::string &url) {
+	ZLFile(entryPath(url)).remove();
+	ZLFile(bodyPath(url)).remove();
+}
+
+bool ZLNetworkCache::isFresh(const Entry &entry) {
+	return entry.FreshUntil > std::time(0);
+}
+
+bool ZLNetworkCache::parseCacheControl(const std::string &value, Entry &entry) {
+	static const std::string MAX_AGE = "max-age=";
+
+	bool noCache = false;
+	long maxAge = 0;
+	size_t start = 0;
+	while (start <= value.size()) {
+		size_t index = value.find(',', start);
+		if (index == std::string::npos) {
+			index = value.size();
+		}
+		std::string directive = ZLUnicodeUtil::toLower(value.substr(start, index - start));
+		ZLStringUtil::stripWhiteSpaces(directive);
+		if (directive == "no-store") {
+			return false;
+		} else if (directive == "no-cache") {
+			noCache = true;
+		} else if (ZLStringUtil::stringStartsWith(directive, MAX_AGE)) {
+			maxAge = std::atol(directive.c_str() + MAX_AGE.size());
+		}
+		start = index + 1;
+	}
+	entry.FreshUntil = (!noCache && (maxAge > 0)) ? std::time(0) + maxAge : 0;
+	return true;
+}
+
+bool ZLNetworkCache::hasCookies(const std::string &url) {
+	static const std::string HTTP_ONLY_PREFIX = "#HttpOnly_";
+
+	std::string host = ZLUnicodeUtil::toLower(ZLNetworkUtil::hostFromUrl(url));
+	const size_t colon = host.find(':');
+	if (colon != std::string::npos) {
+		host.erase(colon);
+	}
+
+	shared_ptr<ZLInputStream> stream = ZLFile(ZLNetworkManager::CookiesPath()).inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return false;
+	}
+	std::string data;
+	char buffer[1024];
+	size_t len;
+	while ((len = stream->read(buffer, sizeof(buffer))) > 0) {
+		data.append(buffer, len);
+	}
+	stream->close();
+
+	// lines of the netscape cookie file start with the cookie domain
+	size_t start = 0;
+	while (start < data.size()) {
+		size_t end = data.find('\n', start);
+		if (end == std::string::npos) {
+			end = data.size();
+		}
+		std::string line = data.substr(start, end - start);
+		start = end + 1;
+		if (ZLStringUtil::stringStartsWith(line, HTTP_ONLY_PREFIX)) {
+			line.erase(0, HTTP_ONLY_PREFIX.size());
+		} else if (line.empty() || (line[0] == '#')) {
+			continue;
+		}
+		std::string domain = ZLUnicodeUtil::toLower(line.substr(0, line.find('\t')));
+		if (!domain.empty() && (domain[0] == '.')) {
+			domain.erase(0, 1);
+		}
+		if (domain.empty()) {
+			continue;
+		}
+		if ((host == domain) ||
+				((host.size() > domain.size()) &&
+				 (host[host.size() - domain.size() - 1] == '.') &&
+				 ZLStringUtil::stringEndsWith(host, domain))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+struct CachedBody {
+	long MTime;
+	size_t Size;
+	std::string Path;
+
+	bool operator < (const CachedBody &body) const { return MTime < body.MTime; }
+};
+
+void ZLNetworkCache::shrink() {
+	shared_ptr<ZLDir> dir = ZLFile(directory()).directory();
+	if (dir.isNull()) {
+		return;
+	}
+	std::vector<std::string> names;
+	dir->collectFiles(names, false);
+
+	std::vector<CachedBody> bodies;
+	size_t totalSize = 0;
+	for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+		if (ZLStringUtil::stringEndsWith(*it, BODY_SUFFIX)) {
+			const ZLFile file(dir->itemPath(*it));
+			CachedBody body;
+			body.MTime = file.mtime();
+			body.Size = file.size();
+			body.Path = file.path();
+			bodies.push_back(body);
+			totalSize += body.Size;
+		}
+	}
+	if (totalSize <= MAX_SIZE) {
+		return;
+	}
+
+	std::sort(bodies.begin(), bodies.end());
+	for (std::vector<CachedBody>::const_iterator it = bodies.begin(); (it != bodies.end()) && (totalSize > MAX_SIZE); ++it) {
+		ZLFile(it->Path).remove();
+		ZLFile(it->Path.substr(0, it->Path.size() - BODY_SUFFIX.size())).remove();
+		totalSize -= it->Size;
+	}
+}
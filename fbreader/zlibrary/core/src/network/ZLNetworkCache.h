@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLNETWORKCACHE_H__
+#define __ZLNETWORKCACHE_H__
+
+#include <string>
+
+/*
+ * On-disk cache of HTTP GET responses, kept in CacheDirectory()/http.
+ * Every entry consists of a small text file with the validators of the
+ * response and a file with the (still content-encoded) body; the total
+ * size of cached bodies is bounded by MAX_SIZE.
+ */
+class ZLNetworkCache {
+
+public:
+	static const size_t MAX_SIZE;
+	static const size_t MAX_ENTRY_SIZE;
+
+	struct Entry {
+		Entry();
+
+		std::string ETag;
+		std::string LastModified;
+		std::string ContentEncoding;
+		// time (in seconds since the epoch) until the entry can be used
+		// without revalidation; 0 means "revalidate every time"
+		long FreshUntil;
+	};
+
+public:
+	static bool find(const std::string &url, Entry &entry);
+	static bool readBody(const std::string &url, std::string &body);
+
+	static void store(const std::string &url, const Entry &entry, const std::string &body);
+	static void refresh(const std::string &url, const Entry &entry);
+	static void remove(const std::string &url);
+
+	static bool isFresh(const Entry &entry);
+	// parses Cache-Control header value; returns false for no-store
+	static bool parseCacheControl(const std::string &value, Entry &entry);
+	// true if the cookie jar holds cookies for the host of the url;
+	// responses to such requests can depend on the session
+	static bool hasCookies(const std::string &url);
+
+private:
+	static std::string directory();
+	static std::string entryPath(const std::string &url);
+	static std::string bodyPath(const std::string &url);
+	static bool saveEntry(const std::string &url, const Entry &entry);
+	static void shrink();
+
+private:
+	ZLNetworkCache();
+};
+
+inline ZLNetworkCache::Entry::Entry() : FreshUntil(0) {}
+
+#endif /* __ZLNETWORKCACHE_H__ */
@@ -29,6 +29,7 @@ const ZLTypeId ZLNetworkPostRequest::TYPE_ID(ZLNetworkRequest::TYPE_ID);
 ZLNetworkRequest::ZLNetworkRequest(const std::string &url, const ZLNetworkSSLCertificate &sslCertificate) :
 	myURL(url),
 	mySSLCertificate(sslCertificate),
+	myIsCompleted(false),
 	myAuthenticationMethod(NO_AUTH),
 	myRedirectionSupported(true) {
 	ZLLogger::Instance().println("URL", url);
@@ -21,6 +21,7 @@
 #define __ZLNETWORKREQUEST_H__
 
 #include <string>
+#include <vector>
 
 #include <ZLExecutionData.h>
 #include <ZLNetworkSSLCertificate.h>
@@ -45,10 +46,17 @@ public:
 
 protected:
 	void setErrorMessage(const std::string &message);
+	void addHeader(const std::string &header);
+	// called from doBefore() by a request answered without network access
+	void setCompleted();
 
 public:
 	const std::string &errorMessage() const;
 
+	// additional request headers, e.g. "If-None-Match: ..."
+	const std::vector<std::string> &headers() const;
+	bool isCompleted() const;
+
 	const std::string &url() const;
 	const ZLNetworkSSLCertificate &sslCertificate() const;
 
@@ -68,6 +76,8 @@ private:
 	const std::string myURL;
 	const ZLNetworkSSLCertificate &mySSLCertificate;
 	std::string myErrorMessage;
+	std::vector<std::string> myHeaders;
+	bool myIsCompleted;
 
 	std::string myUserName;
 	std::string myPassword;
@@ -85,6 +95,10 @@ inline void ZLNetworkRequest::setupAuthentication(AuthenticationMethod method, c
 	myUserName = userName;
 	myPassword = password;
 }
+inline void ZLNetworkRequest::addHeader(const std::string &header) { myHeaders.push_back(header); }
+inline void ZLNetworkRequest::setCompleted() { myIsCompleted = true; }
+inline const std::vector<std::string> &ZLNetworkRequest::headers() const { return myHeaders; }
+inline bool ZLNetworkRequest::isCompleted() const { return myIsCompleted; }
 inline const std::string &ZLNetworkRequest::userName() const { return myUserName; }
 inline const std::string &ZLNetworkRequest::password() const { return myPassword; }
 inline ZLNetworkRequest::AuthenticationMethod ZLNetworkRequest::authenticationMethod() const { return myAuthenticationMethod; }
@@ -17,6 +17,8 @@
  * 02110-1301, USA.
  */
 
+#include <cstdlib>
+
 #include <ZLUnicodeUtil.h>
 #include <ZLStringUtil.h>
 
@@ -28,12 +30,75 @@
 #include "../ZLGzipAsynchronousInputStream.h"
 
 
+static const std::string STATUS_LINE = "http/";
 static const std::string CONTENT_ENCODING = "content-encoding:";
+static const std::string ETAG = "etag:";
+static const std::string LAST_MODIFIED = "last-modified:";
+static const std::string CACHE_CONTROL = "cache-control:";
+static const std::string SET_COOKIE = "set-cookie";
+static const std::string VARY = "vary:";
+
+static std::string headerValue(const std::string &header, size_t nameLength) {
+	std::string value = header.substr(nameLength);
+	ZLStringUtil::stripWhiteSpaces(value);
+	return value;
+}
+
+static shared_ptr<ZLAsynchronousInputStream> newInputStream(const std::string &encoding) {
+	if (encoding == "gzip") {
+		return new ZLGzipAsynchronousInputStream();
+	} else {
+		return new ZLPlainAsynchronousInputStream();
+	}
+}
+
+// expat does not complain about a truncated document,
+// so this reader also checks that the root element is closed
+class ZLCachedBodyChecker : public ZLXMLReader {
+
+public:
+	ZLCachedBodyChecker();
+	bool check(const std::string &body, const std::string &encoding);
+
+private:
+	void startElementHandler(const char *tag, const char **attributes);
+	void endElementHandler(const char *tag);
+
+private:
+	int myDepth;
+	bool myHasRoot;
+};
+
+ZLCachedBodyChecker::ZLCachedBodyChecker() : myDepth(0), myHasRoot(false) {
+}
+
+bool ZLCachedBodyChecker::check(const std::string &body, const std::string &encoding) {
+	shared_ptr<ZLAsynchronousInputStream> stream = newInputStream(encoding);
+	stream->setBuffer(body.data(), body.size());
+	if (!readDocument(stream)) {
+		return false;
+	}
+	stream->setEof();
+	return readDocument(stream) && errorMessage().empty() && myHasRoot && (myDepth == 0);
+}
+
+void ZLCachedBodyChecker::startElementHandler(const char*, const char**) {
+	++myDepth;
+	myHasRoot = true;
+}
+
+void ZLCachedBodyChecker::endElementHandler(const char*) {
+	--myDepth;
+}
 
 
 ZLNetworkXMLParserRequest::ZLNetworkXMLParserRequest(const std::string &url, const ZLNetworkSSLCertificate &sslCertificate, shared_ptr<ZLXMLReader> reader) :
 	ZLNetworkGetRequest(url, sslCertificate),
-	myReader(reader) {
+	myReader(reader),
+	myStatusCode(0),
+	myUsesCache(false),
+	myHasCachedEntry(false),
+	myIsCacheable(false) {
 }
 
 ZLNetworkXMLParserRequest::~ZLNetworkXMLParserRequest() {
@@ -44,34 +109,108 @@ ZLNetworkXMLParserRequest::~ZLNetworkXMLParserRequest() {
 }
 
 bool ZLNetworkXMLParserRequest::doBefore() {
+	// responses to authenticated requests and to requests sent with cookies
+	// can be user specific, so we do not cache them
+	myUsesCache = (authenticationMethod() == NO_AUTH) && !ZLNetworkCache::hasCookies(url());
+	if (myUsesCache && ZLNetworkCache::find(url(), myCachedEntry)) {
+		// without a readable body the entry is useless, the server is asked instead;
+		// the body is checked first as the reader cannot take back what it was given
+		if (!ZLNetworkCache::readBody(url(), myCachedBody) ||
+				!ZLCachedBodyChecker().check(myCachedBody, myCachedEntry.ContentEncoding)) {
+			myCachedBody.erase();
+			ZLNetworkCache::remove(url());
+			return true;
+		}
+		myHasCachedEntry = true;
+		if (ZLNetworkCache::isFresh(myCachedEntry)) {
+			setCompleted();
+			return readCachedBody();
+		}
+		if (!myCachedEntry.ETag.empty()) {
+			addHeader("If-None-Match: " + myCachedEntry.ETag);
+		}
+		if (!myCachedEntry.LastModified.empty()) {
+			addHeader("If-Modified-Since: " + myCachedEntry.LastModified);
+		}
+	}
 	return true;
 }
 
-bool ZLNetworkXMLParserRequest::doAfter(bool) {
+bool ZLNetworkXMLParserRequest::doAfter(bool success) {
+	if (!success) {
+		return true;
+	}
+	if ((myStatusCode == 304) && myHasCachedEntry) {
+		if (!myIsCacheable) {
+			bool result = readCachedBody();
+			ZLNetworkCache::remove(url());
+			return result;
+		}
+		// a 304 response is not obliged to repeat the validators
+		if (myResponseEntry.ETag.empty()) {
+			myResponseEntry.ETag = myCachedEntry.ETag;
+		}
+		if (myResponseEntry.LastModified.empty()) {
+			myResponseEntry.LastModified = myCachedEntry.LastModified;
+		}
+		myResponseEntry.ContentEncoding = myCachedEntry.ContentEncoding;
+		ZLNetworkCache::refresh(url(), myResponseEntry);
+		return readCachedBody();
+	}
+	if (myStatusCode == 200) {
+		if (myIsCacheable &&
+				(!myResponseEntry.ETag.empty() ||
+				 !myResponseEntry.LastModified.empty() ||
+				 ZLNetworkCache::isFresh(myResponseEntry))) {
+			myResponseEntry.ContentEncoding = myHttpEncoding;
+			ZLNetworkCache::store(url(), myResponseEntry, myBody);
+		} else if (myHasCachedEntry) {
+			ZLNetworkCache::remove(url());
+		}
+	}
 	return true;
 }
 
 bool ZLNetworkXMLParserRequest::handleHeader(void *ptr, size_t size) {
-	std::string header = ZLUnicodeUtil::toLower(std::string((const char *) ptr, size));
+	const std::string line((const char *) ptr, size);
+	std::string header = ZLUnicodeUtil::toLower(line);
 
-	if (ZLStringUtil::stringStartsWith(header, CONTENT_ENCODING)) {
-		std::string encoding = header.substr(CONTENT_ENCODING.size());
-		ZLStringUtil::stripWhiteSpaces(encoding);
-		myHttpEncoding = encoding;
+	if (ZLStringUtil::stringStartsWith(header, STATUS_LINE)) {
+		// every response (e.g. after a redirection) starts with its own status line
+		const size_t index = header.find(' ');
+		myStatusCode = (index != std::string::npos) ? std::atoi(header.c_str() + index + 1) : 0;
+		myHttpEncoding.erase();
+		myResponseEntry = ZLNetworkCache::Entry();
+		myIsCacheable = myUsesCache;
+	} else if (ZLStringUtil::stringStartsWith(header, SET_COOKIE)) {
+		// covers both Set-Cookie and Set-Cookie2
+		myIsCacheable = false;
+	} else if (ZLStringUtil::stringStartsWith(header, VARY)) {
+		const std::string value = headerValue(header, VARY.size());
+		if ((value.find("cookie") != std::string::npos) || (value.find('*') != std::string::npos)) {
+			myIsCacheable = false;
+		}
+	} else if (ZLStringUtil::stringStartsWith(header, CONTENT_ENCODING)) {
+		myHttpEncoding = headerValue(header, CONTENT_ENCODING.size());
+	} else if (ZLStringUtil::stringStartsWith(header, ETAG)) {
+		myResponseEntry.ETag = headerValue(line, ETAG.size());
+	} else if (ZLStringUtil::stringStartsWith(header, LAST_MODIFIED)) {
+		myResponseEntry.LastModified = headerValue(line, LAST_MODIFIED.size());
+	} else if (ZLStringUtil::stringStartsWith(header, CACHE_CONTROL)) {
+		if (!ZLNetworkCache::parseCacheControl(headerValue(header, CACHE_CONTROL.size()), myResponseEntry)) {
+			myIsCacheable = false;
+		}
 	}
 
 	return true;
 }
 
-bool ZLNetworkXMLParserRequest::handleContent(void *ptr, size_t size) {
-	if (myInputStream.isNull()) {
-		if (myHttpEncoding == "gzip") {
-			myInputStream = new ZLGzipAsynchronousInputStream();
-		} else {
-			myInputStream = new ZLPlainAsynchronousInputStream();
-		}
-	}
-	myInputStream->setBuffer((const char *) ptr, size);
+void ZLNetworkXMLParserRequest::createInputStream(const std::string &encoding) {
+	myInputStream = newInputStream(encoding);
+}
+
+bool ZLNetworkXMLParserRequest::readBuffer(const char *data, size_t size) {
+	myInputStream->setBuffer(data, size);
 	bool result = true;
 	if (!myReader->readDocument(myInputStream)) {
 		result = false;
@@ -82,3 +221,36 @@ bool ZLNetworkXMLParserRequest::handleContent(void *ptr, size_t size) {
 	}
 	return result;
 }
+
+bool ZLNetworkXMLParserRequest::handleContent(void *ptr, size_t size) {
+	if (myInputStream.isNull()) {
+		createInputStream(myHttpEncoding);
+	}
+	if (myIsCacheable && (myStatusCode == 200)) {
+		if (myBody.size() + size <= ZLNetworkCache::MAX_ENTRY_SIZE) {
+			myBody.append((const char *) ptr, size);
+		} else {
+			myIsCacheable = false;
+			myBody.erase();
+		}
+	}
+	return readBuffer((const char *) ptr, size);
+}
+
+bool ZLNetworkXMLParserRequest::readCachedBody() {
+	createInputStream(myCachedEntry.ContentEncoding);
+	bool result = readBuffer(myCachedBody.data(), myCachedBody.size());
+	myCachedBody.erase();
+	if (result) {
+		myInputStream->setEof();
+		result = myReader->readDocument(myInputStream);
+		if (!myReader->errorMessage().empty()) {
+			setErrorMessage(myReader->errorMessage());
+			result = false;
+		}
+	}
+	if (!result) {
+		ZLNetworkCache::remove(url());
+	}
+	return result;
+}
@@ -21,6 +21,7 @@
 #define __ZLNETWORKXMLPARSERREQUEST_H__
 
 #include "../ZLNetworkRequest.h"
+#include "../ZLNetworkCache.h"
 
 
 class ZLXMLReader;
@@ -39,10 +40,23 @@ private:
 	bool doBefore();
 	bool doAfter(bool success);
 
+	void createInputStream(const std::string &encoding);
+	bool readBuffer(const char *data, size_t size);
+	bool readCachedBody();
+
 private:
 	shared_ptr<ZLXMLReader> myReader;
 	shared_ptr<ZLAsynchronousInputStream> myInputStream;
 	std::string myHttpEncoding;
+
+	int myStatusCode;
+	bool myUsesCache;
+	bool myHasCachedEntry;
+	ZLNetworkCache::Entry myCachedEntry;
+	std::string myCachedBody;
+	bool myIsCacheable;
+	ZLNetworkCache::Entry myResponseEntry;
+	std::string myBody;
 };
 
 #endif /* __ZLNETWORKXMLPARSERREQUEST_H__ */
@@ -75,6 +75,40 @@ inline const curl_httppost *PostData::postItem() const {
 
 
 
+class HeaderList : public ZLUserData {
+
+public:
+	HeaderList(const std::vector<std::string> &headers);
+	~HeaderList();
+
+	const curl_slist *list() const;
+
+private:
+	curl_slist *myList;
+
+private: // disable copying
+	HeaderList(const HeaderList &);
+	const HeaderList &operator = (const HeaderList &);
+};
+
+HeaderList::HeaderList(const std::vector<std::string> &headers) : myList(0) {
+	for (std::vector<std::string>::const_iterator it = headers.begin(); it != headers.end(); ++it) {
+		myList = curl_slist_append(myList, it->c_str());
+	}
+}
+
+HeaderList::~HeaderList() {
+	if (myList != 0) {
+		curl_slist_free_all(myList);
+	}
+}
+
+inline const curl_slist *HeaderList::list() const {
+	return myList;
+}
+
+
+
 static size_t handleHeader(void *ptr, size_t size, size_t nmemb, ZLNetworkRequest *request) {
 	const size_t dataSize = size * nmemb;
 	return (request->handleHeader(ptr, dataSize)) ? dataSize : 0;
@@ -122,6 +156,10 @@ std::string ZLCurlNetworkManager::doBeforeRequest(ZLNetworkRequest &request) con
 		return ZLStringUtil::printf(errorResource["somethingWrongMessage"].value(), ZLNetworkUtil::hostFromUrl(request.url()));
 	}
 
+	if (!request.headers().empty()) {
+		request.addUserData("headers", new HeaderList(request.headers()));
+	}
+
 	if (request.isInstanceOf(ZLNetworkPostRequest::TYPE_ID)) {
 		return doBeforePostRequest((ZLNetworkPostRequest &) request);
 	}
@@ -177,6 +215,11 @@ void ZLCurlNetworkManager::setRequestOptions(CURL *handle, const ZLNetworkReques
 
 	curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, request.isRedirectionSupported());
 
+	shared_ptr<ZLUserData> headersPtr = request.getUserData("headers");
+	if (!headersPtr.isNull()) {
+		curl_easy_setopt(handle, CURLOPT_HTTPHEADER, ((HeaderList&)*headersPtr).list());
+	}
+
 	if (request.isInstanceOf(ZLNetworkPostRequest::TYPE_ID)) {
 		shared_ptr<ZLUserData> postDataPtr = request.getUserData("postData");
 		PostData &postData = (PostData&)*postDataPtr;
@@ -189,6 +232,7 @@ void ZLCurlNetworkManager::setRequestOptions(CURL *handle, const ZLNetworkReques
 
 
 void ZLCurlNetworkManager::clearRequestOptions(ZLNetworkRequest &request) const {
+	request.removeUserData("headers");
 	if (request.isInstanceOf(ZLNetworkPostRequest::TYPE_ID)) {
 		request.removeUserData("postData");
 	}
@@ -220,6 +264,10 @@ std::string ZLCurlNetworkManager::perform(const ZLExecutionData::Vector &dataLis
 			errors.insert(err);
 			continue;
 		}
+		if (request.isCompleted()) {
+			// answered from the cache
+			continue;
+		}
 		CURL *easyHandle = curl_easy_init();
 		if (easyHandle != 0) {
 			handleToRequest[easyHandle] = *it;
@@ -30,6 +30,7 @@
 #include "ZLUnixFSDir.h"
 #include "ZLUnixFileInputStream.h"
 #include "ZLUnixFileOutputStream.h"
+#include "ZLUnixFileMapping.h"
 
 static std::string getPwdDir() {
 	char *pwd = getenv("PWD");
@@ -50,6 +51,7 @@ ZLFileInfo ZLUnixFSManager::fileInfo(const std::string &path) const {
 	info.Exists = stat(path.c_str(), &fileStat) == 0;
 	if (info.Exists) {
 		info.Size = fileStat.st_size;
+		info.MTime = fileStat.st_mtime;
 		info.IsDirectory = S_ISDIR(fileStat.st_mode);
 	}
 	return info;
@@ -163,6 +165,10 @@ ZLOutputStream *ZLUnixFSManager::createOutputStream(const std::string &path) con
 	return new ZLUnixFileOutputStream(path);
 }
 
+ZLFileMapping *ZLUnixFSManager::createMapping(const std::string &path) const {
+	return ZLUnixFileMapping::map(path);
+}
+
 bool ZLUnixFSManager::removeFile(const std::string &path) const {
 	return unlink(path.c_str()) == 0;
 }
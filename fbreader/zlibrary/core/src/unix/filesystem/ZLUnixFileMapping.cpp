@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ZLUnixFileMapping.h"
+
+ZLUnixFileMapping *ZLUnixFileMapping::map(const std::string &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1) {
+		return 0;
+	}
+	struct stat fileStat;
+	if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size == 0)) {
+		::close(fd);
+		return 0;
+	}
+	const size_t size = fileStat.st_size;
+	// private writable mapping: pages modified by the caller are copied
+	void *address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (address == MAP_FAILED) {
+		return 0;
+	}
+	return new ZLUnixFileMapping((char*)address, size);
+}
+
+ZLUnixFileMapping::ZLUnixFileMapping(char *data, size_t size) : ZLFileMapping(data, size) {
+}
+
+ZLUnixFileMapping::~ZLUnixFileMapping() {
+	munmap(myData, mySize);
+	myData = 0;
+}
@@ -17,24 +17,21 @@
  * 02110-1301, USA.
  */
 
-#include "ZLTextElement.h"
+#ifndef __ZLUNIXFILEMAPPING_H__
+#define __ZLUNIXFILEMAPPING_H__
 
-ZLTextElement::Kind ZLTextImageElement::kind() const {
-	return IMAGE_ELEMENT;
-};
+#include <ZLFileMapping.h>
 
-ZLTextElement::Kind ZLTextSpecialElement::kind() const {
-	return myKind;
-};
+class ZLUnixFileMapping : public ZLFileMapping {
 
-ZLTextElement::Kind ZLTextStyleElement::kind() const {
-	return FORCED_CONTROL_ELEMENT;
-};
+public:
+	static ZLUnixFileMapping *map(const std::string &path);
+
+private:
+	ZLUnixFileMapping(char *data, size_t size);
 
-ZLTextElement::Kind ZLTextControlElement::kind() const {
-	return CONTROL_ELEMENT;
+public:
+	~ZLUnixFileMapping();
 };
 
-ZLTextElement::Kind ZLTextFixedHSpaceElement::kind() const {
-	return FIXED_HSPACE_ELEMENT;
-}
+#endif /* __ZLUNIXFILEMAPPING_H__ */
@@ -21,6 +21,7 @@
 
 #include "XMLConfig.h"
 #include "XMLConfigDelta.h"
+#include "XMLConfigBinaryStore.h"
 
 void XMLConfigManager::createInstance() {
 	ourInstance = new XMLConfigManager();
@@ -92,7 +93,7 @@ void ConfigSaveTask::run() {
 	}
 }
 
-XMLConfig::XMLConfig() : myDelta(0) {
+XMLConfig::XMLConfig() : myDelta(0), myBinaryStore(0) {
 	load();
 	mySaver = new ConfigSaveTask(*this);
 }
@@ -109,6 +110,9 @@ XMLConfig::~XMLConfig() {
 	if (myDelta != 0) {
 		delete myDelta;
 	}
+	if (myBinaryStore != 0) {
+		delete myBinaryStore;
+	}
 }
 
 XMLConfigGroup *XMLConfig::getGroup(const std::string &name, bool createUnexisting) {
@@ -162,14 +166,25 @@ void XMLConfig::removeGroup(const std::string &name) {
 				myDelta->addCategory(jt->second.Category);
 			}
 		}
+		if (myBinaryStore != 0) {
+			const std::map<std::string,XMLConfigValue> &values = it->second->myValues;
+			for (std::map<std::string,XMLConfigValue>::const_iterator jt = values.begin(); jt != values.end(); ++jt) {
+				myBinaryStore->unsetValue(name, jt->first);
+			}
+		}
 		delete it->second;
 		myGroups.erase(it);
 	}
 }
 
 void XMLConfig::setValue(const std::string &group, const std::string &name, const std::string &value, const std::string &category) {
-	if (getGroup(group, true)->setValue(name, value, category) && (myDelta != 0)) {
-		myDelta->setValue(group, name, value, category);
+	if (getGroup(group, true)->setValue(name, value, category)) {
+		if (myDelta != 0) {
+			myDelta->setValue(group, name, value, category);
+		}
+		if (myBinaryStore != 0) {
+			myBinaryStore->setValue(group, name, value, category);
+		}
 	}
 }
 
@@ -184,6 +199,9 @@ void XMLConfig::unsetValue(const std::string &group, const std::string &name) {
 			myDelta->addCategory(it->second.Category);
 			myDelta->unsetValue(group, name);
 		}
+		if (myBinaryStore != 0) {
+			myBinaryStore->unsetValue(group, name);
+		}
 		configGroup->myValues.erase(it);
 	}
 }
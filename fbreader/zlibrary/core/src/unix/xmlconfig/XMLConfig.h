@@ -56,6 +56,7 @@ private:
 	std::set<std::string> &myCategories;
 
 friend class XMLConfigWriter;
+friend class XMLConfigBinaryStore;
 friend class XMLConfig;
 };
 
@@ -97,11 +98,14 @@ private:
 	std::map<std::string,XMLConfigGroup*> myGroups;
 	std::set<std::string> myCategories;
 	class XMLConfigDelta *myDelta;
+	// 0 unless the library is built with XMLCONFIG_BINARY_STORE
+	class XMLConfigBinaryStore *myBinaryStore;
 
 	shared_ptr<ZLRunnable> mySaver;
 
 friend class XMLConfigWriter;
 friend class XMLConfigReader;
+friend class XMLConfigBinaryStore;
 friend class ConfigSaveTask;
 };
 
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <ZLFile.h>
+#include <ZLFileMapping.h>
+#include <ZLOutputStream.h>
+
+#include "XMLConfigBinaryStore.h"
+#include "XMLConfig.h"
+#include "XMLConfigDelta.h"
+
+static const char MAGIC[4] = { 'Z', 'L', 'C', 'F' };
+static const unsigned int FORMAT_VERSION = 1;
+static const size_t HEADER_SIZE = sizeof(MAGIC) + 8;
+
+enum {
+	SET_VALUE = 1,
+	UNSET_VALUE = 2
+};
+
+static void appendNumber(std::string &buffer, unsigned int number) {
+	buffer += (char)(number & 0xFF);
+	buffer += (char)((number >> 8) & 0xFF);
+	buffer += (char)((number >> 16) & 0xFF);
+	buffer += (char)((number >> 24) & 0xFF);
+}
+
+static void appendString(std::string &buffer, const std::string &str) {
+	appendNumber(buffer, str.length());
+	buffer += str;
+}
+
+static bool readNumber(const char *&ptr, const char *end, unsigned int &number) {
+	if (end - ptr < 4) {
+		return false;
+	}
+	const unsigned char *data = (const unsigned char*)ptr;
+	number = data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+	ptr += 4;
+	return true;
+}
+
+static bool readString(const char *&ptr, const char *end, std::string &str) {
+	unsigned int length;
+	if (!readNumber(ptr, end, length) || ((unsigned int)(end - ptr) < length)) {
+		return false;
+	}
+	str.assign(ptr, length);
+	ptr += length;
+	return true;
+}
+
+XMLConfigBinaryStore::XMLConfigBinaryStore(const std::string &path) : myPath(ZLFile(path).path()), myIsBroken(false) {
+}
+
+bool XMLConfigBinaryStore::load(XMLConfig &config) {
+	myIsBroken = false;
+	shared_ptr<ZLFileMapping> mapping = ZLFile(myPath).mapping();
+	if (mapping.isNull() || (mapping->size() < HEADER_SIZE) ||
+			!std::equal(MAGIC, MAGIC + sizeof(MAGIC), mapping->data())) {
+		return false;
+	}
+	const char *ptr = mapping->data() + sizeof(MAGIC);
+	const char *end = mapping->data() + mapping->size();
+	unsigned int version;
+	unsigned int snapshotSize;
+	if (!readNumber(ptr, end, version) || (version != FORMAT_VERSION) ||
+			!readNumber(ptr, end, snapshotSize) || ((unsigned int)(end - ptr) < snapshotSize)) {
+		return false;
+	}
+	const char *snapshotEnd = ptr + snapshotSize;
+
+	std::string group;
+	std::string name;
+	std::string value;
+	std::string category;
+	while (ptr < end) {
+		const bool isJournal = ptr >= snapshotEnd;
+		const char operation = *ptr++;
+		if (!readString(ptr, end, group) || !readString(ptr, end, name)) {
+			myIsBroken = true;
+			break;
+		}
+		if (operation == SET_VALUE) {
+			if (!readString(ptr, end, value) || !readString(ptr, end, category)) {
+				myIsBroken = true;
+			break;
+			}
+			config.getGroup(group, true)->setValue(name, value, category);
+			if (isJournal && (config.myDelta != 0)) {
+				config.myDelta->setValue(group, name, value, category);
+			}
+		} else if (operation == UNSET_VALUE) {
+			XMLConfigGroup *configGroup = config.getGroup(group, false);
+			if (configGroup != 0) {
+				std::map<std::string,XMLConfigValue>::iterator it = configGroup->myValues.find(name);
+				if (it != configGroup->myValues.end()) {
+					if (isJournal && (config.myDelta != 0)) {
+						config.myDelta->addCategory(it->second.Category);
+						config.myDelta->unsetValue(group, name);
+					}
+					configGroup->myValues.erase(it);
+				}
+			}
+		} else {
+			myIsBroken = true;
+			break;
+		}
+	}
+	return true;
+}
+
+void XMLConfigBinaryStore::save(const XMLConfig &config) {
+	std::string snapshot;
+	for (std::map<std::string,XMLConfigGroup*>::const_iterator it = config.myGroups.begin(); it != config.myGroups.end(); ++it) {
+		// values from the shipped config.xml are read before the snapshot,
+		// so only the values that differ from them are stored
+		const XMLConfigGroup *defaultGroup = config.getDefaultGroup(it->first);
+		const std::map<std::string,XMLConfigValue> &values = it->second->myValues;
+		for (std::map<std::string,XMLConfigValue>::const_iterator jt = values.begin(); jt != values.end(); ++jt) {
+			if (defaultGroup != 0) {
+				std::map<std::string,XMLConfigValue>::const_iterator kt = defaultGroup->myValues.find(jt->first);
+				if ((kt != defaultGroup->myValues.end()) && (kt->second.Value == jt->second.Value)) {
+					continue;
+				}
+			}
+			snapshot += (char)SET_VALUE;
+			appendString(snapshot, it->first);
+			appendString(snapshot, jt->first);
+			appendString(snapshot, jt->second.Value);
+			appendString(snapshot, jt->second.Category);
+		}
+	}
+
+	shared_ptr<ZLOutputStream> stream = ZLFile(myPath).outputStream();
+	if (!stream.isNull() && stream->open()) {
+		std::string header(MAGIC, sizeof(MAGIC));
+		appendNumber(header, FORMAT_VERSION);
+		appendNumber(header, snapshot.length());
+		stream->write(header);
+		stream->write(snapshot);
+		stream->close();
+		myIsBroken = false;
+	}
+	myPendingRecords.erase();
+}
+
+void XMLConfigBinaryStore::setValue(const std::string &group, const std::string &name, const std::string &value, const std::string &category) {
+	myPendingRecords += (char)SET_VALUE;
+	appendString(myPendingRecords, group);
+	appendString(myPendingRecords, name);
+	appendString(myPendingRecords, value);
+	appendString(myPendingRecords, category);
+}
+
+void XMLConfigBinaryStore::unsetValue(const std::string &group, const std::string &name) {
+	myPendingRecords += (char)UNSET_VALUE;
+	appendString(myPendingRecords, group);
+	appendString(myPendingRecords, name);
+}
+
+void XMLConfigBinaryStore::flush() {
+	// appending to a missing file would produce a file without header,
+	// appending to a broken one would produce unreadable records
+	if (myPendingRecords.empty() || myIsBroken || !ZLFile(myPath).exists()) {
+		return;
+	}
+	FILE *file = fopen(myPath.c_str(), "ab");
+	if (file == 0) {
+		return;
+	}
+	fseek(file, 0, SEEK_END);
+	const long offset = ftell(file);
+	if (fwrite(myPendingRecords.data(), 1, myPendingRecords.length(), file) == myPendingRecords.length()) {
+		myPendingRecords.erase();
+	} else if (offset >= 0) {
+		// a partly written record would hide all the records after it
+		fflush(file);
+		if (ftruncate(fileno(file), offset) != 0) {
+			myIsBroken = true;
+		}
+	}
+	fclose(file);
+}
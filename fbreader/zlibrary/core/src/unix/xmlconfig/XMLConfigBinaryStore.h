@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __XMLCONFIGBINARYSTORE_H__
+#define __XMLCONFIGBINARYSTORE_H__
+
+#include <string>
+
+class XMLConfig;
+
+/*
+ * Binary copy of the user part of XMLConfig. The file starts with a
+ * snapshot of all the values, followed by a journal of changes appended
+ * since the snapshot was written. Both consist of the same records: an
+ * operation byte and length prefixed strings. Reading stops at a torn
+ * or corrupt record; such a file has to be rewritten by save() before
+ * anything is appended to it, otherwise the new records would be lost.
+ */
+class XMLConfigBinaryStore {
+
+public:
+	XMLConfigBinaryStore(const std::string &path);
+
+	// replays the file into config; journal records also go to the config delta
+	bool load(XMLConfig &config);
+	// true if load() stopped at a broken record
+	bool isBroken() const;
+	// replaces the file by a snapshot of config and drops pending records
+	void save(const XMLConfig &config);
+
+	void setValue(const std::string &group, const std::string &name, const std::string &value, const std::string &category);
+	void unsetValue(const std::string &group, const std::string &name);
+	// appends pending records to the journal
+	void flush();
+
+private:
+	const std::string myPath;
+	std::string myPendingRecords;
+	bool myIsBroken;
+};
+
+inline bool XMLConfigBinaryStore::isBroken() const { return myIsBroken; }
+
+#endif /* __XMLCONFIGBINARYSTORE_H__ */
@@ -62,6 +62,7 @@ private:
 
 friend class XMLConfigReader;
 friend class XMLConfigDeltaWriter;
+friend class XMLConfigBinaryStore;
 friend class XMLConfig;
 };
 
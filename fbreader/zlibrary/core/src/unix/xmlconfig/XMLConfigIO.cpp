@@ -28,10 +28,12 @@
 #include "XMLConfigReader.h"
 #include "XMLConfigWriter.h"
 #include "XMLConfigDeltaWriter.h"
+#include "XMLConfigBinaryStore.h"
 
 const std::string XMLConfig::UNKNOWN_CATEGORY = ".unknown.";
 
 static const std::string CHANGES_FILE = "config.changes";
+static const std::string BINARY_FILE = "config.bin";
 
 void XMLConfig::load() {
 	XMLConfigReader(*this, "").readDocument(ZLibrary::DefaultFilesPathPrefix() + "config.xml");
@@ -41,6 +43,22 @@ void XMLConfig::load() {
 		it->second = new XMLConfigGroup(*it->second);
 	}
 	shared_ptr<ZLDir> configDir = ZLFile(ZLibrary::ApplicationWritableDirectory()).directory(false);
+
+#ifdef XMLCONFIG_BINARY_STORE
+	myBinaryStore = new XMLConfigBinaryStore(ZLibrary::ApplicationWritableDirectory() + ZLibrary::FileNameDelimiter + BINARY_FILE);
+	myDelta = new XMLConfigDelta();
+	if (myBinaryStore->load(*this)) {
+		if (myBinaryStore->isBroken()) {
+			// records saved after the broken one would be lost on the next start
+			myBinaryStore->save(*this);
+		}
+		return;
+	}
+	// no usable binary copy yet: read the XML files and convert them
+	delete myDelta;
+	myDelta = 0;
+#endif
+
 	if (!configDir.isNull()) {
 		std::vector<std::string> fileNames;
 		configDir->collectFiles(fileNames, true);
@@ -57,6 +75,10 @@ void XMLConfig::load() {
 	if (!configDir.isNull()) {
 		XMLConfigReader(*this, UNKNOWN_CATEGORY).readDocument(configDir->itemPath(CHANGES_FILE));
 	}
+	if (myBinaryStore != 0) {
+		ZLFile(ZLibrary::ApplicationWritableDirectory()).directory(true);
+		myBinaryStore->save(*this);
+	}
 }
 
 void XMLConfig::saveAll() {
@@ -81,12 +103,24 @@ void XMLConfig::saveAll() {
 	} // TODO: show error message if config was not saved
 	ZLFile changesFile(ZLibrary::ApplicationWritableDirectory() + ZLibrary::FileNameDelimiter + CHANGES_FILE);
 	changesFile.remove();
+	if (myBinaryStore != 0) {
+		myBinaryStore->save(*this);
+	}
 }
 
 void XMLConfig::saveDelta() {
 	if ((myDelta == 0) || (myDelta->myIsUpToDate)) {
 		return;
 	}
+	if (myBinaryStore != 0) {
+		if (myBinaryStore->isBroken()) {
+			myBinaryStore->save(*this);
+		} else {
+			myBinaryStore->flush();
+		}
+		myDelta->myIsUpToDate = true;
+		return;
+	}
 	shared_ptr<ZLDir> configDir = ZLFile(ZLibrary::ApplicationWritableDirectory()).directory(true);
 	shared_ptr<ZLOutputStream> stream = ZLFile(configDir->itemPath(CHANGES_FILE)).outputStream();
 	if (!stream.isNull() && stream->open()) {
@@ -17,61 +17,178 @@
  * 02110-1301, USA.
  */
 
+#include <cstring>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "ZLSearchUtil.h"
 #include "ZLUnicodeUtil.h"
 
-ZLSearchPattern::ZLSearchPattern(const std::string &pattern, bool ignoreCase) {
-	myIgnoreCase = ignoreCase;
+ZLSearchPattern::ZLSearchPattern(const std::string &pattern, bool ignoreCase) : myIgnoreCase(ignoreCase), myFixedWidth(true) {
 	if (myIgnoreCase) {
-		myLowerCasePattern = ZLUnicodeUtil::toLower(pattern);
-		myUpperCasePattern = ZLUnicodeUtil::toUpper(pattern);
+		ZLUnicodeUtil::Ucs4String ucs4String;
+		ZLUnicodeUtil::utf8ToUcs4(ucs4String, pattern);
+		char buffer[3];
+		for (ZLUnicodeUtil::Ucs4String::const_iterator it = ucs4String.begin(); it != ucs4String.end(); ++it) {
+			const int lowerLength = ZLUnicodeUtil::ucs4ToUtf8(buffer, ZLUnicodeUtil::toLower(*it));
+			myLowerCasePattern.append(buffer, lowerLength);
+			const int upperLength = ZLUnicodeUtil::ucs4ToUtf8(buffer, ZLUnicodeUtil::toUpper(*it));
+			myUpperCasePattern.append(buffer, upperLength);
+			myCharLengths.push_back(std::make_pair((unsigned char)lowerLength, (unsigned char)upperLength));
+			if (lowerLength != upperLength) {
+				myFixedWidth = false;
+			}
+		}
 	} else {
 		myLowerCasePattern = pattern;
 	}
+
+	const size_t len = myLowerCasePattern.length();
+	std::fill(mySkipTable, mySkipTable + 256, len);
+	if (myFixedWidth) {
+		for (size_t i = 0; i + 1 < len; ++i) {
+			mySkipTable[(unsigned char)myLowerCasePattern[i]] = len - 1 - i;
+			if (myIgnoreCase) {
+				mySkipTable[(unsigned char)myUpperCasePattern[i]] = len - 1 - i;
+			}
+		}
+	}
 }
 
 int ZLSearchUtil::find(const char *text, size_t length, const ZLSearchPattern &pattern, int pos) {
-	if (pattern.ignoreCase()) {
-		if (pos < 0) {
-			pos = 0;
+	size_t matchLength;
+	return find(text, length, pattern, pos, matchLength);
+}
+
+int ZLSearchUtil::find(const char *text, size_t length, const ZLSearchPattern &pattern, int pos, size_t &matchLength) {
+	if (pos < 0) {
+		pos = 0;
+	}
+	if (pattern.myFixedWidth) {
+		matchLength = pattern.length();
+		return findFixedWidth(text, length, pattern, pos);
+	} else {
+		return findVariableWidth(text, length, pattern, pos, matchLength);
+	}
+}
+
+bool ZLSearchUtil::matchesFixedWidth(const char *text, const ZLSearchPattern &pattern) {
+	const char *lower = pattern.myLowerCasePattern.data();
+	if (!pattern.myIgnoreCase) {
+		return memcmp(text, lower, pattern.myLowerCasePattern.length()) == 0;
+	}
+	// a character matches if it is equal to the lower or to the upper case
+	// variant as a whole; mixing bytes of both variants is not a match
+	const char *upper = pattern.myUpperCasePattern.data();
+	size_t offset = 0;
+	for (std::vector<std::pair<unsigned char,unsigned char> >::const_iterator it = pattern.myCharLengths.begin(); it != pattern.myCharLengths.end(); ++it) {
+		const size_t len = it->first;
+		if ((memcmp(text + offset, lower + offset, len) != 0) &&
+				(memcmp(text + offset, upper + offset, len) != 0)) {
+			return false;
 		}
-		const std::string &lower = pattern.lowerCasePattern();
-		const std::string &upper = pattern.upperCasePattern();
-		const char *last = text + length - pattern.lowerCasePattern().length();
-		const char *patternLast = lower.data() + lower.length() - 1;
-		for (const char *i = text + pos; i <= last; ++i) {
-			const char *j0 = lower.data();
-			const char *j1 = upper.data();
-			const char *k = i;
-			for (; j0 <= patternLast; ++j0, ++j1, ++k) {
-				if ((*j0 != *k) && (*j1 != *k)) {
-					break;
-				}
+		offset += len;
+	}
+	return true;
+}
+
+int ZLSearchUtil::findFixedWidth(const char *text, size_t length, const ZLSearchPattern &pattern, size_t pos) {
+	const size_t patternLength = pattern.myLowerCasePattern.length();
+	if (pos + patternLength > length) {
+		return -1;
+	}
+	if (patternLength == 0) {
+		return pos;
+	}
+	const size_t lastPos = length - patternLength;
+
+	const std::string &lower = pattern.myLowerCasePattern;
+	const std::string &upper = pattern.myIgnoreCase ? pattern.myUpperCasePattern : pattern.myLowerCasePattern;
+	const unsigned char lowerLast = lower[patternLength - 1];
+	const unsigned char upperLast = upper[patternLength - 1];
+
+	// look for positions where both the first and the last pattern bytes
+	// match, a whole vector of positions at a time
+#if defined(__AVX2__)
+	const __m256i lowerFirstV = _mm256_set1_epi8(lower[0]);
+	const __m256i upperFirstV = _mm256_set1_epi8(upper[0]);
+	const __m256i lowerLastV = _mm256_set1_epi8(lowerLast);
+	const __m256i upperLastV = _mm256_set1_epi8(upperLast);
+	for (; pos + 32 <= lastPos + 1; pos += 32) {
+		const __m256i first = _mm256_loadu_si256((const __m256i*)(text + pos));
+		const __m256i last = _mm256_loadu_si256((const __m256i*)(text + pos + patternLength - 1));
+		const __m256i eq = _mm256_and_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(first, lowerFirstV), _mm256_cmpeq_epi8(first, upperFirstV)),
+			_mm256_or_si256(_mm256_cmpeq_epi8(last, lowerLastV), _mm256_cmpeq_epi8(last, upperLastV))
+		);
+		for (unsigned int mask = _mm256_movemask_epi8(eq); mask != 0; mask &= mask - 1) {
+			const size_t candidate = pos + __builtin_ctz(mask);
+			if (matchesFixedWidth(text + candidate, pattern)) {
+				return candidate;
 			}
-			if (j0 > patternLast) {
-				return i - text;
+		}
+	}
+#elif defined(__SSE2__)
+	const __m128i lowerFirstV = _mm_set1_epi8(lower[0]);
+	const __m128i upperFirstV = _mm_set1_epi8(upper[0]);
+	const __m128i lowerLastV = _mm_set1_epi8(lowerLast);
+	const __m128i upperLastV = _mm_set1_epi8(upperLast);
+	for (; pos + 16 <= lastPos + 1; pos += 16) {
+		const __m128i first = _mm_loadu_si128((const __m128i*)(text + pos));
+		const __m128i last = _mm_loadu_si128((const __m128i*)(text + pos + patternLength - 1));
+		const __m128i eq = _mm_and_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(first, lowerFirstV), _mm_cmpeq_epi8(first, upperFirstV)),
+			_mm_or_si128(_mm_cmpeq_epi8(last, lowerLastV), _mm_cmpeq_epi8(last, upperLastV))
+		);
+		for (unsigned int mask = _mm_movemask_epi8(eq); mask != 0; mask &= mask - 1) {
+			const size_t candidate = pos + __builtin_ctz(mask);
+			if (matchesFixedWidth(text + candidate, pattern)) {
+				return candidate;
 			}
 		}
-		return -1;
-	} else {
-		if (pos < 0) {
-			pos = 0;
+	}
+#endif
+
+	// Boyer-Moore-Horspool for the tail (or everything without SIMD)
+	while (pos <= lastPos) {
+		const unsigned char c = text[pos + patternLength - 1];
+		if (((c == lowerLast) || (c == upperLast)) && matchesFixedWidth(text + pos, pattern)) {
+			return pos;
 		}
-		const std::string &lower = pattern.lowerCasePattern();
-		const char *last = text + length - pattern.lowerCasePattern().length();
-		const char *patternLast = lower.data() + lower.length() - 1;
-		for (const char *i = text + pos; i <= last; ++i) {
-			const char *j0 = lower.data();
-			const char *k = i;
-			for (; j0 <= patternLast; ++j0, ++k) {
-				if (*j0 != *k) {
-					break;
-				}
-			}
-			if (j0 > patternLast) {
-				return i - text;
+		pos += pattern.mySkipTable[c];
+	}
+	return -1;
+}
+
+int ZLSearchUtil::findVariableWidth(const char *text, size_t length, const ZLSearchPattern &pattern, size_t pos, size_t &matchLength) {
+	const char *lower = pattern.myLowerCasePattern.data();
+	const char *upper = pattern.myUpperCasePattern.data();
+	for (; pos < length; ++pos) {
+		const char *ptr = text + pos;
+		const char *end = text + length;
+		size_t lowerOffset = 0;
+		size_t upperOffset = 0;
+		std::vector<std::pair<unsigned char,unsigned char> >::const_iterator it = pattern.myCharLengths.begin();
+		for (; it != pattern.myCharLengths.end(); ++it) {
+			if (((size_t)(end - ptr) >= it->first) && (memcmp(ptr, lower + lowerOffset, it->first) == 0)) {
+				ptr += it->first;
+			} else if (((size_t)(end - ptr) >= it->second) && (memcmp(ptr, upper + upperOffset, it->second) == 0)) {
+				ptr += it->second;
+			} else {
+				break;
 			}
+			lowerOffset += it->first;
+			upperOffset += it->second;
+		}
+		if (it == pattern.myCharLengths.end()) {
+			matchLength = ptr - (text + pos);
+			return pos;
 		}
-		return -1;
 	}
+	return -1;
 }
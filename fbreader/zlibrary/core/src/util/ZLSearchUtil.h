@@ -21,6 +21,7 @@
 #define __ZLSEARCHUTIL_H__
 
 #include <string>
+#include <vector>
 
 class ZLSearchPattern {
 
@@ -29,7 +30,6 @@ public:
 	~ZLSearchPattern();
 	int length() const;
 
-private:
 	bool ignoreCase() const;
 	const std::string &lowerCasePattern() const;
 	const std::string &upperCasePattern() const;
@@ -39,6 +39,15 @@ private:
 	std::string myLowerCasePattern;
 	std::string myUpperCasePattern;
 
+	// in ignore case mode, byte lengths of every pattern character
+	// in the lower and the upper case variants
+	std::vector<std::pair<unsigned char,unsigned char> > myCharLengths;
+	// true if the lower and the upper case variants of every character
+	// have the same byte length, so any match is length() bytes long
+	bool myFixedWidth;
+	// Boyer-Moore-Horspool shifts by the byte under the window end
+	size_t mySkipTable[256];
+
 friend class ZLSearchUtil;
 };
 
@@ -49,6 +58,12 @@ private:
 
 public:
 	static int find(const char *text, size_t length, const ZLSearchPattern &pattern, int pos = 0);
+	static int find(const char *text, size_t length, const ZLSearchPattern &pattern, int pos, size_t &matchLength);
+
+private:
+	static int findFixedWidth(const char *text, size_t length, const ZLSearchPattern &pattern, size_t pos);
+	static int findVariableWidth(const char *text, size_t length, const ZLSearchPattern &pattern, size_t pos, size_t &matchLength);
+	static bool matchesFixedWidth(const char *text, const ZLSearchPattern &pattern);
 };
 
 inline ZLSearchPattern::~ZLSearchPattern() {}
@@ -32,9 +32,26 @@ const std::vector<std::string> &ZLPaintContext::fontFamilies() const {
 	return myFamilies;
 }
 
+bool ZLPaintContext::hasPageCache() const {
+	return false;
+}
+
+bool ZLPaintContext::containsPage(const std::string&) const {
+	return false;
+}
+
+bool ZLPaintContext::restorePage(const std::string&) {
+	return false;
+}
+
+void ZLPaintContext::storePage(const std::string&) {
+}
+
 int ZLPaintContext::imageWidth(const ZLImageData &image, int width, int height, ScalingType type) const {
-	const int origWidth = image.width();
-	const int origHeight = image.height();
+	return imageWidth(image.width(), image.height(), width, height, type);
+}
+
+int ZLPaintContext::imageWidth(int origWidth, int origHeight, int width, int height, ScalingType type) const {
 	if (origWidth == 0 || origHeight == 0) {
 		return 0;
 	}
@@ -54,8 +71,10 @@ int ZLPaintContext::imageWidth(const ZLImageData &image, int width, int height,
 }
 
 int ZLPaintContext::imageHeight(const ZLImageData &image, int width, int height, ScalingType type) const {
-	const int origWidth = image.width();
-	const int origHeight = image.height();
+	return imageHeight(image.width(), image.height(), width, height, type);
+}
+
+int ZLPaintContext::imageHeight(int origWidth, int origHeight, int width, int height, ScalingType type) const {
 	if (origWidth == 0 || origHeight == 0) {
 		return 0;
 	}
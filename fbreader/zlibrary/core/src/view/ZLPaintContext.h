@@ -69,6 +69,8 @@ public:
 	int imageHeight(const ZLImageData &image) const;
 	int imageWidth(const ZLImageData &image, int width, int height, ScalingType type) const;
 	int imageHeight(const ZLImageData &image, int width, int height, ScalingType type) const;
+	int imageWidth(int origWidth, int origHeight, int width, int height, ScalingType type) const;
+	int imageHeight(int origWidth, int origHeight, int width, int height, ScalingType type) const;
 	virtual void drawImage(int x, int y, const ZLImageData &image) = 0;
 	virtual void drawImage(int x, int y, const ZLImageData &image, int width, int height, ScalingType type) = 0;
 
@@ -79,6 +81,14 @@ public:
 	const std::vector<std::string> &fontFamilies() const;
 	virtual const std::string realFontFamilyName(std::string &fontFamily) const = 0;
 
+	// Optional cache of complete page images. The key is chosen by the view
+	// and has to identify everything drawn on the page; by default nothing
+	// is cached.
+	virtual bool hasPageCache() const;
+	virtual bool containsPage(const std::string &key) const;
+	virtual bool restorePage(const std::string &key);
+	virtual void storePage(const std::string &key);
+
 protected:
 	virtual void fillFamiliesList(std::vector<std::string> &families) const = 0;
 
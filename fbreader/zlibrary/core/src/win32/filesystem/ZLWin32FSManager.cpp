@@ -178,6 +178,7 @@ ZLFileInfo ZLWin32FSManager::fileInfo(const std::string &path) const {
 	if (path.empty()) {
 		info.Exists = true;
 		info.Size = 0;
+		info.MTime = 0;
 		info.IsDirectory = true;
 	} else {
 		ZLUnicodeUtil::Ucs2String wPath = longFilePath(path);
@@ -186,6 +187,11 @@ ZLFileInfo ZLWin32FSManager::fileInfo(const std::string &path) const {
 		if (info.Exists) {
 			info.IsDirectory = data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
 			info.Size = info.IsDirectory ? 0 : data.nFileSizeLow;
+			ULARGE_INTEGER time;
+			time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+			time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+			// FILETIME counts 100ns intervals since 1601-01-01
+			info.MTime = (long)((time.QuadPart - 116444736000000000ULL) / 10000000ULL);
 		}
 	}
 	return info;
@@ -63,7 +63,8 @@ bool ZLXMLReaderHandler::handleBuffer(const char *data, size_t len) {
 
 
 
-static const size_t BUFFER_SIZE = 2048;
+const size_t ZLXMLReader::DEFAULT_BUFFER_SIZE = 65536;
+static const size_t HEADER_SIZE = 256;
 
 void ZLXMLReader::startElementHandler(const char*, const char**) {
 }
@@ -81,13 +82,11 @@ const std::map<std::string,std::string> &ZLXMLReader::namespaces() const {
 	return *myNamespaces.back();
 }
 
-ZLXMLReader::ZLXMLReader(const char *encoding) {
+ZLXMLReader::ZLXMLReader(const char *encoding, size_t bufferSize) : myBufferSize(std::max(bufferSize, HEADER_SIZE)) {
 	myInternalReader = new ZLXMLReaderInternal(*this, encoding);
-	myParserBuffer = new char[BUFFER_SIZE];
 }
 
 ZLXMLReader::~ZLXMLReader() {
-	delete[] myParserBuffer;
 	delete myInternalReader;
 }
 
@@ -100,10 +99,11 @@ bool ZLXMLReader::readDocument(shared_ptr<ZLInputStream> stream) {
 		return false;
 	}
 
+	// the header is parsed as is, so the stream is not rewound
 	bool useWindows1252 = false;
-	stream->read(myParserBuffer, 256);
-	std::string stringBuffer(myParserBuffer, 256);
-	stream->seek(0, true);
+	char header[HEADER_SIZE];
+	size_t length = stream->read(header, HEADER_SIZE);
+	std::string stringBuffer(header, length);
 	int index = stringBuffer.find('>');
 	if (index > 0) {
 		stringBuffer = ZLUnicodeUtil::toLower(stringBuffer.substr(0, index));
@@ -114,13 +114,16 @@ bool ZLXMLReader::readDocument(shared_ptr<ZLInputStream> stream) {
 	}
 	initialize(useWindows1252 ? "windows-1252" : 0);
 
-	size_t length;
-	do {
-		length = stream->read(myParserBuffer, BUFFER_SIZE);
-		if (!readFromBuffer(myParserBuffer, length)) {
-			break;
+	if (readFromBuffer(header, length) && (length == HEADER_SIZE)) {
+		// the stream is read directly into the parser buffer
+		char *buffer;
+		while (!myInterrupted && ((buffer = myInternalReader->parserBuffer(myBufferSize)) != 0)) {
+			length = stream->read(buffer, myBufferSize);
+			if (!myInternalReader->parseParserBuffer(length) || (length != myBufferSize)) {
+				break;
+			}
 		}
-	} while ((length == BUFFER_SIZE) && !myInterrupted);
+	}
 
 	stream->close();
 
@@ -61,8 +61,12 @@ public:
 		const std::string myAttributeName;
 	};
 
+public:
+	static const size_t DEFAULT_BUFFER_SIZE;
+
 protected:
-	ZLXMLReader(const char *encoding = 0);
+	// bufferSize is the size of portions the document is read by
+	ZLXMLReader(const char *encoding = 0, size_t bufferSize = DEFAULT_BUFFER_SIZE);
 
 public:
 	virtual ~ZLXMLReader();
@@ -101,7 +105,7 @@ protected:
 private:
 	bool myInterrupted;
 	ZLXMLReaderInternal *myInternalReader;
-	char *myParserBuffer;
+	const size_t myBufferSize;
 	std::vector<shared_ptr<std::map<std::string,std::string> > > myNamespaces;
 
 	std::string myErrorMessage;
@@ -140,3 +140,11 @@ void ZLXMLReaderInternal::init(const char *encoding) {
 bool ZLXMLReaderInternal::parseBuffer(const char *buffer, size_t len) {
 	return XML_Parse(myParser, buffer, len, 0) != XML_STATUS_ERROR;
 }
+
+char *ZLXMLReaderInternal::parserBuffer(size_t len) {
+	return (char*)XML_GetBuffer(myParser, len);
+}
+
+bool ZLXMLReaderInternal::parseParserBuffer(size_t len) {
+	return XML_ParseBuffer(myParser, len, 0) != XML_STATUS_ERROR;
+}
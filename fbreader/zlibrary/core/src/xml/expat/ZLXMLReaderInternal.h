@@ -39,6 +39,10 @@ public:
 	void init(const char *encoding = 0);
 	bool parseBuffer(const char *buffer, size_t len);
 
+	// a buffer owned by the parser; after filling it, call parseParserBuffer
+	char *parserBuffer(size_t len);
+	bool parseParserBuffer(size_t len);
+
 private:
 	ZLXMLReader &myReader;
 	XML_Parser myParser;
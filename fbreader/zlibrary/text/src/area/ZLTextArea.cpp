@@ -161,16 +161,19 @@ ZLTextSelectionModel &ZLTextArea::selectionModel() {
 	return *mySelectionModel;
 }
 
-void ZLTextArea::paint() {
+void ZLTextArea::prepareTextMap() {
+	ZLTextArea::Style style(*this, myProperties.baseStyle());
+	std::vector<size_t> labels;
+	prepareTextMap(style, labels);
+}
+
+void ZLTextArea::prepareTextMap(Style &style, std::vector<size_t> &labels) {
 	myTextElementMap.clear();
 	myTreeNodeMap.clear();
 
-	std::vector<size_t> labels;
 	labels.reserve(myLineInfos.size() + 1);
 	labels.push_back(0);
 
-	ZLTextArea::Style style(*this, myProperties.baseStyle());
-
 	int y = 0;
 	for (std::vector<ZLTextLineInfoPtr>::const_iterator it = myLineInfos.begin(); it != myLineInfos.end(); ++it) {
 		const ZLTextLineInfo &info = **it;
@@ -186,8 +189,14 @@ void ZLTextArea::paint() {
 			mySelectionModel->update();
 		}
 	}
+}
 
-	y = 0;
+void ZLTextArea::paint() {
+	ZLTextArea::Style style(*this, myProperties.baseStyle());
+	std::vector<size_t> labels;
+	prepareTextMap(style, labels);
+
+	int y = 0;
 	int index = 0;
 	for (std::vector<ZLTextLineInfoPtr>::const_iterator it = myLineInfos.begin(); it != myLineInfos.end(); ++it) {
 		const ZLTextLineInfo &info = **it;
@@ -36,6 +36,7 @@ class ZLTextModel;
 class ZLTextLineInfo;
 class ZLTextLineInfoPtr;
 struct ZLTextTreeNodeInfo;
+class ZLTextImageElement;
 class ZLTextSelectionModel;
 
 class ZLTextArea {
@@ -81,16 +82,21 @@ public:
 	ZLTextSelectionModel &selectionModel();
 
 	void paint();
+	// builds the element map (used for hit testing) without drawing anything
+	void prepareTextMap();
 
 private:
 	void clear();
 
+	void prepareTextMap(Style &style, std::vector<size_t> &labels);
+
 	ZLTextLineInfoPtr processTextLine(Style &style, const ZLTextWordCursor &start, const ZLTextWordCursor &end);
 
 	void prepareTextLine(Style &style, const ZLTextLineInfo &info, int y);
 
 	void drawTextLine(Style &style, const ZLTextLineInfo &info, int y, size_t from, size_t to);
 	void drawWord(Style &style, int x, int y, const ZLTextWord &word, int start, int length, bool addHyphenationSign);
+	void drawImage(int x, int y, const ZLTextImageElement &image);
 	void drawString(Style &style, int x, int y, const char *str, int len, const ZLTextWord::Mark *mark, int shift, bool rtl);
 	void drawSelectionRectangle(int left, int top, int right, int bottom);
 	void drawTreeLines(const ZLTextTreeNodeInfo &info, int x, int y, int height, int vSpaceAfter);
@@ -21,6 +21,7 @@
 #include "ZLTextArea.h"
 #include "ZLTextAreaStyle.h"
 #include "ZLTextLineInfo.h"
+#include "ZLTextImageCache.h"
 
 ZLTextAreaController::ZLTextAreaController(ZLPaintContext &context, const ZLTextArea::Properties &properties) : myArea(context, properties), myPaintState(NOTHING_TO_PAINT) {
 }
@@ -34,7 +35,22 @@ void ZLTextAreaController::setModel(shared_ptr<ZLTextModel> model) {
 	myPaintState = myArea.isEmpty() ? NOTHING_TO_PAINT : START_IS_KNOWN;
 }
 
+void ZLTextAreaController::copyPage(const ZLTextAreaController &controller) {
+	const ZLTextArea &area = controller.myArea;
+	myArea.setModel(area.model());
+	myArea.setOffsets(area.hOffset(), area.vOffset());
+	myArea.setSize(area.width(), area.height());
+	myArea.myStartCursor = area.myStartCursor;
+	myArea.myEndCursor = area.myEndCursor;
+	myArea.myLineInfos = area.myLineInfos;
+
+	myPaintState = controller.myPaintState;
+}
+
 void ZLTextAreaController::clear() {
+	if (!myArea.model().isNull()) {
+		ZLTextImageCache::clear(*myArea.model());
+	}
 	myArea.clear();
 
 	myPaintState = NOTHING_TO_PAINT;
@@ -48,6 +48,8 @@ public:
 	ZLTextArea &area();
 
 	void setModel(shared_ptr<ZLTextModel> model);
+	// takes the model, size and page of controller as they are laid out there
+	void copyPage(const ZLTextAreaController &controller);
 	void clear();
 	bool preparePaintInfo();
 	void rebuildPaintInfo(bool strong);
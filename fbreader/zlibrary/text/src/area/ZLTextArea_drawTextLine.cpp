@@ -185,11 +185,7 @@ void ZLTextArea::drawTextLine(Style &style, const ZLTextLineInfo &info, int y, s
 			if (kind == ZLTextElement::WORD_ELEMENT) {
 				drawWord(style, wx, wy, (const ZLTextWord&)element, it->StartCharIndex, -1, false);
 			} else {
-				context().drawImage(
-					hOffset() + wx, vOffset() + wy,
-					*((const ZLTextImageElement&)element).image(),
-					width(), height(), ZLPaintContext::SCALE_REDUCE_SIZE
-				);
+				drawImage(hOffset() + wx, vOffset() + wy, (const ZLTextImageElement&)element);
 			}
 		}
 	}
@@ -207,3 +203,22 @@ void ZLTextArea::drawTextLine(Style &style, const ZLTextLineInfo &info, int y, s
 		drawWord(style, x, y, word, start, len, it->AddHyphenationSign);
 	}
 }
+
+void ZLTextArea::drawImage(int x, int y, const ZLTextImageElement &image) {
+	shared_ptr<ZLImageData> data = image.image(false);
+	if (!data.isNull()) {
+		context().drawImage(x, y, *data, width(), height(), ZLPaintContext::SCALE_REDUCE_SIZE);
+		return;
+	}
+
+	// the image is being decoded; its frame is drawn as a placeholder
+	const int w = context().imageWidth(image.width(), image.height(), width(), height(), ZLPaintContext::SCALE_REDUCE_SIZE);
+	const int h = context().imageHeight(image.width(), image.height(), width(), height(), ZLPaintContext::SCALE_REDUCE_SIZE);
+	if ((w > 0) && (h > 0)) {
+		context().setColor(myProperties.color(ZLTextStyle::TREE_LINES));
+		context().drawLine(x, y - h, x + w - 1, y - h);
+		context().drawLine(x + w - 1, y - h, x + w - 1, y - 1);
+		context().drawLine(x + w - 1, y - 1, x, y - 1);
+		context().drawLine(x, y - 1, x, y - h);
+	}
+}
@@ -101,7 +101,7 @@ ZLTextLineInfoPtr ZLTextArea::processTextLine(Style &style, const ZLTextWordCurs
 	}
 
 	if (isFirstLine) {
-		ZLTextElement::Kind elementKind = paragraphCursor[current.elementIndex()].kind();
+		ZLTextElement::Kind elementKind = paragraphCursor.kind(current.elementIndex());
 		while ((elementKind == ZLTextElement::CONTROL_ELEMENT) ||
 					 (elementKind == ZLTextElement::FORCED_CONTROL_ELEMENT)) {
 			style.applySingleControl(paragraphCursor[current.elementIndex()]);
@@ -109,7 +109,7 @@ ZLTextLineInfoPtr ZLTextArea::processTextLine(Style &style, const ZLTextWordCurs
 			if (current.equalElementIndex(end)) {
 				break;
 			}
-			elementKind = paragraphCursor[current.elementIndex()].kind();
+			elementKind = paragraphCursor.kind(current.elementIndex());
 		}
 		info.StartStyle = style.textStyle();
 		info.StartBidiLevel = style.bidiLevel();
@@ -143,7 +143,7 @@ ZLTextLineInfoPtr ZLTextArea::processTextLine(Style &style, const ZLTextWordCurs
 	int lastSpaceWidth = 0;
 	int removeLastSpace = false;
 
-	ZLTextElement::Kind elementKind = paragraphCursor[newInfo.End.elementIndex()].kind();
+	ZLTextElement::Kind elementKind = paragraphCursor.kind(newInfo.End.elementIndex());
 
 	bool breakedAtFirstWord = false;
 	do {
@@ -190,7 +190,7 @@ ZLTextLineInfoPtr ZLTextArea::processTextLine(Style &style, const ZLTextWordCurs
 		bool allowBreak = newInfo.End.equalElementIndex(end);
 		bool nbspaceBreak = false;
 		if (!allowBreak) {
-			elementKind = paragraphCursor[newInfo.End.elementIndex()].kind();
+			elementKind = paragraphCursor.kind(newInfo.End.elementIndex());
 			if (elementKind == ZLTextElement::NB_HSPACE_ELEMENT) {
 				if (allowBreakAtNBSpace) {
 					allowBreak = true;
@@ -20,15 +20,18 @@
 #ifndef __ZLTEXTELEMENT_H__
 #define __ZLTEXTELEMENT_H__
 
+#include <ZLImage.h>
 #include <ZLImageManager.h>
 
 #include <ZLTextKind.h>
 #include <ZLTextParagraph.h>
 
+class ZLTextModel;
+
 class ZLTextElement {
 
 protected:
-	ZLTextElement();
+	ZLTextElement(unsigned char kind);
 
 public:
 	virtual ~ZLTextElement();
@@ -49,7 +52,11 @@ public:
 		END_REVERSED_SEQUENCE_ELEMENT,
 	};
 
-	virtual Kind kind() const = 0;
+	// the kind is a plain field, so line processing needs no virtual calls
+	Kind kind() const;
+
+private:
+	const unsigned char myKind;
 
 private:
 	// assignment and copy constructor are disabled
@@ -60,17 +67,20 @@ private:
 class ZLTextImageElement : public ZLTextElement {
 
 public:
-	ZLTextImageElement(const std::string &id, shared_ptr<ZLImageData> image);
+	ZLTextImageElement(const std::string &id, const ZLTextModel *owner, shared_ptr<const ZLImage> image, unsigned int width, unsigned int height);
 	~ZLTextImageElement();
-	shared_ptr<ZLImageData> image() const;
+	// returns 0 until the image is decoded, unless wait is true
+	shared_ptr<ZLImageData> image(bool wait) const;
+	unsigned int width() const;
+	unsigned int height() const;
 	const std::string &id() const;
 
-private:
-	Kind kind() const;
-
 private:
 	const std::string myId;
-	shared_ptr<ZLImageData> myImage;
+	const ZLTextModel *myOwner;
+	shared_ptr<const ZLImage> myImage;
+	const unsigned int myWidth;
+	const unsigned int myHeight;
 };
 
 class ZLTextSpecialElement : public ZLTextElement {
@@ -78,12 +88,6 @@ class ZLTextSpecialElement : public ZLTextElement {
 public:
 	ZLTextSpecialElement(Kind kind);
 	~ZLTextSpecialElement();
-
-private:
-	Kind kind() const;
-
-private:
-	Kind myKind;
 };
 
 class ZLTextStyleElement : public ZLTextElement {
@@ -93,9 +97,6 @@ public:
 	~ZLTextStyleElement();
 	const ZLTextStyleEntry &entry() const;
 
-private:
-	Kind kind() const;
-
 private:
 	const shared_ptr<ZLTextParagraphEntry> myEntry;
 };
@@ -106,9 +107,6 @@ public:
 	ZLTextFixedHSpaceElement(unsigned char length);
 	unsigned char length() const;
 
-private:
-	Kind kind() const;
-
 private:
 	const unsigned char myLength;
 };
@@ -124,37 +122,36 @@ public:
 	ZLTextKind textKind() const;
 	bool isStart() const;
 
-private:
-	Kind kind() const;
-
 private:
 	const shared_ptr<ZLTextParagraphEntry> myEntry;
 
 friend class ZLTextElementPool;
 };
 
-inline ZLTextElement::ZLTextElement() {}
+inline ZLTextElement::ZLTextElement(unsigned char kind) : myKind(kind) {}
 inline ZLTextElement::~ZLTextElement() {}
+inline ZLTextElement::Kind ZLTextElement::kind() const { return (Kind)myKind; }
 
-inline ZLTextImageElement::ZLTextImageElement(const std::string &id, const shared_ptr<ZLImageData> image) : myId(id), myImage(image) {}
+inline ZLTextImageElement::ZLTextImageElement(const std::string &id, const ZLTextModel *owner, shared_ptr<const ZLImage> image, unsigned int width, unsigned int height) : ZLTextElement(IMAGE_ELEMENT), myId(id), myOwner(owner), myImage(image), myWidth(width), myHeight(height) {}
 inline ZLTextImageElement::~ZLTextImageElement() {}
-inline shared_ptr<ZLImageData> ZLTextImageElement::image() const { return myImage; }
+inline unsigned int ZLTextImageElement::width() const { return myWidth; }
+inline unsigned int ZLTextImageElement::height() const { return myHeight; }
 inline const std::string &ZLTextImageElement::id() const { return myId; }
 
-inline ZLTextSpecialElement::ZLTextSpecialElement(Kind kind) : myKind(kind) {}
+inline ZLTextSpecialElement::ZLTextSpecialElement(Kind kind) : ZLTextElement(kind) {}
 inline ZLTextSpecialElement::~ZLTextSpecialElement() {}
 
-inline ZLTextStyleElement::ZLTextStyleElement(const shared_ptr<ZLTextParagraphEntry> entry) : myEntry(entry) {}
+inline ZLTextStyleElement::ZLTextStyleElement(const shared_ptr<ZLTextParagraphEntry> entry) : ZLTextElement(FORCED_CONTROL_ELEMENT), myEntry(entry) {}
 inline ZLTextStyleElement::~ZLTextStyleElement() {}
 inline const ZLTextStyleEntry &ZLTextStyleElement::entry() const { return (const ZLTextStyleEntry&)*myEntry; }
 
-inline ZLTextControlElement::ZLTextControlElement(const shared_ptr<ZLTextParagraphEntry> entry) : myEntry(entry) {}
+inline ZLTextControlElement::ZLTextControlElement(const shared_ptr<ZLTextParagraphEntry> entry) : ZLTextElement(CONTROL_ELEMENT), myEntry(entry) {}
 inline ZLTextControlElement::~ZLTextControlElement() {}
 inline const ZLTextControlEntry &ZLTextControlElement::entry() const { return (const ZLTextControlEntry&)*myEntry; }
 inline ZLTextKind ZLTextControlElement::textKind() const { return entry().kind(); }
 inline bool ZLTextControlElement::isStart() const { return entry().isStart(); }
 
-inline ZLTextFixedHSpaceElement::ZLTextFixedHSpaceElement(unsigned char length) : myLength(length) {}
+inline ZLTextFixedHSpaceElement::ZLTextFixedHSpaceElement(unsigned char length) : ZLTextElement(FIXED_HSPACE_ELEMENT), myLength(length) {}
 inline unsigned char ZLTextFixedHSpaceElement::length() const { return myLength; }
 
 #endif /* __ZLTEXTELEMENT_H__ */
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <ZLImage.h>
+#include <ZLImageManager.h>
+#include <ZLRunnable.h>
+#include <ZLTimeManager.h>
+#include <ZLApplication.h>
+#include <ZLTime.h>
+
+#include "ZLTextImageCache.h"
+#include "ZLTextElement.h"
+
+static const long TIME_SLICE = 40;
+
+class ZLTextImageDecoder : public ZLRunnable {
+
+private:
+	void run();
+};
+
+void ZLTextImageDecoder::run() {
+	ZLTextImageCache::ourDecoderIsScheduled = false;
+	ZLTextImageCache::decodePending();
+}
+
+ZLTextImageCache::EntryList ZLTextImageCache::ourEntries;
+std::map<const ZLImage*,ZLTextImageCache::EntryList::iterator> ZLTextImageCache::ourIndex;
+size_t ZLTextImageCache::ourSize = 0;
+ZLTextImageCache::PendingList ZLTextImageCache::ourPending;
+shared_ptr<ZLRunnable> ZLTextImageCache::ourDecoder;
+bool ZLTextImageCache::ourDecoderIsScheduled = false;
+std::map<const ZLImage*,const ZLTextModel*> ZLTextImageCache::ourBrokenImages;
+unsigned int ZLTextImageCache::ourBrokenImagesRevision = 0;
+unsigned int ZLTextImageCache::ourPaintStamp = 1;
+bool ZLTextImageCache::ourPaintIsVisible = true;
+bool ZLTextImageCache::ourPaintIsComplete = true;
+
+void ZLTextImageCache::startPaint(bool visible) {
+	ourPaintIsVisible = visible;
+	ourPaintIsComplete = true;
+	if (visible) {
+		++ourPaintStamp;
+	}
+}
+
+bool ZLTextImageCache::finishPaint() {
+	// images requested outside of painting are treated as visible ones
+	ourPaintIsVisible = true;
+	return ourPaintIsComplete;
+}
+
+shared_ptr<ZLImageData> ZLTextImageCache::data(const ZLTextModel *owner, const shared_ptr<const ZLImage> &image, bool wait) {
+	if (image.isNull()) {
+		return 0;
+	}
+
+	const unsigned int stamp = ourPaintIsVisible ? ourPaintStamp : 0;
+
+	std::map<const ZLImage*,EntryList::iterator>::const_iterator it = ourIndex.find(&*image);
+	if (it != ourIndex.end()) {
+		ourEntries.splice(ourEntries.begin(), ourEntries, it->second);
+		if (stamp != 0) {
+			it->second->Stamp = stamp;
+		}
+		return it->second->Data;
+	}
+
+	if (wait) {
+		shared_ptr<ZLImageData> decoded = ZLImageManager::Instance().imageData(*image);
+		if (decoded.isNull()) {
+			ourBrokenImages[&*image] = owner;
+			++ourBrokenImagesRevision;
+		}
+		put(owner, image, decoded, stamp);
+		return decoded;
+	}
+
+	ourPaintIsComplete = false;
+	PendingList::iterator jt = ourPending.begin();
+	for (; jt != ourPending.end(); ++jt) {
+		if (jt->Image == image) {
+			break;
+		}
+	}
+	if (jt == ourPending.end()) {
+		PendingEntry pending;
+		pending.Owner = owner;
+		pending.Image = image;
+		pending.Stamp = stamp;
+		ourPending.push_back(pending);
+	} else if (stamp != 0) {
+		jt->Stamp = stamp;
+	}
+	if (!ourDecoderIsScheduled) {
+		if (ourDecoder.isNull()) {
+			ourDecoder = new ZLTextImageDecoder();
+		}
+		ZLTimeManager::Instance().addAutoRemovableTask(ourDecoder);
+		ourDecoderIsScheduled = true;
+	}
+	return 0;
+}
+
+void ZLTextImageCache::put(const ZLTextModel *owner, const shared_ptr<const ZLImage> &image, shared_ptr<ZLImageData> data, unsigned int stamp) {
+	Entry entry;
+	entry.Owner = owner;
+	entry.Image = image;
+	entry.Data = data;
+	entry.Size = data.isNull() ? 0 : 4 * data->width() * data->height();
+	entry.Stamp = stamp;
+	ourEntries.push_front(entry);
+	ourIndex[&*image] = ourEntries.begin();
+	ourSize += entry.Size;
+
+	// images of the visible page and the newest image are never dropped,
+	// so the visible page cannot push out its own images
+	EntryList::iterator it = ourEntries.end();
+	while ((ourSize > MAX_SIZE) && (it != ourEntries.begin())) {
+		--it;
+		if ((it == ourEntries.begin()) || (it->Stamp == ourPaintStamp)) {
+			continue;
+		}
+		ourSize -= it->Size;
+		ourIndex.erase(&*it->Image);
+		it = ourEntries.erase(it);
+	}
+}
+
+void ZLTextImageCache::decodePending() {
+	bool visibleDecoded = false;
+	bool brokenFound = false;
+	const ZLTime start;
+	while (!ourPending.empty() && (ZLTime().millisecondsFrom(start) < TIME_SLICE)) {
+		const PendingEntry pending = ourPending.front();
+		ourPending.pop_front();
+		if (ourIndex.find(&*pending.Image) == ourIndex.end()) {
+			shared_ptr<ZLImageData> decoded = ZLImageManager::Instance().imageData(*pending.Image);
+			if (decoded.isNull()) {
+				// the image was laid out from its header only; the lines
+				// have to be built again without it
+				ourBrokenImages[&*pending.Image] = pending.Owner;
+				++ourBrokenImagesRevision;
+				brokenFound = true;
+			}
+			put(pending.Owner, pending.Image, decoded, pending.Stamp);
+			if (pending.Stamp == ourPaintStamp) {
+				visibleDecoded = true;
+			}
+		}
+	}
+
+	if (!ourPending.empty()) {
+		ZLTimeManager::Instance().addAutoRemovableTask(ourDecoder);
+		ourDecoderIsScheduled = true;
+	}
+	// images of other pages are only prefetched; pages drawn with
+	// placeholders are not cached, so they are redrawn when shown
+	if (visibleDecoded || brokenFound) {
+		ZLApplication::Instance().refreshWindow();
+	}
+}
+
+void ZLTextImageCache::clear(const ZLTextModel &model) {
+	for (PendingList::iterator it = ourPending.begin(); it != ourPending.end();) {
+		if (it->Owner == &model) {
+			it = ourPending.erase(it);
+		} else {
+			++it;
+		}
+	}
+	if (ourPending.empty() && ourDecoderIsScheduled) {
+		ZLTimeManager::Instance().removeTask(ourDecoder);
+		ourDecoderIsScheduled = false;
+	}
+	for (std::map<const ZLImage*,const ZLTextModel*>::iterator it = ourBrokenImages.begin(); it != ourBrokenImages.end();) {
+		if (it->second == &model) {
+			ourBrokenImages.erase(it++);
+		} else {
+			++it;
+		}
+	}
+	for (EntryList::iterator it = ourEntries.begin(); it != ourEntries.end();) {
+		if (it->Owner == &model) {
+			ourSize -= it->Size;
+			ourIndex.erase(&*it->Image);
+			it = ourEntries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+bool ZLTextImageCache::isBroken(const ZLImage &image) {
+	return ourBrokenImages.find(&image) != ourBrokenImages.end();
+}
+
+shared_ptr<ZLImageData> ZLTextImageElement::image(bool wait) const {
+	return ZLTextImageCache::data(myOwner, myImage, wait);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLTEXTIMAGECACHE_H__
+#define __ZLTEXTIMAGECACHE_H__
+
+#include <list>
+#include <map>
+
+#include <shared_ptr.h>
+
+class ZLImage;
+class ZLImageData;
+class ZLRunnable;
+class ZLTextModel;
+
+/*
+ * Decoded images of the text elements. Layout uses the dimensions read
+ * from image headers, so an image is decoded only when it is painted;
+ * the decoding is done by an idle task. Least recently used images are
+ * dropped when the decoded data exceed MAX_SIZE bytes, except for the
+ * images of the visible page, and the window is refreshed only when an
+ * image requested by the visible page is ready.
+ */
+class ZLTextImageCache {
+
+public:
+	// returns 0 if the image cannot be decoded or if it is not decoded yet;
+	// in the latter case decoding is scheduled unless wait is true
+	static shared_ptr<ZLImageData> data(const ZLTextModel *owner, const shared_ptr<const ZLImage> &image, bool wait);
+
+	// brackets painting of a page; visible is false for prerendered pages
+	static void startPaint(bool visible);
+	// returns false if some images of the page were not decoded yet
+	static bool finishPaint();
+
+	// true if decoding of the image has failed; such images are
+	// skipped by the layout, like the images with unreadable headers
+	static bool isBroken(const ZLImage &image);
+	// changes when a laid out image fails to decode, so the views
+	// know they have to build their lines again
+	static unsigned int brokenImagesRevision();
+
+	// drops the images of the model
+	static void clear(const ZLTextModel &model);
+
+private:
+	static void decodePending();
+	static void put(const ZLTextModel *owner, const shared_ptr<const ZLImage> &image, shared_ptr<ZLImageData> data, unsigned int stamp);
+
+private:
+	static const size_t MAX_SIZE = 32 * 1024 * 1024;
+
+	struct Entry {
+		const ZLTextModel *Owner;
+		shared_ptr<const ZLImage> Image;
+		shared_ptr<ZLImageData> Data;
+		size_t Size;
+		// equal to ourPaintStamp if the visible page uses the image
+		unsigned int Stamp;
+	};
+	typedef std::list<Entry> EntryList;
+
+	struct PendingEntry {
+		const ZLTextModel *Owner;
+		shared_ptr<const ZLImage> Image;
+		unsigned int Stamp;
+	};
+	typedef std::list<PendingEntry> PendingList;
+
+	// most recently used images go first
+	static EntryList ourEntries;
+	static std::map<const ZLImage*,EntryList::iterator> ourIndex;
+	static size_t ourSize;
+
+	static PendingList ourPending;
+	static shared_ptr<ZLRunnable> ourDecoder;
+	static bool ourDecoderIsScheduled;
+
+	static std::map<const ZLImage*,const ZLTextModel*> ourBrokenImages;
+	static unsigned int ourBrokenImagesRevision;
+
+	static unsigned int ourPaintStamp;
+	static bool ourPaintIsVisible;
+	static bool ourPaintIsComplete;
+
+friend class ZLTextImageDecoder;
+
+private:
+	// Instance creation is disabled
+	ZLTextImageCache();
+};
+
+inline unsigned int ZLTextImageCache::brokenImagesRevision() { return ourBrokenImagesRevision; }
+
+#endif /* __ZLTEXTIMAGECACHE_H__ */
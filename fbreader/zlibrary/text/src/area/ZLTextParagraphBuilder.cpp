@@ -28,8 +28,10 @@
 #include "ZLTextParagraphCursor.h"
 #include "ZLTextWord.h"
 #include "ZLTextParagraphBuilder.h"
+#include "ZLTextImageCache.h"
 
 ZLTextParagraphCursor::Builder::Builder(ZLTextParagraphCursor &cursor) :
+	myModel(cursor.myModel),
 	myParagraph(*cursor.myModel[cursor.myIndex]),
 	myElements(cursor.myElements),
 	myLanguage(cursor.myModel.language()),
@@ -92,11 +94,19 @@ void ZLTextParagraphCursor::Builder::fill() {
 			{
 				ImageEntry &imageEntry = (ImageEntry&)*it.entry();
 				shared_ptr<const ZLImage> image = imageEntry.image();
-				if (!image.isNull()) {
-					shared_ptr<ZLImageData> data = ZLImageManager::Instance().imageData(*image);
-					if (!data.isNull()) {
-						myElements.push_back(new ZLTextImageElement(imageEntry.id(), data));
+				if (!image.isNull() && !ZLTextImageCache::isBroken(*image)) {
+					unsigned int width;
+					unsigned int height;
+					if (!ZLImageManager::Instance().imageSize(*image, width, height)) {
+						// unknown header format: decode the image right now
+						shared_ptr<ZLImageData> data = ZLTextImageCache::data(&myModel, image, true);
+						if (data.isNull()) {
+							break;
+						}
+						width = data->width();
+						height = data->height();
 					}
+					myElements.push_back(new ZLTextImageElement(imageEntry.id(), &myModel, image, width, height));
 				}
 				break;
 			}
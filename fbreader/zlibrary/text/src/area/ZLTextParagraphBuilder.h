@@ -45,6 +45,7 @@ private:
 	void insertRSElement();
 
 private:
+	const ZLTextModel &myModel;
 	const ZLTextParagraph &myParagraph;
 	ZLTextElementVector &myElements;
 
@@ -27,8 +27,11 @@
 
 ZLTextElementPool ZLTextElementPool::Pool;
 
-std::map<const ZLTextParagraph*, weak_ptr<ZLTextParagraphCursor> > ZLTextParagraphCursorCache::ourCache;
-ZLTextParagraphCursorPtr ZLTextParagraphCursorCache::ourLastAdded;
+std::map<const ZLTextParagraph*,ZLTextParagraphCursorCache::Entry> ZLTextParagraphCursorCache::ourCache;
+ZLTextParagraphCursorCache::RecentList ZLTextParagraphCursorCache::ourRecent;
+size_t ZLTextParagraphCursorCache::ourElementsNumber = 0;
+unsigned long ZLTextParagraphCursorCache::ourHits = 0;
+unsigned long ZLTextParagraphCursorCache::ourMisses = 0;
 
 ZLTextElementVector::~ZLTextElementVector() {
 	for (ZLTextElementVector::const_iterator it = begin(); it != end(); ++it) {
@@ -196,7 +199,7 @@ ZLTextMark ZLTextWordCursor::position() const {
 	const ZLTextParagraphCursor &paragraph = *myParagraphCursor;
 	size_t paragraphLength = paragraph.paragraphLength();
 	unsigned int elementIndex = myElementIndex;
-	while ((elementIndex != paragraphLength) && (paragraph[elementIndex].kind() != ZLTextElement::WORD_ELEMENT)) {
+	while ((elementIndex != paragraphLength) && (paragraph.kind(elementIndex) != ZLTextElement::WORD_ELEMENT)) {
 		++elementIndex;
 	}
 	if (elementIndex != paragraphLength) {
@@ -237,30 +240,79 @@ void ZLTextParagraphCursor::fill() {
 		case ZLTextParagraph::END_OF_TEXT_PARAGRAPH:
 			break;
 	}
+
+	myKinds.clear();
+	myKinds.reserve(myElements.size());
+	for (ZLTextElementVector::const_iterator it = myElements.begin(); it != myElements.end(); ++it) {
+		myKinds.push_back((*it)->kind());
+	}
 }
 
 void ZLTextParagraphCursor::clear() {
 	myElements.clear();
+	myKinds.clear();
+}
+
+void ZLTextParagraphCursorCache::touch(const ZLTextParagraph *paragraph, Entry &entry, ZLTextParagraphCursorPtr cursor) {
+	if (entry.Recent != ourRecent.end()) {
+		ourRecent.splice(ourRecent.begin(), ourRecent, entry.Recent);
+		return;
+	}
+
+	RecentEntry recent;
+	recent.Paragraph = paragraph;
+	recent.Cursor = cursor;
+	recent.ElementsNumber = cursor->paragraphLength();
+	ourRecent.push_front(recent);
+	entry.Recent = ourRecent.begin();
+	ourElementsNumber += recent.ElementsNumber;
+
+	// the most recent cursor is kept even if it is too long alone
+	while ((ourElementsNumber > MAX_ELEMENTS_NUMBER) && (ourRecent.size() > 1)) {
+		const RecentEntry &last = ourRecent.back();
+		ourElementsNumber -= last.ElementsNumber;
+		ourCache[last.Paragraph].Recent = ourRecent.end();
+		ourRecent.pop_back();
+	}
 }
 
 void ZLTextParagraphCursorCache::put(const ZLTextParagraph *paragraph, ZLTextParagraphCursorPtr cursor) {
-	ourCache[paragraph] = cursor;
-	ourLastAdded = cursor;
+	Entry newEntry;
+	newEntry.Recent = ourRecent.end();
+	Entry &entry = ourCache.insert(std::make_pair(paragraph, newEntry)).first->second;
+	if (entry.Recent != ourRecent.end()) {
+		ourElementsNumber -= entry.Recent->ElementsNumber;
+		ourRecent.erase(entry.Recent);
+		entry.Recent = ourRecent.end();
+	}
+	entry.Cursor = cursor;
+	touch(paragraph, entry, cursor);
 }
 
 ZLTextParagraphCursorPtr ZLTextParagraphCursorCache::get(const ZLTextParagraph *paragraph) {
-	return ourCache[paragraph];
+	std::map<const ZLTextParagraph*,Entry>::iterator it = ourCache.find(paragraph);
+	if (it != ourCache.end()) {
+		ZLTextParagraphCursorPtr cursor = it->second.Cursor;
+		if (!cursor.isNull()) {
+			++ourHits;
+			touch(paragraph, it->second, cursor);
+			return cursor;
+		}
+	}
+	++ourMisses;
+	return 0;
 }
 
 void ZLTextParagraphCursorCache::clear() {
-	ourLastAdded.reset();
+	ourRecent.clear();
+	ourElementsNumber = 0;
 	ourCache.clear();
 }
 
 void ZLTextParagraphCursorCache::cleanup() {
-	std::map<const ZLTextParagraph*, weak_ptr<ZLTextParagraphCursor> > cleanedCache;
-	for (std::map<const ZLTextParagraph*, weak_ptr<ZLTextParagraphCursor> >::iterator it = ourCache.begin(); it != ourCache.end(); ++it) {
-		if (!it->second.isNull()) {
+	std::map<const ZLTextParagraph*,Entry> cleanedCache;
+	for (std::map<const ZLTextParagraph*,Entry>::iterator it = ourCache.begin(); it != ourCache.end(); ++it) {
+		if (!it->second.Cursor.isNull()) {
 			cleanedCache.insert(*it);
 		}
 	}
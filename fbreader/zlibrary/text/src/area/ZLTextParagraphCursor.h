@@ -21,6 +21,7 @@
 #define __ZLTEXTPARAGRAPHCURSOR_H__
 
 #include <vector>
+#include <list>
 #include <map>
 #include <string>
 
@@ -95,6 +96,7 @@ public:
 	virtual ZLTextParagraphCursorPtr next() const = 0;
 
 	const ZLTextElement &operator [] (size_t index) const;
+	ZLTextElement::Kind kind(size_t index) const;
 	const ZLTextParagraph &paragraph() const;
 
 private:
@@ -113,10 +115,18 @@ protected:
 	const ZLTextModel &myModel;
 	size_t myIndex;
 	ZLTextElementVector myElements;
+	// kinds of myElements, packed for scans that do not need the elements
+	std::vector<unsigned char> myKinds;
 
 friend class ZLTextWordCursor;
 };
 
+/*
+ * Recently built paragraph cursors are kept alive in LRU order while
+ * their total length is below MAX_ELEMENTS_NUMBER elements; older
+ * cursors stay reachable through the cache as long as someone else
+ * holds them.
+ */
 class ZLTextParagraphCursorCache {
 
 public:
@@ -126,9 +136,34 @@ public:
 	static void clear();
 	static void cleanup();
 
+	static unsigned long hits();
+	static unsigned long misses();
+
 private:
-	static std::map<const ZLTextParagraph*, weak_ptr<ZLTextParagraphCursor> > ourCache;
-	static ZLTextParagraphCursorPtr ourLastAdded;
+	static const size_t MAX_ELEMENTS_NUMBER = 32768;
+
+	struct RecentEntry {
+		const ZLTextParagraph *Paragraph;
+		ZLTextParagraphCursorPtr Cursor;
+		size_t ElementsNumber;
+	};
+	typedef std::list<RecentEntry> RecentList;
+
+	struct Entry {
+		weak_ptr<ZLTextParagraphCursor> Cursor;
+		// ourRecent.end() if the cursor is not held by the cache
+		RecentList::iterator Recent;
+	};
+
+	static void touch(const ZLTextParagraph *paragraph, Entry &entry, ZLTextParagraphCursorPtr cursor);
+
+private:
+	static std::map<const ZLTextParagraph*,Entry> ourCache;
+	// most recently used cursors go first
+	static RecentList ourRecent;
+	static size_t ourElementsNumber;
+	static unsigned long ourHits;
+	static unsigned long ourMisses;
 
 private:
 	// Instance creation is disabled
@@ -225,7 +260,11 @@ inline void ZLTextElementPool::storeControlElement(ZLTextControlElement *element
 
 inline size_t ZLTextParagraphCursor::index() const { return myIndex; }
 inline const ZLTextElement &ZLTextParagraphCursor::operator [] (size_t index) const { return *myElements[index]; }
+inline ZLTextElement::Kind ZLTextParagraphCursor::kind(size_t index) const { return (ZLTextElement::Kind)myKinds[index]; }
 inline const ZLTextParagraph &ZLTextParagraphCursor::paragraph() const { return *myModel[myIndex]; }
+inline unsigned long ZLTextParagraphCursorCache::hits() { return ourHits; }
+inline unsigned long ZLTextParagraphCursorCache::misses() { return ourMisses; }
+
 inline size_t ZLTextParagraphCursor::paragraphLength() const { return myElements.size(); }
 
 inline ZLTextWordCursor::ZLTextWordCursor() : myElementIndex(0), myCharIndex(0) {}
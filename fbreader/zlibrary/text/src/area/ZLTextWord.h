@@ -54,7 +54,6 @@ private:
 	~ZLTextWord();
 
 public:
-	Kind kind() const;
 	short width(const ZLPaintContext &context) const;
 
 	void addMark(int start, int len);
@@ -81,7 +80,6 @@ private:
 friend class ZLTextElementPool;
 };
 
-inline ZLTextElement::Kind ZLTextWord::kind() const { return WORD_ELEMENT; }
 inline ZLTextWord::Mark *ZLTextWord::mark() const { return myMark; }
 inline short ZLTextWord::width(const ZLPaintContext &context) const {
 	if (myWidth == -1) {
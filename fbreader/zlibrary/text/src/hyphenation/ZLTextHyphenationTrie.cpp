@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <map>
+
+#include <ZLFile.h>
+#include <ZLInputStream.h>
+#include <ZLOutputStream.h>
+
+#include "ZLTextHyphenationTrie.h"
+#include "ZLTextTeXHyphenator.h"
+
+void ZLTextHyphenationTrie::clear() {
+	myEdgeStarts.clear();
+	myEdgeSymbols.clear();
+	myEdgeTargets.clear();
+	myValueOffsets.clear();
+	myValues.clear();
+}
+
+void ZLTextHyphenationTrie::build(const std::vector<ZLTextTeXHyphenationPattern*> &patterns) {
+	clear();
+
+	std::vector<std::map<ZLUnicodeUtil::Ucs4Char,unsigned int> > children(1);
+	myValueOffsets.push_back(-1);
+	for (std::vector<ZLTextTeXHyphenationPattern*>::const_iterator it = patterns.begin(); it != patterns.end(); ++it) {
+		const ZLTextTeXHyphenationPattern &pattern = **it;
+		unsigned int node = 0;
+		for (int i = 0; i < pattern.myLength; ++i) {
+			std::map<ZLUnicodeUtil::Ucs4Char,unsigned int>::const_iterator jt = children[node].find(pattern.mySymbols[i]);
+			if (jt != children[node].end()) {
+				node = jt->second;
+			} else {
+				const unsigned int newNode = children.size();
+				children[node][pattern.mySymbols[i]] = newNode;
+				children.push_back(std::map<ZLUnicodeUtil::Ucs4Char,unsigned int>());
+				myValueOffsets.push_back(-1);
+				node = newNode;
+			}
+		}
+		// for duplicated patterns the first one wins
+		if (myValueOffsets[node] == -1) {
+			myValueOffsets[node] = myValues.size();
+			myValues.insert(myValues.end(), pattern.myValues, pattern.myValues + pattern.myLength + 1);
+		}
+	}
+
+	myEdgeStarts.reserve(children.size() + 1);
+	for (std::vector<std::map<ZLUnicodeUtil::Ucs4Char,unsigned int> >::const_iterator it = children.begin(); it != children.end(); ++it) {
+		myEdgeStarts.push_back(myEdgeSymbols.size());
+		for (std::map<ZLUnicodeUtil::Ucs4Char,unsigned int>::const_iterator jt = it->begin(); jt != it->end(); ++jt) {
+			myEdgeSymbols.push_back(jt->first);
+			myEdgeTargets.push_back(jt->second);
+		}
+	}
+	myEdgeStarts.push_back(myEdgeSymbols.size());
+}
+
+int ZLTextHyphenationTrie::child(unsigned int node, ZLUnicodeUtil::Ucs4Char symbol) const {
+	const std::vector<ZLUnicodeUtil::Ucs4Char>::const_iterator begin = myEdgeSymbols.begin() + myEdgeStarts[node];
+	const std::vector<ZLUnicodeUtil::Ucs4Char>::const_iterator end = myEdgeSymbols.begin() + myEdgeStarts[node + 1];
+	const std::vector<ZLUnicodeUtil::Ucs4Char>::const_iterator it = std::lower_bound(begin, end, symbol);
+	return ((it != end) && (*it == symbol)) ? (int)myEdgeTargets[it - myEdgeSymbols.begin()] : -1;
+}
+
+void ZLTextHyphenationTrie::apply(const ZLUnicodeUtil::Ucs4Char *word, int length, unsigned char *values) const {
+	if (isEmpty()) {
+		return;
+	}
+	int node = 0;
+	for (int k = 0; k < length; ++k) {
+		node = child(node, word[k]);
+		if (node == -1) {
+			break;
+		}
+		const int offset = myValueOffsets[node];
+		if (offset != -1) {
+			const unsigned char *patternValues = &myValues[offset];
+			for (int i = 0; i <= k + 1; ++i) {
+				if (values[i] < patternValues[i]) {
+					values[i] = patternValues[i];
+				}
+			}
+		}
+	}
+}
+
+static const char CACHE_MAGIC[4] = { 'Z', 'L', 'H', '1' };
+
+template <class T>
+static void writeVector(ZLOutputStream &stream, const std::vector<T> &v) {
+	const unsigned long size = v.size();
+	stream.write((const char*)&size, sizeof(size));
+	if (size > 0) {
+		stream.write((const char*)&v[0], size * sizeof(T));
+	}
+}
+
+template <class T>
+static bool readVector(ZLInputStream &stream, std::vector<T> &v) {
+	unsigned long size = 0;
+	if (stream.read((char*)&size, sizeof(size)) != sizeof(size)) {
+		return false;
+	}
+	if (size > stream.sizeOfOpened() / sizeof(T)) {
+		return false;
+	}
+	v.resize(size);
+	return
+		(size == 0) ||
+		(stream.read((char*)&v[0], size * sizeof(T)) == size * sizeof(T));
+}
+
+bool ZLTextHyphenationTrie::load(const std::string &path, unsigned long key) {
+	clear();
+	shared_ptr<ZLInputStream> stream = ZLFile(path).inputStream();
+	if (stream.isNull() || !stream->open()) {
+		return false;
+	}
+	char magic[sizeof(CACHE_MAGIC)];
+	unsigned long storedKey = 0;
+	bool success =
+		(stream->read(magic, sizeof(magic)) == sizeof(magic)) &&
+		std::equal(magic, magic + sizeof(magic), CACHE_MAGIC) &&
+		(stream->read((char*)&storedKey, sizeof(storedKey)) == sizeof(storedKey)) &&
+		(storedKey == key) &&
+		readVector(*stream, myEdgeStarts) &&
+		readVector(*stream, myEdgeSymbols) &&
+		readVector(*stream, myEdgeTargets) &&
+		readVector(*stream, myValueOffsets) &&
+		readVector(*stream, myValues) &&
+		(myEdgeStarts.size() == myValueOffsets.size() + 1) &&
+		(myEdgeSymbols.size() == myEdgeTargets.size()) &&
+		(myEdgeStarts.back() == myEdgeSymbols.size());
+	for (std::vector<unsigned int>::const_iterator it = myEdgeTargets.begin(); success && (it != myEdgeTargets.end()); ++it) {
+		success = *it < myValueOffsets.size();
+	}
+	for (std::vector<int>::const_iterator it = myValueOffsets.begin(); success && (it != myValueOffsets.end()); ++it) {
+		success = (*it >= -1) && (*it < (int)myValues.size());
+	}
+	stream->close();
+	if (!success) {
+		clear();
+	}
+	return success;
+}
+
+void ZLTextHyphenationTrie::save(const std::string &path, unsigned long key) const {
+	shared_ptr<ZLOutputStream> stream = ZLFile(path).outputStream();
+	if (stream.isNull() || !stream->open()) {
+		return;
+	}
+	stream->write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	stream->write((const char*)&key, sizeof(key));
+	writeVector(*stream, myEdgeStarts);
+	writeVector(*stream, myEdgeSymbols);
+	writeVector(*stream, myEdgeTargets);
+	writeVector(*stream, myValueOffsets);
+	writeVector(*stream, myValues);
+	stream->close();
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLTEXTHYPHENATIONTRIE_H__
+#define __ZLTEXTHYPHENATIONTRIE_H__
+
+#include <vector>
+#include <string>
+
+#include <ZLUnicodeUtil.h>
+
+class ZLTextTeXHyphenationPattern;
+
+/*
+ * Hyphenation patterns packed into a trie. Outgoing edges of every node
+ * are stored contiguously and sorted by symbol, so a child is found by a
+ * binary search; a node that terminates a pattern refers to the pattern
+ * inter-letter values (depth + 1 of them) stored in a common pool.
+ */
+class ZLTextHyphenationTrie {
+
+public:
+	ZLTextHyphenationTrie();
+	~ZLTextHyphenationTrie();
+
+	void build(const std::vector<ZLTextTeXHyphenationPattern*> &patterns);
+	void clear();
+	bool isEmpty() const;
+
+	// applies all patterns matching word[0..k) for every k to values
+	void apply(const ZLUnicodeUtil::Ucs4Char *word, int length, unsigned char *values) const;
+
+	bool load(const std::string &path, unsigned long key);
+	void save(const std::string &path, unsigned long key) const;
+
+private:
+	int child(unsigned int node, ZLUnicodeUtil::Ucs4Char symbol) const;
+
+private:
+	std::vector<unsigned int> myEdgeStarts;
+	std::vector<ZLUnicodeUtil::Ucs4Char> myEdgeSymbols;
+	std::vector<unsigned int> myEdgeTargets;
+	std::vector<int> myValueOffsets;
+	std::vector<unsigned char> myValues;
+
+private: // disable copying
+	ZLTextHyphenationTrie(const ZLTextHyphenationTrie&);
+	const ZLTextHyphenationTrie &operator = (const ZLTextHyphenationTrie&);
+};
+
+inline ZLTextHyphenationTrie::ZLTextHyphenationTrie() {}
+inline ZLTextHyphenationTrie::~ZLTextHyphenationTrie() {}
+inline bool ZLTextHyphenationTrie::isEmpty() const { return myValues.empty(); }
+
+#endif /* __ZLTEXTHYPHENATIONTRIE_H__ */
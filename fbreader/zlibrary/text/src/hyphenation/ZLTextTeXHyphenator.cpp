@@ -44,10 +44,8 @@ const std::string ZLTextTeXHyphenator::PatternZip() {
 	return ZLibrary::ZLibraryDirectory() + ZLibrary::FileNameDelimiter + "hyphenationPatterns.zip";
 }
 
-ZLTextTeXHyphenationPattern::ZLTextTeXHyphenationPattern(ZLUnicodeUtil::Ucs4Char *ucs4String, int length) {
-	myLength = length;
-	mySymbols = ucs4String;
-	myValues = NULL;
+const std::string ZLTextTeXHyphenator::CacheDirectory() {
+	return ZLibrary::ApplicationWritableDirectory() + ZLibrary::FileNameDelimiter + "hyphenation";
 }
 
 ZLTextTeXHyphenationPattern::ZLTextTeXHyphenationPattern(const std::string &utf8String) {
@@ -79,69 +77,43 @@ ZLTextTeXHyphenationPattern::ZLTextTeXHyphenationPattern(const std::string &utf8
 }
 
 ZLTextTeXHyphenationPattern::~ZLTextTeXHyphenationPattern() {
-	if (myValues != NULL) {
-		delete[] mySymbols;
-		delete[] myValues;
-	}
-}
-
-void ZLTextTeXHyphenationPattern::apply(unsigned char *values) const {
-	for (int i = 0; i <= myLength; ++i) {
-		if (values[i] < myValues[i]) {
-			values[i] = myValues[i];
-		}
-	}
-}
-
-bool ZLTextTeXPatternComparator::operator() (const ZLTextTeXHyphenationPattern *p1, const ZLTextTeXHyphenationPattern *p2) const {
-	bool firstIsShorter = p1->myLength < p2->myLength;
-	int minLength = firstIsShorter ? p1->myLength : p2->myLength;
-	const ZLUnicodeUtil::Ucs4Char *symbols1 = p1->mySymbols;
-	const ZLUnicodeUtil::Ucs4Char *symbols2 = p2->mySymbols;
-	for (int i = 0; i < minLength; ++i) {
-		if (symbols1[i] < symbols2[i]) {
-			return true;
-		} else if (symbols1[i] > symbols2[i]) {
-			return false;
-		}
-	}
-	return firstIsShorter;
+	delete[] mySymbols;
+	delete[] myValues;
 }
 
 static std::vector<unsigned char> values;
-static ZLTextTeXPatternComparator comparator = ZLTextTeXPatternComparator();
 
 void ZLTextTeXHyphenator::hyphenate(ZLUnicodeUtil::Ucs4String &ucs4String, std::vector<unsigned char> &mask, int length) const {
-	if (myPatternTable.empty()) {
+	if (myTrie.isEmpty()) {
 		for (int i = 0; i < length - 1; ++i) {
 			mask[i] = false;
 		}
 		return;
 	}
-	
+
+	const ZLUnicodeUtil::Ucs4String word(ucs4String.begin(), ucs4String.begin() + length);
+	std::map<ZLUnicodeUtil::Ucs4String,std::list<MaskCacheEntry>::iterator>::iterator it = myMaskCacheIndex.find(word);
+	if (it != myMaskCacheIndex.end()) {
+		myMaskCache.splice(myMaskCache.begin(), myMaskCache, it->second);
+		std::copy(it->second->second.begin(), it->second->second.end(), mask.begin());
+		return;
+	}
+
 	values.assign(length + 1, 0);
-	
 	for (int j = 0; j < length - 2; ++j) {
-		ZLTextTeXHyphenator::PatternIterator dictionaryPattern = myPatternTable.begin();
-		for (int k = 1; k <= length - j; ++k) {
-			ZLTextTeXHyphenationPattern pattern(&ucs4String[j], k);
-			if (comparator(&pattern, *dictionaryPattern)) {
-				continue;
-			}
-			dictionaryPattern =
-				std::lower_bound(myPatternTable.begin(), myPatternTable.end(), &pattern, comparator);
-			if (dictionaryPattern == myPatternTable.end()) {
-				break;
-			}
-			if (!comparator(&pattern, *dictionaryPattern)) {
-				(*dictionaryPattern)->apply(&values[j]);
-			}
-		}
+		myTrie.apply(&ucs4String[j], length - j, &values[j]);
 	}
 
 	for (int i = 0; i < length - 1; ++i) {
 		mask[i] = values[i + 1] % 2 == 1;
 	}
+
+	myMaskCache.push_front(MaskCacheEntry(word, std::vector<unsigned char>(mask.begin(), mask.begin() + length - 1)));
+	myMaskCacheIndex[word] = myMaskCache.begin();
+	if (myMaskCache.size() > MASK_CACHE_SIZE) {
+		myMaskCacheIndex.erase(myMaskCache.back().first);
+		myMaskCache.pop_back();
+	}
 }
 
 ZLTextTeXHyphenator::~ZLTextTeXHyphenator() {
@@ -156,9 +128,28 @@ void ZLTextTeXHyphenator::load(const std::string &language) {
 	
 	unload();
 
-	ZLTextHyphenationReader(this).readDocument(PatternZip() + ":" + language + POSTFIX);
-	
-	std::sort(myPatternTable.begin(), myPatternTable.end(), ZLTextTeXPatternComparator());
+	const std::string patternPath = PatternZip() + ":" + language + POSTFIX;
+	const ZLFile patternFile(patternPath);
+	if (!patternFile.exists()) {
+		return;
+	}
+	// compiled trie is cached and reused while the pattern file is unchanged
+	const unsigned long cacheKey = ZLFile(PatternZip()).size() * 1000003UL + patternFile.size();
+	const std::string cachePath = CacheDirectory() + ZLibrary::FileNameDelimiter + language + ".trie";
+	if (myTrie.load(cachePath, cacheKey)) {
+		return;
+	}
+
+	ZLTextHyphenationReader(this).readDocument(patternPath);
+	myTrie.build(myPatternTable);
+	for (PatternIterator it = myPatternTable.begin(); it != myPatternTable.end(); ++it) {
+		delete *it;
+	}
+	myPatternTable.clear();
+
+	if (!myTrie.isEmpty() && !ZLFile(CacheDirectory()).directory(true).isNull()) {
+		myTrie.save(cachePath, cacheKey);
+	}
 }
 
 void ZLTextTeXHyphenator::unload() {
@@ -166,6 +157,9 @@ void ZLTextTeXHyphenator::unload() {
 		delete *it;
 	}
 	myPatternTable.clear();
+	myTrie.clear();
+	myMaskCache.clear();
+	myMaskCacheIndex.clear();
 }
 
 const std::string &ZLTextTeXHyphenator::language() const {
@@ -22,37 +22,34 @@
 
 #include <vector>
 #include <string>
+#include <list>
+#include <map>
 
 #include "ZLTextHyphenator.h"
+#include "ZLTextHyphenationTrie.h"
 
 class ZLTextTeXHyphenationPattern {
 
 public:
-	ZLTextTeXHyphenationPattern(ZLUnicodeUtil::Ucs4Char *ucs4String, int length);
 	ZLTextTeXHyphenationPattern(const std::string &utf8String);
 	~ZLTextTeXHyphenationPattern();
 
 	int length() const { return myLength; }
-	void apply(unsigned char *values) const;
 
 private:
 	int myLength;
 	ZLUnicodeUtil::Ucs4Char *mySymbols;
 	unsigned char *myValues;
 
-friend class ZLTextTeXPatternComparator;
-};
-
-class ZLTextTeXPatternComparator {
-
-public:
-	bool operator () (const ZLTextTeXHyphenationPattern *p1, const ZLTextTeXHyphenationPattern *p2) const;
+friend class ZLTextHyphenationTrie;
 };
 
 class ZLTextTeXHyphenator : public ZLTextHyphenator {
 
 private:
 	static const std::string PatternZip();
+	static const std::string CacheDirectory();
+	static const size_t MASK_CACHE_SIZE = 4096;
 
 public:
 	~ZLTextTeXHyphenator();
@@ -66,10 +63,16 @@ protected:
 
 private:
 	typedef std::vector<ZLTextTeXHyphenationPattern*>::const_iterator PatternIterator;
+	typedef std::pair<ZLUnicodeUtil::Ucs4String,std::vector<unsigned char> > MaskCacheEntry;
 
 	std::vector<ZLTextTeXHyphenationPattern*> myPatternTable;
+	ZLTextHyphenationTrie myTrie;
 	std::string myLanguage;
 
+	// most recently used words are at the front of the list
+	mutable std::list<MaskCacheEntry> myMaskCache;
+	mutable std::map<ZLUnicodeUtil::Ucs4String,std::list<MaskCacheEntry>::iterator> myMaskCacheIndex;
+
 friend class ZLTextHyphenationReader;
 };
 
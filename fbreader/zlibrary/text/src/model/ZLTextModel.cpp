@@ -19,13 +19,17 @@
 
 #include <cstring>
 #include <algorithm>
+#include <map>
 
 #include <ZLibrary.h>
 #include <ZLSearchUtil.h>
 #include <ZLLanguageUtil.h>
+#include <ZLOutputStream.h>
+#include <ZLFileMapping.h>
 
 #include "ZLTextModel.h"
 #include "ZLTextParagraph.h"
+#include "ZLTextSearchIndex.h"
 
 ZLTextModel::ZLTextModel(const std::string &language, const size_t rowSize) : myLanguage(language.empty() ? ZLibrary::Language() : language), myAllocator(rowSize), myLastEntryStart(0) {
 }
@@ -48,26 +52,44 @@ void ZLTextModel::search(const std::string &text, size_t startIndex, size_t endI
 	ZLSearchPattern pattern(text, ignoreCase);
 	myMarks.clear();
 
-	std::vector<ZLTextParagraph*>::const_iterator start =
-		(startIndex < myParagraphs.size()) ? myParagraphs.begin() + startIndex : myParagraphs.end();
-	std::vector<ZLTextParagraph*>::const_iterator end =
-		(endIndex < myParagraphs.size()) ? myParagraphs.begin() + endIndex : myParagraphs.end();
-	for (std::vector<ZLTextParagraph*>::const_iterator it = start; it < end; ++it) {
-		int offset = 0;
-		for (ZLTextParagraph::Iterator jt = **it; !jt.isEnd(); jt.next()) {
-			if (jt.entryKind() == ZLTextParagraphEntry::TEXT_ENTRY) {
-				const ZLTextEntry& textEntry = (ZLTextEntry&)*jt.entry();
-				const char *str = textEntry.data();
-				const size_t len = textEntry.dataLength();
-				for (int pos = ZLSearchUtil::find(str, len, pattern); pos != -1; pos = ZLSearchUtil::find(str, len, pattern, pos + 1)) {
-					myMarks.push_back(ZLTextMark(it - myParagraphs.begin(), offset + pos, pattern.length()));
-				}
-				offset += len;
+	startIndex = std::min(startIndex, myParagraphs.size());
+	endIndex = std::min(endIndex, myParagraphs.size());
+
+	buildSearchIndex();
+	std::vector<std::pair<size_t,size_t> > ranges;
+	if (!mySearchIndex->candidates(pattern, startIndex, endIndex, ranges)) {
+		ranges.push_back(std::make_pair(startIndex, endIndex));
+	}
+
+	for (std::vector<std::pair<size_t,size_t> >::const_iterator it = ranges.begin(); it != ranges.end(); ++it) {
+		for (size_t index = it->first; index < it->second; ++index) {
+			searchInParagraph(index, pattern);
+		}
+	}
+}
+
+void ZLTextModel::searchInParagraph(size_t index, const ZLSearchPattern &pattern) const {
+	int offset = 0;
+	for (ZLTextParagraph::Iterator it = *myParagraphs[index]; !it.isEnd(); it.next()) {
+		if (it.entryKind() == ZLTextParagraphEntry::TEXT_ENTRY) {
+			const ZLTextEntry& textEntry = (ZLTextEntry&)*it.entry();
+			const char *str = textEntry.data();
+			const size_t len = textEntry.dataLength();
+			size_t matchLength;
+			for (int pos = ZLSearchUtil::find(str, len, pattern, 0, matchLength); pos != -1; pos = ZLSearchUtil::find(str, len, pattern, pos + 1, matchLength)) {
+				myMarks.push_back(ZLTextMark(index, offset + pos, matchLength));
 			}
+			offset += len;
 		}
 	}
 }
 
+void ZLTextModel::buildSearchIndex() const {
+	if (mySearchIndex.isNull()) {
+		mySearchIndex = new ZLTextSearchIndex(*this);
+	}
+}
+
 void ZLTextModel::selectParagraph(size_t index) const {
 	if (index < paragraphsNumber()) {
 		myMarks.push_back(ZLTextMark(index, 0, (*this)[index]->textDataLength()));
@@ -116,6 +138,7 @@ ZLTextTreeModel::~ZLTextTreeModel() {
 void ZLTextModel::addParagraphInternal(ZLTextParagraph *paragraph) {
 	myParagraphs.push_back(paragraph);
 	myLastEntryStart = 0;
+	mySearchIndex.reset();
 }
 
 ZLTextTreeParagraph *ZLTextTreeModel::createParagraph(ZLTextTreeParagraph *parent) {
@@ -150,6 +173,7 @@ void ZLTextPlainModel::createParagraph(ZLTextParagraph::Kind kind) {
 }
 
 void ZLTextModel::addText(const std::string &text) {
+	mySearchIndex.reset();
 	size_t len = text.length();
 	if ((myLastEntryStart != 0) && (*myLastEntryStart == ZLTextParagraphEntry::TEXT_ENTRY)) {
 		size_t oldLen = 0;
@@ -171,6 +195,7 @@ void ZLTextModel::addText(const std::vector<std::string> &text) {
 	if (text.size() == 0) {
 		return;
 	}
+	mySearchIndex.reset();
 	size_t len = 0;
 	for (std::vector<std::string>::const_iterator it = text.begin(); it != text.end(); ++it) {
 		len += it->length();
@@ -267,3 +292,109 @@ void ZLTextModel::addBidiReset() {
 	*myLastEntryStart = ZLTextParagraphEntry::RESET_BIDI_ENTRY;
 	myParagraphs.back()->addEntry(myLastEntryStart);
 }
+
+struct ZLTextParagraphRecord {
+	unsigned char Kind;
+	unsigned char IsOpen;
+	int Parent;
+	size_t EntryNumber;
+	size_t Row;
+	size_t Offset;
+};
+
+void ZLTextModel::writeCache(ZLOutputStream &stream) const {
+	const unsigned char modelKind = kind();
+	stream.write((const char*)&modelKind, 1);
+	myAllocator.write(stream);
+
+	std::map<const ZLTextParagraph*,int> indices;
+	const size_t paragraphsNumber = myParagraphs.size();
+	stream.write((const char*)&paragraphsNumber, sizeof(size_t));
+	for (size_t i = 0; i < paragraphsNumber; ++i) {
+		const ZLTextParagraph &paragraph = *myParagraphs[i];
+		ZLTextParagraphRecord record;
+		memset(&record, 0, sizeof(ZLTextParagraphRecord));
+		record.Kind = paragraph.kind();
+		record.Parent = -1;
+		if (record.Kind == ZLTextParagraph::TREE_PARAGRAPH) {
+			const ZLTextTreeParagraph &treeParagraph = (const ZLTextTreeParagraph&)paragraph;
+			indices[&paragraph] = i;
+			record.IsOpen = treeParagraph.isOpen() ? 1 : 0;
+			std::map<const ZLTextParagraph*,int>::const_iterator it = indices.find(treeParagraph.parent());
+			if (it != indices.end()) {
+				record.Parent = it->second;
+			}
+		}
+		record.EntryNumber = paragraph.myEntryNumber;
+		if ((record.EntryNumber == 0) ||
+				!myAllocator.locate(paragraph.myFirstEntryAddress, record.Row, record.Offset)) {
+			record.EntryNumber = 0;
+			record.Row = (size_t)-1;
+			record.Offset = (size_t)-1;
+		}
+		stream.write((const char*)&record, sizeof(ZLTextParagraphRecord));
+	}
+}
+
+bool ZLTextModel::readCache(shared_ptr<ZLFileMapping> mapping, const char *&ptr, const ZLImageMap &imageMap) {
+	if (mapping.isNull() || !myParagraphs.empty()) {
+		return false;
+	}
+	const char *end = mapping->data() + mapping->size();
+	if ((ptr >= end) || (*ptr != kind())) {
+		return false;
+	}
+	++ptr;
+	if (!myAllocator.read(mapping, ptr)) {
+		return false;
+	}
+
+	size_t paragraphsNumber;
+	if ((size_t)(end - ptr) < sizeof(size_t)) {
+		return false;
+	}
+	memcpy(&paragraphsNumber, ptr, sizeof(size_t));
+	ptr += sizeof(size_t);
+	if (paragraphsNumber > (size_t)(end - ptr) / sizeof(ZLTextParagraphRecord)) {
+		return false;
+	}
+	myParagraphs.reserve(paragraphsNumber);
+	for (size_t i = 0; i < paragraphsNumber; ++i) {
+		ZLTextParagraphRecord record;
+		memcpy(&record, ptr, sizeof(ZLTextParagraphRecord));
+		ptr += sizeof(ZLTextParagraphRecord);
+
+		if (kind() == TREE_MODEL) {
+			if ((record.Kind != ZLTextParagraph::TREE_PARAGRAPH) ||
+					(record.Parent < -1) || (record.Parent >= (int)i)) {
+				return false;
+			}
+			ZLTextTreeParagraph *parent =
+				(record.Parent == -1) ? 0 : (ZLTextTreeParagraph*)myParagraphs[record.Parent];
+			((ZLTextTreeModel*)this)->createParagraph(parent)->open(record.IsOpen != 0);
+		} else {
+			if ((record.Kind == ZLTextParagraph::TREE_PARAGRAPH) ||
+					(record.Kind > ZLTextParagraph::END_OF_TEXT_PARAGRAPH)) {
+				return false;
+			}
+			((ZLTextPlainModel*)this)->createParagraph((ZLTextParagraph::Kind)record.Kind);
+		}
+
+		if (record.EntryNumber > 0) {
+			ZLTextParagraph &paragraph = *myParagraphs.back();
+			paragraph.myFirstEntryAddress = myAllocator.address(record.Row, record.Offset);
+			if (paragraph.myFirstEntryAddress == 0) {
+				return false;
+			}
+			paragraph.myEntryNumber = record.EntryNumber;
+			const ZLImageMap *imageMapAddress = &imageMap;
+			for (ZLTextParagraph::Iterator it = paragraph; !it.isEnd(); it.next()) {
+				if (it.entryKind() == ZLTextParagraphEntry::IMAGE_ENTRY) {
+					memcpy(it.myPointer + 1, &imageMapAddress, sizeof(const ZLImageMap*));
+				}
+			}
+		}
+	}
+	myLastEntryStart = 0;
+	return true;
+}
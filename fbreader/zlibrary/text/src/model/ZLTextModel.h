@@ -24,6 +24,8 @@
 #include <string>
 #include <algorithm>
 
+#include <shared_ptr.h>
+
 #include <ZLTextParagraph.h>
 #include <ZLTextKind.h>
 #include <ZLTextMark.h>
@@ -31,6 +33,10 @@
 
 class ZLTextParagraph;
 class ZLTextTreeParagraph;
+class ZLTextSearchIndex;
+class ZLSearchPattern;
+class ZLOutputStream;
+class ZLFileMapping;
 
 class ZLTextModel {
 	
@@ -58,6 +64,7 @@ public:
 	virtual void search(const std::string &text, size_t startIndex, size_t endIndex, bool ignoreCase) const;
 	virtual void selectParagraph(size_t index) const;
 	void removeAllMarks();
+	void buildSearchIndex() const;
 
 	ZLTextMark firstMark() const;
 	ZLTextMark lastMark() const;
@@ -73,14 +80,24 @@ public:
 	void addFixedHSpace(unsigned char length);
 	void addBidiReset();
 
+	// writes paragraphs and entries in a form that can be used
+	// without parsing by readCache on an empty model of the same kind;
+	// entry rows are not copied, they refer to the mapping directly
+	void writeCache(ZLOutputStream &stream) const;
+	bool readCache(shared_ptr<ZLFileMapping> mapping, const char *&ptr, const ZLImageMap &imageMap);
+
 protected:
 	void addParagraphInternal(ZLTextParagraph *paragraph);
+
+private:
+	void searchInParagraph(size_t index, const ZLSearchPattern &pattern) const;
 	
 private:
 	const std::string myLanguage;
 	std::vector<ZLTextParagraph*> myParagraphs;
 	mutable std::vector<ZLTextMark> myMarks;
 	mutable ZLTextRowMemoryAllocator myAllocator;
+	mutable shared_ptr<ZLTextSearchIndex> mySearchIndex;
 
 	char *myLastEntryStart;
 
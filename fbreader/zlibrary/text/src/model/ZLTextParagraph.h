@@ -249,6 +249,8 @@ public:
 		size_t myIndex;
 		size_t myEndIndex;
 		mutable shared_ptr<ZLTextParagraphEntry> myEntry;
+
+	friend class ZLTextModel;
 	};
 
 	enum Kind {
@@ -21,8 +21,13 @@
 
 #include <algorithm>
 
+#include <ZLOutputStream.h>
+#include <ZLFileMapping.h>
+
 #include "ZLTextRowMemoryAllocator.h"
 
+static const size_t NO_TERMINATOR = (size_t)-1;
+
 ZLTextRowMemoryAllocator::ZLTextRowMemoryAllocator(const size_t rowSize) : myRowSize(rowSize), myOffset(0) {
 }
 
@@ -36,12 +41,19 @@ char *ZLTextRowMemoryAllocator::allocate(size_t size) {
 	if (myPool.empty()) {
 		myCurrentRowSize = std::max(myRowSize, size + 1 + sizeof(char*));
 		myPool.push_back(new char[myCurrentRowSize]);
+		myRows.push_back(myPool.back());
+		myRowSizes.push_back(myCurrentRowSize);
+		myTerminators.push_back(NO_TERMINATOR);
 	} else if (myOffset + size + 1 + sizeof(char*) > myRowSize) {
 		myCurrentRowSize = std::max(myRowSize, size + 1 + sizeof(char*));
 		char *row = new char[myCurrentRowSize];
 		*(myPool.back() + myOffset) = 0;
 		memcpy(myPool.back() + myOffset + 1, &row, sizeof(char*));
+		finishRow(myOffset);
 		myPool.push_back(row);
+		myRows.push_back(row);
+		myRowSizes.push_back(myCurrentRowSize);
+		myTerminators.push_back(NO_TERMINATOR);
 		myOffset = 0;
 	}
 	char *ptr = myPool.back() + myOffset;
@@ -59,8 +71,98 @@ char *ZLTextRowMemoryAllocator::reallocateLast(char *ptr, size_t newSize) {
 		memcpy(row, ptr, myOffset - (ptr - myPool.back()));
 		*ptr = 0;
 		memcpy(ptr + 1, &row, sizeof(char*));
+		finishRow(ptr - myPool.back());
 		myPool.push_back(row);
+		myRows.push_back(row);
+		myRowSizes.push_back(myCurrentRowSize);
+		myTerminators.push_back(NO_TERMINATOR);
 		myOffset = newSize;
 		return row;
 	}
 }
+
+void ZLTextRowMemoryAllocator::finishRow(size_t terminatorOffset) {
+	myTerminators.back() = terminatorOffset;
+}
+
+void ZLTextRowMemoryAllocator::write(ZLOutputStream &stream) const {
+	const size_t rowsNumber = myRows.size();
+	stream.write((const char*)&rowsNumber, sizeof(size_t));
+	for (size_t i = 0; i < rowsNumber; ++i) {
+		size_t length;
+		if (myTerminators[i] != NO_TERMINATOR) {
+			length = myTerminators[i] + 1 + sizeof(char*);
+		} else if ((i + 1 == rowsNumber) && !myPool.empty()) {
+			length = myOffset;
+		} else {
+			length = myRowSizes[i];
+		}
+		stream.write((const char*)&length, sizeof(size_t));
+		stream.write((const char*)&myTerminators[i], sizeof(size_t));
+		stream.write(myRows[i], length);
+	}
+}
+
+bool ZLTextRowMemoryAllocator::read(shared_ptr<ZLFileMapping> mapping, const char *&ptr) {
+	if (!myRows.empty() || mapping.isNull()) {
+		return false;
+	}
+	const char *end = mapping->data() + mapping->size();
+	size_t rowsNumber;
+	if ((size_t)(end - ptr) < sizeof(size_t)) {
+		return false;
+	}
+	memcpy(&rowsNumber, ptr, sizeof(size_t));
+	ptr += sizeof(size_t);
+
+	std::vector<char*> rows;
+	std::vector<size_t> rowSizes;
+	std::vector<size_t> terminators;
+	for (size_t i = 0; i < rowsNumber; ++i) {
+		size_t length;
+		size_t terminator;
+		if ((size_t)(end - ptr) < 2 * sizeof(size_t)) {
+			return false;
+		}
+		memcpy(&length, ptr, sizeof(size_t));
+		memcpy(&terminator, ptr + sizeof(size_t), sizeof(size_t));
+		ptr += 2 * sizeof(size_t);
+		if ((length > (size_t)(end - ptr)) ||
+				((terminator != NO_TERMINATOR) && (terminator + 1 + sizeof(char*) != length))) {
+			return false;
+		}
+		rows.push_back((char*)ptr);
+		rowSizes.push_back(length);
+		terminators.push_back(terminator);
+		ptr += length;
+	}
+
+	for (size_t i = 0; i < rowsNumber; ++i) {
+		if (terminators[i] != NO_TERMINATOR) {
+			char *next = (i + 1 < rowsNumber) ? rows[i + 1] : 0;
+			memcpy(rows[i] + terminators[i] + 1, &next, sizeof(char*));
+		}
+	}
+
+	myRows.swap(rows);
+	myRowSizes.swap(rowSizes);
+	myTerminators.swap(terminators);
+	myMapping = mapping;
+	return true;
+}
+
+bool ZLTextRowMemoryAllocator::locate(const char *address, size_t &row, size_t &offset) const {
+	for (size_t i = myRows.size(); i > 0; --i) {
+		const char *start = myRows[i - 1];
+		if ((address >= start) && (address < start + myRowSizes[i - 1])) {
+			row = i - 1;
+			offset = address - start;
+			return true;
+		}
+	}
+	return false;
+}
+
+char *ZLTextRowMemoryAllocator::address(size_t row, size_t offset) const {
+	return ((row < myRows.size()) && (offset < myRowSizes[row])) ? myRows[row] + offset : 0;
+}
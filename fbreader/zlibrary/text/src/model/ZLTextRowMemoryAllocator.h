@@ -22,6 +22,11 @@
 
 #include <vector>
 
+#include <shared_ptr.h>
+
+class ZLOutputStream;
+class ZLFileMapping;
+
 class ZLTextRowMemoryAllocator {
 
 public:
@@ -31,12 +36,29 @@ public:
 	char *allocate(size_t size);
 	char *reallocateLast(char *ptr, size_t newSize);
 
+	// Rows are written as is; the only absolute addresses inside them,
+	// links from a filled row to the next one, are fixed when the rows
+	// are read back from a (writable, private) file mapping.
+	void write(ZLOutputStream &stream) const;
+	bool read(shared_ptr<ZLFileMapping> mapping, const char *&ptr);
+	bool locate(const char *address, size_t &row, size_t &offset) const;
+	char *address(size_t row, size_t offset) const;
+
+private:
+	void finishRow(size_t terminatorOffset);
+
 private:
 	const size_t myRowSize;
 	size_t myCurrentRowSize;
 	std::vector<char*> myPool;
 	size_t myOffset;
 
+	// rows taken from the mapping come first, then rows from myPool
+	std::vector<char*> myRows;
+	std::vector<size_t> myRowSizes;
+	std::vector<size_t> myTerminators;
+	shared_ptr<ZLFileMapping> myMapping;
+
 private: // disable copying
 	ZLTextRowMemoryAllocator(const ZLTextRowMemoryAllocator&);
 	const ZLTextRowMemoryAllocator &operator = (const ZLTextRowMemoryAllocator&);
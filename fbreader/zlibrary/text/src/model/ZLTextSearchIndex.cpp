@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <ZLSearchUtil.h>
+#include <ZLUnicodeUtil.h>
+
+#include "ZLTextSearchIndex.h"
+#include "ZLTextModel.h"
+#include "ZLTextParagraph.h"
+
+ZLTextSearchIndex::ZLTextSearchIndex(const ZLTextModel &model) {
+	const size_t paragraphsNumber = model.paragraphsNumber();
+	size_t blockSize = 0;
+	for (size_t i = 0; i < paragraphsNumber; ++i) {
+		if (myBlockStarts.empty() || (blockSize >= BLOCK_SIZE)) {
+			myBlockStarts.push_back(i);
+			myBits.resize(myBits.size() + WORDS_PER_BLOCK, 0);
+			blockSize = 0;
+		}
+		const size_t block = myBlockStarts.size() - 1;
+		for (ZLTextParagraph::Iterator it = *model[i]; !it.isEnd(); it.next()) {
+			if (it.entryKind() == ZLTextParagraphEntry::TEXT_ENTRY) {
+				const ZLTextEntry &textEntry = (ZLTextEntry&)*it.entry();
+				const char *str = textEntry.data();
+				const size_t len = textEntry.dataLength();
+				if (len >= 3) {
+					const char *last = str + len - 3;
+					for (const char *ptr = str; ptr <= last; ++ptr) {
+						setBit(block, key(ptr));
+					}
+				}
+				blockSize += len;
+			}
+		}
+	}
+	myBlockStarts.push_back(paragraphsNumber);
+}
+
+bool ZLTextSearchIndex::candidates(const ZLSearchPattern &pattern, size_t startIndex, size_t endIndex, std::vector<std::pair<size_t,size_t> > &ranges) const {
+	const std::string &lowerPattern = pattern.lowerCasePattern();
+	const std::string &upperPattern = pattern.upperCasePattern();
+	const size_t len = lowerPattern.length();
+	if (len < 3) {
+		return false;
+	}
+
+	// in ignore case mode every pattern character matches either its lower
+	// or its upper case variant; a text byte is known in advance only if
+	// both variants of all previous characters have the same length and
+	// both variants of the byte itself fold to the same value
+	std::vector<bool> determined(len, true);
+	if (pattern.ignoreCase()) {
+		size_t offset = 0;
+		bool aligned = true;
+		while (offset < len) {
+			ZLUnicodeUtil::Ucs4Char ch;
+			const size_t lowerLength = ZLUnicodeUtil::firstChar(ch, lowerPattern.data() + offset);
+			const size_t upperLength =
+				(offset < upperPattern.length()) ?
+					ZLUnicodeUtil::firstChar(ch, upperPattern.data() + offset) : 0;
+			aligned = aligned && (lowerLength == upperLength);
+			for (size_t i = offset; (i < offset + lowerLength) && (i < len); ++i) {
+				determined[i] = aligned && (fold(lowerPattern[i]) == fold(upperPattern[i]));
+			}
+			offset += lowerLength;
+		}
+	}
+
+	std::vector<size_t> keys;
+	for (size_t i = 0; i + 3 <= len; ++i) {
+		if (determined[i] && determined[i + 1] && determined[i + 2]) {
+			keys.push_back(key(lowerPattern.data() + i));
+		}
+	}
+	if (keys.empty()) {
+		return false;
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	const size_t blocksNumber = myBlockStarts.size() - 1;
+	for (size_t block = 0; block < blocksNumber; ++block) {
+		const size_t start = std::max(myBlockStarts[block], startIndex);
+		const size_t end = std::min(myBlockStarts[block + 1], endIndex);
+		if (start >= end) {
+			continue;
+		}
+		std::vector<size_t>::const_iterator it = keys.begin();
+		for (; it != keys.end(); ++it) {
+			if (!bit(block, *it)) {
+				break;
+			}
+		}
+		if (it != keys.end()) {
+			continue;
+		}
+		if (!ranges.empty() && (ranges.back().second == start)) {
+			ranges.back().second = end;
+		} else {
+			ranges.push_back(std::make_pair(start, end));
+		}
+	}
+	return true;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLTEXTSEARCHINDEX_H__
+#define __ZLTEXTSEARCHINDEX_H__
+
+#include <vector>
+#include <string>
+
+class ZLTextModel;
+class ZLSearchPattern;
+
+/*
+ * Trigram filter over a text model. Paragraphs are grouped into blocks
+ * of about BLOCK_SIZE bytes of text; for every block we keep a bitset of
+ * hashed (ASCII case folded) trigrams occuring inside its text entries.
+ * The index never produces false negatives, so any paragraph it rejects
+ * cannot contain a match; accepted paragraphs still have to be verified.
+ */
+class ZLTextSearchIndex {
+
+private:
+	static const size_t BLOCK_SIZE = 8192;
+	static const size_t HASH_BITS = 13;
+	static const size_t BUCKETS_NUMBER = 1 << HASH_BITS;
+	static const size_t WORDS_PER_BLOCK = BUCKETS_NUMBER / (8 * sizeof(unsigned long));
+
+public:
+	ZLTextSearchIndex(const ZLTextModel &model);
+
+	// returns false if the pattern has no trigram usable for filtering;
+	// otherwise fills ranges with [start, end) paragraph index pairs to verify
+	bool candidates(const ZLSearchPattern &pattern, size_t startIndex, size_t endIndex, std::vector<std::pair<size_t,size_t> > &ranges) const;
+
+private:
+	static unsigned char fold(unsigned char c);
+	static size_t key(const char *ptr);
+
+	void setBit(size_t block, size_t bucket);
+	bool bit(size_t block, size_t bucket) const;
+
+private:
+	std::vector<size_t> myBlockStarts;
+	std::vector<unsigned long> myBits;
+
+private: // disable copying
+	ZLTextSearchIndex(const ZLTextSearchIndex&);
+	const ZLTextSearchIndex &operator = (const ZLTextSearchIndex&);
+};
+
+inline unsigned char ZLTextSearchIndex::fold(unsigned char c) {
+	return ((c >= 'A') && (c <= 'Z')) ? c + ('a' - 'A') : c;
+}
+
+inline size_t ZLTextSearchIndex::key(const char *ptr) {
+	const unsigned int k =
+		(fold(ptr[0]) << 16) | (fold(ptr[1]) << 8) | fold(ptr[2]);
+	return ((k * 2654435761U) & 0xFFFFFFFFU) >> (32 - HASH_BITS);
+}
+
+inline void ZLTextSearchIndex::setBit(size_t block, size_t bucket) {
+	const size_t bitsPerWord = 8 * sizeof(unsigned long);
+	myBits[block * WORDS_PER_BLOCK + bucket / bitsPerWord] |= 1UL << (bucket % bitsPerWord);
+}
+
+inline bool ZLTextSearchIndex::bit(size_t block, size_t bucket) const {
+	const size_t bitsPerWord = 8 * sizeof(unsigned long);
+	return (myBits[block * WORDS_PER_BLOCK + bucket / bitsPerWord] >> (bucket % bitsPerWord)) & 1;
+}
+
+#endif /* __ZLTEXTSEARCHINDEX_H__ */
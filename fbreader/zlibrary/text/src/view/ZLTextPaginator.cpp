@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <ZLTime.h>
+
+#include <ZLTextModel.h>
+
+#include "ZLTextPaginator.h"
+#include "ZLTextView.h"
+
+static const long TIME_SLICE = 40;
+
+ZLTextPaginator::ZLTextPaginator(ZLTextView &view) : myView(view), myController(view.context(), view), myIsComplete(false), myIsScheduled(false) {
+}
+
+bool ZLTextPaginator::reset() {
+	myPageStarts.clear();
+	myIsComplete = false;
+
+	const ZLTextArea &viewArea = myView.textArea();
+	shared_ptr<ZLTextModel> model = viewArea.model();
+	if (model.isNull() || (model->kind() == ZLTextModel::TREE_MODEL) ||
+			(viewArea.width() == 0) || (viewArea.height() == 0)) {
+		myController.setModel(0);
+		return false;
+	}
+
+	myController.setModel(model);
+	myController.area().setSize(viewArea.width(), viewArea.height());
+	return !myController.area().isEmpty();
+}
+
+bool ZLTextPaginator::addPage() {
+	if (!myPageStarts.empty()) {
+		myController.scrollPage(true, ZLTextAreaController::NO_OVERLAPPING, 0);
+	}
+	myController.preparePaintInfo();
+
+	const ZLTextWordCursor &startCursor = myController.area().startCursor();
+	const ZLTextWordCursor &endCursor = myController.area().endCursor();
+	if (startCursor.isNull() || endCursor.isNull()) {
+		return false;
+	}
+	const Position start(startCursor);
+	if (!myPageStarts.empty() && !(myPageStarts.back() < start)) {
+		return false;
+	}
+	myPageStarts.push_back(start);
+	return !endCursor.isEndOfParagraph() || !endCursor.paragraphCursor().isLast();
+}
+
+void ZLTextPaginator::run() {
+	if (myIsComplete) {
+		return;
+	}
+
+	const ZLTime start;
+	while (ZLTime().millisecondsFrom(start) < TIME_SLICE) {
+		if (!addPage()) {
+			myIsComplete = true;
+			break;
+		}
+	}
+	ZLTextParagraphCursorCache::cleanup();
+
+	if (myIsComplete) {
+		myController.setModel(0);
+		myView.onPaginationFinished();
+	}
+}
+
+size_t ZLTextPaginator::pagesBefore(size_t paragraphIndex) const {
+	return std::lower_bound(myPageStarts.begin(), myPageStarts.end(), Position(paragraphIndex, 0, 0)) - myPageStarts.begin();
+}
+
+size_t ZLTextPaginator::pagesUpTo(const ZLTextWordCursor &cursor) const {
+	return std::upper_bound(myPageStarts.begin(), myPageStarts.end(), Position(cursor)) - myPageStarts.begin();
+}
+
+void ZLTextPaginator::pageStart(size_t pageIndex, int &paragraphIndex, int &elementIndex, int &charIndex) const {
+	if (myPageStarts.empty()) {
+		paragraphIndex = 0;
+		elementIndex = 0;
+		charIndex = 0;
+		return;
+	}
+	const Position &position = myPageStarts[std::min(pageIndex, myPageStarts.size() - 1)];
+	paragraphIndex = position.ParagraphIndex;
+	elementIndex = position.ElementIndex;
+	charIndex = position.CharIndex;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLTEXTPAGINATOR_H__
+#define __ZLTEXTPAGINATOR_H__
+
+#include <vector>
+
+#include <ZLRunnable.h>
+
+#include <ZLTextParagraphCursor.h>
+
+#include "../area/ZLTextAreaController.h"
+
+class ZLTextView;
+
+/*
+ * Splits the text of a view into pages exactly as the view shows them when
+ * scrolling forward page by page. Layout is done by a private area sharing
+ * the paint context, style and size of the view; to keep the UI responsive
+ * it runs as a periodic task laying out a few pages per time slice.
+ */
+class ZLTextPaginator : public ZLRunnable {
+
+public:
+	ZLTextPaginator(ZLTextView &view);
+
+	// returns false if there is nothing to paginate
+	bool reset();
+	bool isComplete() const;
+	bool isScheduled() const;
+	void setScheduled(bool scheduled);
+
+	size_t pagesNumber() const;
+	// number of pages starting before given paragraph
+	size_t pagesBefore(size_t paragraphIndex) const;
+	// number of pages starting at or before given cursor
+	size_t pagesUpTo(const ZLTextWordCursor &cursor) const;
+	void pageStart(size_t pageIndex, int &paragraphIndex, int &elementIndex, int &charIndex) const;
+
+private:
+	void run();
+	bool addPage();
+
+private:
+	struct Position {
+		Position(size_t paragraphIndex, unsigned int elementIndex, unsigned int charIndex);
+		Position(const ZLTextWordCursor &cursor);
+		bool operator < (const Position &position) const;
+
+		unsigned int ParagraphIndex;
+		unsigned int ElementIndex;
+		unsigned int CharIndex;
+	};
+
+	ZLTextView &myView;
+	ZLTextAreaController myController;
+	std::vector<Position> myPageStarts;
+	bool myIsComplete;
+	bool myIsScheduled;
+};
+
+inline bool ZLTextPaginator::isComplete() const { return myIsComplete; }
+inline bool ZLTextPaginator::isScheduled() const { return myIsScheduled; }
+inline void ZLTextPaginator::setScheduled(bool scheduled) { myIsScheduled = scheduled; }
+inline size_t ZLTextPaginator::pagesNumber() const { return myPageStarts.size(); }
+
+inline ZLTextPaginator::Position::Position(size_t paragraphIndex, unsigned int elementIndex, unsigned int charIndex) : ParagraphIndex(paragraphIndex), ElementIndex(elementIndex), CharIndex(charIndex) {}
+inline ZLTextPaginator::Position::Position(const ZLTextWordCursor &cursor) : ParagraphIndex(cursor.paragraphCursor().index()), ElementIndex(cursor.elementIndex()), CharIndex(cursor.charIndex()) {}
+inline bool ZLTextPaginator::Position::operator < (const Position &position) const {
+	if (ParagraphIndex != position.ParagraphIndex) {
+		return ParagraphIndex < position.ParagraphIndex;
+	}
+	if (ElementIndex != position.ElementIndex) {
+		return ElementIndex < position.ElementIndex;
+	}
+	return CharIndex < position.CharIndex;
+}
+
+#endif /* __ZLTEXTPAGINATOR_H__ */
@@ -80,7 +80,7 @@ const ZLTextView &ZLTextView::PositionIndicator::textView() const {
 }
 
 ZLPaintContext &ZLTextView::PositionIndicator::context() const {
-	return myTextView.textArea().context();
+	return myTextView.paintedArea().context();
 }
 
 int ZLTextView::PositionIndicator::bottom() const {
@@ -92,11 +92,11 @@ int ZLTextView::PositionIndicator::top() const {
 }
 
 int ZLTextView::PositionIndicator::left() const {
-	return myTextView.textArea().hOffset();
+	return myTextView.paintedArea().hOffset();
 }
 
 int ZLTextView::PositionIndicator::right() const {
-	return myTextView.textArea().hOffset() + myTextView.textArea().width() - myExtraWidth - 1;
+	return myTextView.paintedArea().hOffset() + myTextView.paintedArea().width() - myExtraWidth - 1;
 }
 
 const std::vector<size_t> &ZLTextView::PositionIndicator::textSize() const {
@@ -110,7 +110,7 @@ size_t ZLTextView::PositionIndicator::startTextIndex() const {
 
 size_t ZLTextView::PositionIndicator::endTextIndex() const {
 	std::vector<size_t>::const_iterator i = myTextView.nextBreakIterator();
-	return (i != myTextView.myTextBreaks.end()) ? *i : myTextView.textArea().model()->paragraphsNumber();
+	return (i != myTextView.myTextBreaks.end()) ? *i : myTextView.paintedArea().model()->paragraphsNumber();
 }
 
 void ZLTextView::PositionIndicator::drawExtraText(const std::string &text) {
@@ -123,13 +123,13 @@ void ZLTextView::PositionIndicator::drawExtraText(const std::string &text) {
 }
 
 size_t ZLTextView::PositionIndicator::sizeOfTextBeforeParagraph(size_t paragraphIndex) const {
-	if (myTextView.textArea().model()->kind() == ZLTextModel::TREE_MODEL) {
-		ZLTextWordCursor cursor = myTextView.textArea().startCursor();
+	if (myTextView.paintedArea().model()->kind() == ZLTextModel::TREE_MODEL) {
+		ZLTextWordCursor cursor = myTextView.paintedArea().startCursor();
 		if (cursor.isNull()) {
-			cursor = myTextView.textArea().endCursor();
+			cursor = myTextView.paintedArea().endCursor();
 		}
 		if (!cursor.isNull()) {
-			const ZLTextTreeModel &treeModel = (const ZLTextTreeModel&)*myTextView.textArea().model();
+			const ZLTextTreeModel &treeModel = (const ZLTextTreeModel&)*myTextView.paintedArea().model();
 			size_t sum = 0;
 			for (size_t i = 0; i < paragraphIndex; ++i) {
 				const ZLTextTreeParagraph *para = (const ZLTextTreeParagraph*)treeModel[i];
@@ -162,7 +162,13 @@ size_t ZLTextView::PositionIndicator::sizeOfTextBeforeCursor(const ZLTextWordCur
 
 std::string ZLTextView::PositionIndicator::textPositionString() const {
 	std::string buffer;
-	ZLStringUtil::appendNumber(buffer, 1 + sizeOfTextBeforeCursor(myTextView.textArea().endCursor()) / 2048);
+	if (myTextView.completePaginator() != 0) {
+		ZLStringUtil::appendNumber(buffer, myTextView.pageIndex());
+		buffer += '/';
+		ZLStringUtil::appendNumber(buffer, myTextView.pageNumber());
+		return buffer;
+	}
+	ZLStringUtil::appendNumber(buffer, 1 + sizeOfTextBeforeCursor(myTextView.paintedArea().endCursor()) / 2048);
 	buffer += '/';
 	ZLStringUtil::appendNumber(buffer, 1 + sizeOfTextBeforeParagraph(endTextIndex()) / 2048);
 
@@ -173,7 +179,7 @@ std::string ZLTextView::PositionIndicator::textPositionString() const {
 
 	const std::vector<size_t> &textSizeVector = myTextView.myTextSize;
 	const size_t fullTextSize = textSizeVector[endTextIndex()] - textSizeVector[startTextIndex()];
-	ZLStringUtil::appendNumber(buffer, 100 * sizeOfTextBeforeCursor(myTextView.textArea().endCursor()) / fullTextSize);
+	ZLStringUtil::appendNumber(buffer, 100 * sizeOfTextBeforeCursor(myTextView.paintedArea().endCursor()) / fullTextSize);
 
 	return buffer + '%';
 	*/
@@ -198,7 +204,7 @@ std::string ZLTextView::PositionIndicator::timeString() const {
 void ZLTextView::PositionIndicator::draw() {
 	ZLPaintContext &context = this->context();
 
-	ZLTextWordCursor endCursor = myTextView.textArea().endCursor();
+	ZLTextWordCursor endCursor = myTextView.paintedArea().endCursor();
 	bool isEndOfText = false;
 	if (endCursor.isEndOfParagraph()) {
 		isEndOfText = !endCursor.nextParagraph();
@@ -225,7 +231,7 @@ void ZLTextView::PositionIndicator::draw() {
 
 	if (!isEndOfText) {
 		fillWidth =
-			muldiv(fillWidth, sizeOfTextBeforeCursor(myTextView.textArea().endCursor()), sizeOfTextBeforeParagraph(endTextIndex()));
+			muldiv(fillWidth, sizeOfTextBeforeCursor(myTextView.paintedArea().endCursor()), sizeOfTextBeforeParagraph(endTextIndex()));
 	}
 
 	context.setColor(myTextView.color());
@@ -238,12 +244,12 @@ void ZLTextView::PositionIndicator::draw() {
 }
 
 bool ZLTextView::PositionIndicator::isResponsibleFor(int x, int y) {
-	x = myTextView.textArea().realX(x);
+	x = myTextView.paintedArea().realX(x);
 	return x >= left() && x <= right() && y >= top() && y <= bottom();
 }
 
 bool ZLTextView::PositionIndicator::onStylusPress(int x, int y) {
-	x = myTextView.textArea().realX(x);
+	x = myTextView.paintedArea().realX(x);
 
 	const long bottom = this->bottom();
 	const long top = this->top();
@@ -259,7 +265,7 @@ bool ZLTextView::PositionIndicator::onStylusPress(int x, int y) {
 		return true;
 	}
 
-	if (myTextView.textArea().endCursor().isNull()) {
+	if (myTextView.paintedArea().endCursor().isNull()) {
 		return false;
 	}
 	size_t fullTextSize = sizeOfTextBeforeParagraph(endTextIndex());
@@ -27,15 +27,19 @@
 
 #include "ZLTextView.h"
 #include "ZLTextSelectionScroller.h"
+#include "ZLTextPaginator.h"
 #include "ZLTextPositionIndicator.h"
 #include "../area/ZLTextSelectionModel.h"
 #include "../area/ZLTextLineInfo.h"
 #include "../area/ZLTextParagraphCursor.h"
 #include "../area/ZLTextWord.h"
 #include "../area/ZLTextAreaStyle.h"
+#include "../area/ZLTextImageCache.h"
 
 const ZLTypeId ZLTextView::TYPE_ID(ZLView::TYPE_ID);
 
+unsigned int ZLTextView::ourLastPageRevision = 0;
+
 const ZLTypeId &ZLTextView::typeId() const {
 	return TYPE_ID;
 }
@@ -45,6 +49,12 @@ ZLTextView::ZLTextView(ZLPaintContext &context) :
 	myTextAreaController(context, *this),
 	myTreeStateIsFrozen(false),
 	myDoUpdateScrollbar(false),
+	myPageRevision(++ourLastPageRevision),
+	myPageScrollingMode(ZLTextAreaController::NO_OVERLAPPING),
+	myPageScrollingValue(0),
+	myPrerenderingIsScheduled(false),
+	myIsPrerendering(false),
+	myBrokenImagesRevision(ZLTextImageCache::brokenImagesRevision()),
 	myDoubleClickInfo(*this) {
 }
 
@@ -53,6 +63,12 @@ ZLTextView::~ZLTextView() {
 }
 
 void ZLTextView::clear() {
+	stopPagination();
+	if (myPrerenderingIsScheduled) {
+		myPrerenderingIsScheduled = false;
+		ZLTimeManager::Instance().removeTask(myPagePrerenderer);
+	}
+	invalidatePages();
 	myTextAreaController.clear();
 
 	myTextSize.clear();
@@ -86,6 +102,8 @@ void ZLTextView::setModel(shared_ptr<ZLTextModel> model) {
 			myTextSize.push_back(currentSize);
 		}
 	}
+
+	startPagination();
 }
 
 std::vector<size_t>::const_iterator ZLTextView::nextBreakIterator() const {
@@ -210,6 +228,7 @@ void ZLTextView::gotoParagraph(int num, bool end) {
 			} else {
 				tp->openTree();
 				myTextAreaController.rebuildPaintInfo(true);
+				invalidatePages();
 			}
 		}
 	}
@@ -260,6 +279,7 @@ void ZLTextView::search(const std::string &text, bool ignoreCase, bool wholeText
 	const ZLTextWordCursor &startCursor = textArea().startCursor();
 	if (!startCursor.isNull()) {
 		myTextAreaController.rebuildPaintInfo(true);
+		invalidatePages();
 		ZLTextMark position = startCursor.position();
 		gotoMark(wholeText ?
 							(backward ? model->lastMark() : model->firstMark()) :
@@ -328,6 +348,7 @@ bool ZLTextView::onStylusPress(int x, int y) {
 
 			paragraph->open(!paragraph->isOpen());
 			myTextAreaController.rebuildPaintInfo(true);
+			invalidatePages();
 			preparePaintInfo();
 			if (paragraph->isOpen()) {
 				int nextParagraphIndex = paragraphIndex + paragraph->fullSize();
@@ -450,11 +471,14 @@ bool ZLTextView::onStylusRelease(int x, int y) {
 
 void ZLTextView::clearCaches() {
 	myTextAreaController.rebuildPaintInfo(true);
+	invalidatePages();
+	startPagination();
 }
 
 void ZLTextView::highlightParagraph(int paragraphIndex) {
 	textArea().model()->selectParagraph(paragraphIndex);
 	myTextAreaController.rebuildPaintInfo(true);
+	invalidatePages();
 }
 
 void ZLTextView::gotoCharIndex(size_t charIndex) {
@@ -515,6 +539,16 @@ void ZLTextView::gotoCharIndex(size_t charIndex) {
 }
 
 void ZLTextView::gotoPage(size_t index) {
+	const ZLTextPaginator *paginator = completePaginator();
+	if (paginator != 0) {
+		std::vector<size_t>::const_iterator i = nextBreakIterator();
+		const size_t startIndex = (i != myTextBreaks.begin()) ? *(i - 1) : 0;
+		int paragraphIndex, elementIndex, charIndex;
+		paginator->pageStart(paginator->pagesBefore(startIndex) + index - 1, paragraphIndex, elementIndex, charIndex);
+		gotoPosition(paragraphIndex, elementIndex, charIndex);
+		return;
+	}
+
 	size_t charIndex = (index - 1) * 2048;
 	std::vector<size_t>::const_iterator it = std::lower_bound(myTextSize.begin(), myTextSize.end(), charIndex);
 	const int paraIndex = it - myTextSize.begin();
@@ -534,6 +568,13 @@ size_t ZLTextView::pageIndex() {
 	if (textArea().isEmpty() || positionIndicator().isNull() || textArea().endCursor().isNull()) {
 		return 0;
 	}
+	const ZLTextPaginator *paginator = completePaginator();
+	if ((paginator != 0) && !textArea().startCursor().isNull()) {
+		std::vector<size_t>::const_iterator i = nextBreakIterator();
+		const size_t startIndex = (i != myTextBreaks.begin()) ? *(i - 1) : 0;
+		const size_t index = paginator->pagesUpTo(textArea().startCursor()) - paginator->pagesBefore(startIndex);
+		return std::max(index, (size_t)1);
+	}
 	return positionIndicator()->sizeOfTextBeforeCursor(textArea().endCursor()) / 2048 + 1;
 }
 
@@ -544,6 +585,10 @@ size_t ZLTextView::pageNumber() const {
 	std::vector<size_t>::const_iterator i = nextBreakIterator();
 	const size_t startIndex = (i != myTextBreaks.begin()) ? *(i - 1) : 0;
 	const size_t endIndex = (i != myTextBreaks.end()) ? *i : textArea().model()->paragraphsNumber();
+	const ZLTextPaginator *paginator = completePaginator();
+	if (paginator != 0) {
+		return std::max(paginator->pagesBefore(endIndex) - paginator->pagesBefore(startIndex), (size_t)1);
+	}
 	return (myTextSize[endIndex] - myTextSize[startIndex]) / 2048 + 1;
 }
 
@@ -646,6 +691,10 @@ void ZLTextView::stopSelectionScrolling() {
 }
 
 void ZLTextView::scrollPage(bool forward, ZLTextAreaController::ScrollingMode mode, unsigned int value) {
+	if ((mode == ZLTextAreaController::NO_OVERLAPPING) || (mode == ZLTextAreaController::KEEP_LINES)) {
+		myPageScrollingMode = mode;
+		myPageScrollingValue = value;
+	}
 	preparePaintInfo();
 	myTextAreaController.scrollPage(forward, mode, value);
 }
@@ -663,9 +712,42 @@ void ZLTextView::preparePaintInfo() {
 	if (newWidth != myTextAreaController.area().width() || newHeight != myTextAreaController.area().height()) {
 		myTextAreaController.area().setSize(newWidth, newHeight);
 		myTextAreaController.rebuildPaintInfo(false);
+		invalidatePages();
+		startPagination();
 	}
 
 	if (myTextAreaController.preparePaintInfo()) {
 		myDoUpdateScrollbar = true;
 	}
 }
+
+void ZLTextView::startPagination() {
+	stopPagination();
+	if (myPaginator.isNull()) {
+		myPaginator = new ZLTextPaginator(*this);
+	}
+	ZLTextPaginator &paginator = (ZLTextPaginator&)*myPaginator;
+	if (paginator.reset()) {
+		paginator.setScheduled(true);
+		ZLTimeManager::Instance().addTask(myPaginator, 10);
+	}
+}
+
+void ZLTextView::stopPagination() {
+	if (!myPaginator.isNull() && ((ZLTextPaginator&)*myPaginator).isScheduled()) {
+		((ZLTextPaginator&)*myPaginator).setScheduled(false);
+		ZLTimeManager::Instance().removeTask(myPaginator);
+	}
+}
+
+void ZLTextView::onPaginationFinished() {
+	stopPagination();
+	ZLApplication::Instance().refreshWindow();
+}
+
+const ZLTextPaginator *ZLTextView::completePaginator() const {
+	if (myPaginator.isNull() || !((const ZLTextPaginator&)*myPaginator).isComplete()) {
+		return 0;
+	}
+	return &(const ZLTextPaginator&)*myPaginator;
+}
@@ -43,6 +43,7 @@ class ZLTextMark;
 class ZLTextLineInfo;
 class ZLTextLineInfoPtr;
 class ZLTextSelectionModel;
+class ZLTextPaginator;
 
 class ZLTextView : public ZLView, public ZLTextArea::Properties {
 
@@ -126,6 +127,23 @@ private:
 	void startSelectionScrolling(bool forward);
 	void stopSelectionScrolling();
 
+	// identifies the image of the current page for the paint context cache;
+	// empty string means the page cannot be cached
+	std::string pageKey();
+	// makes the cached images of the view pages outdated
+	void invalidatePages();
+	void drawPage();
+	void prerenderAdjacentPages();
+	// the area drawPage(), pageKey() and the position indicator work with:
+	// the area of the view, or the one adjacent pages are prerendered in
+	const ZLTextArea &paintedArea() const;
+	ZLTextArea &paintedArea();
+
+	void startPagination();
+	void stopPagination();
+	void onPaginationFinished();
+	const ZLTextPaginator *completePaginator() const;
+
 private:
 	ZLTextAreaController myTextAreaController;
 
@@ -133,12 +151,26 @@ private:
 	std::vector<size_t> myTextBreaks;
 
 	shared_ptr<ZLRunnable> mySelectionScroller;
+	shared_ptr<ZLRunnable> myPaginator;
+	shared_ptr<ZLRunnable> myPagePrerenderer;
 
 	shared_ptr<PositionIndicator> myPositionIndicator;
 
 	bool myTreeStateIsFrozen;
 	bool myDoUpdateScrollbar;
 
+	// all views paint to the same context, so revisions are taken from
+	// a common counter to keep page keys of different views apart
+	static unsigned int ourLastPageRevision;
+	unsigned int myPageRevision;
+	ZLTextAreaController::ScrollingMode myPageScrollingMode;
+	unsigned int myPageScrollingValue;
+	bool myPrerenderingIsScheduled;
+	shared_ptr<ZLTextAreaController> myPrerenderingController;
+	bool myIsPrerendering;
+	// ZLTextImageCache::brokenImagesRevision() the lines were built with
+	unsigned int myBrokenImagesRevision;
+
 	struct DoubleClickInfo {
 		DoubleClickInfo(const ZLTextView &view);
 		void update(int x, int y, bool press);
@@ -151,8 +183,14 @@ private:
 	private:
 		const ZLTextView &myView;
 	} myDoubleClickInfo;
+
+friend class ZLTextPaginator;
+friend class ZLTextPagePrerenderer;
 };
 
 inline const ZLTextArea &ZLTextView::textArea() const { return myTextAreaController.area(); }
+inline void ZLTextView::invalidatePages() { myPageRevision = ++ourLastPageRevision; }
+inline const ZLTextArea &ZLTextView::paintedArea() const { return myIsPrerendering ? myPrerenderingController->area() : myTextAreaController.area(); }
+inline ZLTextArea &ZLTextView::paintedArea() { return myIsPrerendering ? myPrerenderingController->area() : myTextAreaController.area(); }
 
 #endif /* __ZLTEXTVIEW_H__ */
@@ -19,29 +19,60 @@
 
 #include <algorithm>
 
+#include <ZLTimeManager.h>
+#include <ZLStringUtil.h>
+
 #include "ZLTextView.h"
 #include "ZLTextPositionIndicator.h"
+#include "../area/ZLTextSelectionModel.h"
+#include "../area/ZLTextImageCache.h"
 
-void ZLTextView::paint() {
-	context().clear(backgroundColor());
+class ZLTextPagePrerenderer : public ZLRunnable {
+
+public:
+	ZLTextPagePrerenderer(ZLTextView &view) : myView(view) {}
 
+private:
+	void run() {
+		myView.myPrerenderingIsScheduled = false;
+		myView.prerenderAdjacentPages();
+	}
+
+private:
+	ZLTextView &myView;
+};
+
+void ZLTextView::paint() {
 	myTextAreaController.area().setOffsets(
 		textArea().isRtl() ? rightMargin() : leftMargin(), topMargin()
 	);
 
+	// images that failed to decode are dropped from the layout
+	if (myBrokenImagesRevision != ZLTextImageCache::brokenImagesRevision()) {
+		myBrokenImagesRevision = ZLTextImageCache::brokenImagesRevision();
+		clearCaches();
+	}
+
 	preparePaintInfo();
 
+	const std::string key = context().hasPageCache() ? pageKey() : std::string();
+	ZLTextImageCache::startPaint(true);
+	if (key.empty() || !context().restorePage(key)) {
+		drawPage();
+		// a page drawn with image placeholders is repainted when the images are decoded
+		if (ZLTextImageCache::finishPaint() && !key.empty()) {
+			context().storePage(key);
+		}
+	} else {
+		ZLTextImageCache::finishPaint();
+		myTextAreaController.area().prepareTextMap();
+	}
+
 	if (textArea().isEmpty()) {
 		return;
 	}
 
-	myTextAreaController.area().paint();
-
 	shared_ptr<ZLTextPositionIndicatorInfo> indicatorInfo = this->indicatorInfo();
-	if (!indicatorInfo.isNull() && (indicatorInfo->type() == ZLTextPositionIndicatorInfo::FB_INDICATOR)) {
-		positionIndicator()->draw();
-	}
-
 	if (myDoUpdateScrollbar && !indicatorInfo.isNull()) {
 		myDoUpdateScrollbar = false;
 		const size_t full = positionIndicator()->sizeOfTextBeforeParagraph(positionIndicator()->endTextIndex());
@@ -60,4 +91,113 @@ void ZLTextView::paint() {
 	}
 
 	ZLTextParagraphCursorCache::cleanup();
+
+	if (!key.empty() && !myPrerenderingIsScheduled) {
+		if (myPagePrerenderer.isNull()) {
+			myPagePrerenderer = new ZLTextPagePrerenderer(*this);
+		}
+		myPrerenderingIsScheduled = true;
+		ZLTimeManager::Instance().addAutoRemovableTask(myPagePrerenderer, 100);
+	}
+}
+
+void ZLTextView::drawPage() {
+	context().clear(backgroundColor());
+
+	if (paintedArea().isEmpty()) {
+		return;
+	}
+
+	paintedArea().paint();
+
+	shared_ptr<ZLTextPositionIndicatorInfo> indicatorInfo = this->indicatorInfo();
+	if (!indicatorInfo.isNull() && (indicatorInfo->type() == ZLTextPositionIndicatorInfo::FB_INDICATOR)) {
+		positionIndicator()->draw();
+	}
+}
+
+std::string ZLTextView::pageKey() {
+	const ZLTextArea &area = paintedArea();
+	if (area.isEmpty() || area.startCursor().isNull() || area.endCursor().isNull() ||
+			!myTextAreaController.area().selectionModel().isEmpty()) {
+		return std::string();
+	}
+
+	const ZLTextWordCursor &startCursor = area.startCursor();
+	std::string key;
+	ZLStringUtil::appendNumber(key, myPageRevision);
+	key += ':';
+	ZLStringUtil::appendNumber(key, startCursor.paragraphCursor().index());
+	key += ':';
+	ZLStringUtil::appendNumber(key, startCursor.elementIndex());
+	key += ':';
+	ZLStringUtil::appendNumber(key, startCursor.charIndex());
+	key += ':';
+	ZLStringUtil::appendNumber(key, backgroundColor().intValue());
+	key += ':';
+	ZLStringUtil::appendNumber(key, color().intValue());
+
+	shared_ptr<ZLTextPositionIndicatorInfo> indicatorInfo = this->indicatorInfo();
+	if (!indicatorInfo.isNull() && (indicatorInfo->type() == ZLTextPositionIndicatorInfo::FB_INDICATOR)) {
+		const PositionIndicator &indicator = *positionIndicator();
+		key += ':';
+		ZLStringUtil::appendNumber(key, indicatorInfo->color().intValue());
+		key += ':';
+		ZLStringUtil::appendNumber(key, indicatorInfo->fontSize());
+		if (indicatorInfo->isTimeShown()) {
+			key += ':';
+			key += indicator.timeString();
+		}
+		if (indicatorInfo->isTextPositionShown()) {
+			key += ':';
+			key += indicator.textPositionString();
+		}
+	}
+	return key;
+}
+
+void ZLTextView::prerenderAdjacentPages() {
+	if (!context().hasPageCache()) {
+		return;
+	}
+
+	preparePaintInfo();
+	if (pageKey().empty()) {
+		return;
+	}
+
+	// adjacent pages are laid out in a separate area: scrolling the view
+	// there and back could change the lines of a page laid out from its end
+	if (myPrerenderingController.isNull()) {
+		myPrerenderingController = new ZLTextAreaController(context(), *this);
+	}
+	ZLTextAreaController &controller = *myPrerenderingController;
+	const ZLTextWordCursor &start = textArea().startCursor();
+	const ZLTextWordCursor &end = textArea().endCursor();
+
+	myIsPrerendering = true;
+	for (int i = 0; i < 2; ++i) {
+		const bool forward = i == 0;
+		if (forward ?
+					(end.isEndOfParagraph() && end.paragraphCursor().isLast()) :
+					(start.isStartOfParagraph() && start.paragraphCursor().isFirst())) {
+			continue;
+		}
+
+		controller.copyPage(myTextAreaController);
+		controller.scrollPage(forward, myPageScrollingMode, myPageScrollingValue);
+		controller.preparePaintInfo();
+		const std::string key = pageKey();
+		if (!key.empty() && !context().containsPage(key)) {
+			ZLTextImageCache::startPaint(false);
+			drawPage();
+			if (ZLTextImageCache::finishPaint()) {
+				context().storePage(key);
+			}
+		}
+	}
+	myIsPrerendering = false;
+
+	controller.setModel(0);
+	ZLTextParagraphCursorCache::cleanup();
 }
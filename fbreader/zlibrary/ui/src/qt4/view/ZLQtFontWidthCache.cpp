@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include <ZLStringUtil.h>
+#include <ZLLogger.h>
+
+#include "ZLQtFontWidthCache.h"
+
+// characters below this code point are latin, greek, cyrillic or armenian
+static const int ADVANCES_LIMIT = 0x0590;
+static const size_t MAX_WORDS_NUMBER = 16384;
+
+static bool isSimpleChar(int ch) {
+	return
+		(ch >= 0x20) && (ch < ADVANCES_LIMIT) &&
+		(ch != 0xAD) && // soft hyphen
+		((ch < 0x0300) || (ch >= 0x0370)) && // combining diacritical marks
+		((ch < 0x0483) || (ch >= 0x048A)); // combining cyrillic marks
+}
+
+std::string ZLQtFontWidthCache::key(const QFont &font) {
+	std::string k = (const char*)font.family().toUtf8();
+	k += '\n';
+	ZLStringUtil::appendNumber(k, font.pointSize());
+	k += font.bold() ? 'b' : '-';
+	k += font.italic() ? 'i' : '-';
+	return k;
+}
+
+ZLQtFontWidthCache::ZLQtFontWidthCache(const QFont &font, const QFontMetrics &metrics) : myKey(key(font)), myMetrics(metrics), myAdvances(ADVANCES_LIMIT, -1), myWordHits(0), myAdvanceHits(0), myMisses(0) {
+	static const char *PROBES[] = {
+		"AV", "To", "Wa", "Yo", "LT", "P.", "fi", "fl", "ff",
+		"mmmmmmmmmmmmmmmm", "iiiiiiiiiiiiiiii", "The quick brown fox jumps", 0
+	};
+	myUseAdvances = true;
+	for (const char **probe = PROBES; myUseAdvances && (*probe != 0); ++probe) {
+		const QString str = QString::fromLatin1(*probe);
+		int sum = 0;
+		for (int i = 0; i < str.length(); ++i) {
+			sum += myMetrics.width(str[i]);
+		}
+		myUseAdvances = sum == myMetrics.width(str);
+	}
+}
+
+ZLQtFontWidthCache::~ZLQtFontWidthCache() {
+	const unsigned long total = myWordHits + myAdvanceHits + myMisses;
+	if (total > 0) {
+		std::string message = "width cache for ";
+		message += myKey;
+		message += ": ";
+		ZLStringUtil::appendNumber(message, (unsigned int)total);
+		message += " lookups, ";
+		ZLStringUtil::appendNumber(message, (unsigned int)myWordHits);
+		message += " word hits, ";
+		ZLStringUtil::appendNumber(message, (unsigned int)myAdvanceHits);
+		message += " advance sums, ";
+		ZLStringUtil::appendNumber(message, (unsigned int)((myWordHits + myAdvanceHits) * 100 / total));
+		message += "% hit rate";
+		ZLLogger::Instance().println("fontcache", message);
+	}
+}
+
+int ZLQtFontWidthCache::advancesWidth(const char *str, int len) {
+	int sum = 0;
+	const char *end = str + len;
+	for (const char *ptr = str; ptr < end;) {
+		const unsigned char c = *ptr;
+		int ch;
+		if (c < 0x80) {
+			ch = c;
+			++ptr;
+		} else if ((c & 0xE0) == 0xC0 && (ptr + 1 < end) && ((ptr[1] & 0xC0) == 0x80)) {
+			ch = ((c & 0x1F) << 6) | (ptr[1] & 0x3F);
+			ptr += 2;
+		} else {
+			return -1;
+		}
+		if (!isSimpleChar(ch)) {
+			return -1;
+		}
+		int &advance = myAdvances[ch];
+		if (advance == -1) {
+			advance = myMetrics.width(QChar(ch));
+		}
+		sum += advance;
+	}
+	return sum;
+}
+
+int ZLQtFontWidthCache::width(const char *str, int len) {
+	if (myUseAdvances) {
+		const int w = advancesWidth(str, len);
+		if (w != -1) {
+			++myAdvanceHits;
+			return w;
+		}
+	}
+
+	const std::string word(str, len);
+	std::map<std::string,int>::const_iterator it = myWords.find(word);
+	if (it != myWords.end()) {
+		++myWordHits;
+		return it->second;
+	}
+
+	++myMisses;
+	if (myWords.size() >= MAX_WORDS_NUMBER) {
+		myWords.clear();
+	}
+	const int w = myMetrics.width(QString::fromUtf8(str, len));
+	myWords.insert(std::make_pair(word, w));
+	return w;
+}
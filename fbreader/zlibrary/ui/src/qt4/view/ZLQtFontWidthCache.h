@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2004-2010 Geometer Plus <contact@geometerplus.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef __ZLQTFONTWIDTHCACHE_H__
+#define __ZLQTFONTWIDTHCACHE_H__
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include <QtGui/QFont>
+#include <QtGui/QFontMetrics>
+
+/*
+ * String widths measured in one font. Whole words are remembered as they
+ * are measured; if the font shows neither kerning nor fractional advances
+ * on a few probe strings, words written in simple alphabetic scripts are
+ * measured as a sum of cached per-character advances instead.
+ */
+class ZLQtFontWidthCache {
+
+public:
+	static std::string key(const QFont &font);
+
+public:
+	ZLQtFontWidthCache(const QFont &font, const QFontMetrics &metrics);
+	~ZLQtFontWidthCache();
+
+	int width(const char *str, int len);
+
+private:
+	int advancesWidth(const char *str, int len);
+
+private:
+	const std::string myKey;
+	const QFontMetrics myMetrics;
+	bool myUseAdvances;
+	std::vector<int> myAdvances;
+	std::map<std::string,int> myWords;
+
+	unsigned long myWordHits;
+	unsigned long myAdvanceHits;
+	unsigned long myMisses;
+
+private: // disable copying
+	ZLQtFontWidthCache(const ZLQtFontWidthCache&);
+	const ZLQtFontWidthCache &operator = (const ZLQtFontWidthCache&);
+};
+
+#endif /* __ZLQTFONTWIDTHCACHE_H__ */
@@ -27,14 +27,18 @@
 #include <ZLImage.h>
 
 #include "ZLQtPaintContext.h"
+#include "ZLQtFontWidthCache.h"
 #include "../image/ZLQtImageManager.h"
 
-ZLQtPaintContext::ZLQtPaintContext() {
+ZLQtPaintContext::ZLQtPaintContext() :
+	PageCacheSizeOption(ZLCategoryKey::CONFIG, "Options", "PageCacheSize", 0, 512, 32) {
 	myPainter = new QPainter();
 	myPixmap = 0;
 	mySpaceWidth = -1;
 	myDescent = 0;
 	myFontIsStored = false;
+	myWidthCache = 0;
+	myPageCacheBytes = 0;
 }
 
 ZLQtPaintContext::~ZLQtPaintContext() {
@@ -48,6 +52,7 @@ ZLQtPaintContext::~ZLQtPaintContext() {
 void ZLQtPaintContext::setSize(int w, int h) {
 	if (myPixmap != 0) {
 		if ((myPixmap->width() != w) || (myPixmap->height() != h)) {
+			clearPageCache();
 			myPainter->end();
 			delete myPixmap;
 			myPixmap = 0;
@@ -124,6 +129,7 @@ void ZLQtPaintContext::setFont(const std::string &family, int size, bool bold, b
 		if (fontChanged) {
 			myPainter->setFont(font);
 			mySpaceWidth = -1;
+			myWidthCache = 0;
 			myDescent = myPainter->fontMetrics().descent();
 		}
 	}
@@ -144,8 +150,20 @@ void ZLQtPaintContext::setFillColor(ZLColor color, FillStyle style) {
 	));
 }
 
+ZLQtFontWidthCache &ZLQtPaintContext::widthCache() const {
+	if (myWidthCache == 0) {
+		const QFont &font = myPainter->font();
+		shared_ptr<ZLQtFontWidthCache> &cache = myWidthCaches[ZLQtFontWidthCache::key(font)];
+		if (cache.isNull()) {
+			cache = new ZLQtFontWidthCache(font, myPainter->fontMetrics());
+		}
+		myWidthCache = &*cache;
+	}
+	return *myWidthCache;
+}
+
 int ZLQtPaintContext::stringWidth(const char *str, int len, bool) const {
-	return myPainter->fontMetrics().width(QString::fromUtf8(str, len));
+	return widthCache().width(str, len);
 }
 
 int ZLQtPaintContext::spaceWidth() const {
@@ -236,3 +254,64 @@ int ZLQtPaintContext::height() const {
 	}
 	return myPixmap->height();
 }
+
+static size_t pageBytes(const QPixmap &pixmap) {
+	return (size_t)pixmap.width() * pixmap.height() * pixmap.depth() / 8;
+}
+
+bool ZLQtPaintContext::hasPageCache() const {
+	return PageCacheSizeOption.value() > 0;
+}
+
+void ZLQtPaintContext::clearPageCache() {
+	myPageCache.clear();
+	myPageCacheBytes = 0;
+}
+
+bool ZLQtPaintContext::containsPage(const std::string &key) const {
+	for (std::list<std::pair<std::string,QPixmap> >::const_iterator it = myPageCache.begin(); it != myPageCache.end(); ++it) {
+		if (it->first == key) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ZLQtPaintContext::restorePage(const std::string &key) {
+	if (myPixmap == 0) {
+		return false;
+	}
+	for (std::list<std::pair<std::string,QPixmap> >::iterator it = myPageCache.begin(); it != myPageCache.end(); ++it) {
+		if (it->first == key) {
+			myPageCache.splice(myPageCache.begin(), myPageCache, it);
+			myPainter->drawPixmap(0, 0, myPageCache.front().second);
+			return true;
+		}
+	}
+	return false;
+}
+
+void ZLQtPaintContext::storePage(const std::string &key) {
+	if (myPixmap == 0) {
+		return;
+	}
+	const size_t limit = (size_t)PageCacheSizeOption.value() * 1024 * 1024;
+	const size_t bytes = pageBytes(*myPixmap);
+	if (bytes > limit) {
+		return;
+	}
+
+	for (std::list<std::pair<std::string,QPixmap> >::iterator it = myPageCache.begin(); it != myPageCache.end(); ++it) {
+		if (it->first == key) {
+			myPageCacheBytes -= pageBytes(it->second);
+			myPageCache.erase(it);
+			break;
+		}
+	}
+	while (!myPageCache.empty() && (myPageCacheBytes + bytes > limit)) {
+		myPageCacheBytes -= pageBytes(myPageCache.back().second);
+		myPageCache.pop_back();
+	}
+	myPageCache.push_front(std::make_pair(key, myPixmap->copy()));
+	myPageCacheBytes += bytes;
+}
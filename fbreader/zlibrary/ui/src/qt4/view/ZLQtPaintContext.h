@@ -20,13 +20,24 @@
 #ifndef __ZLQTPAINTCONTEXT_H__
 #define __ZLQTPAINTCONTEXT_H__
 
+#include <list>
+#include <map>
+
+#include <QtGui/QPixmap>
+
 #include <ZLPaintContext.h>
+#include <ZLOptions.h>
+
+#include <shared_ptr.h>
 
 class QPainter;
-class QPixmap;
+class ZLQtFontWidthCache;
 
 class ZLQtPaintContext : public ZLPaintContext {
 
+public:
+	ZLIntegerRangeOption PageCacheSizeOption;
+
 public:
 	ZLQtPaintContext();
 	~ZLQtPaintContext();
@@ -60,6 +71,15 @@ public:
 	void fillRectangle(int x0, int y0, int x1, int y1);
 	void drawFilledCircle(int x, int y, int r);
 
+	bool hasPageCache() const;
+	bool containsPage(const std::string &key) const;
+	bool restorePage(const std::string &key);
+	void storePage(const std::string &key);
+
+private:
+	void clearPageCache();
+	ZLQtFontWidthCache &widthCache() const;
+
 private:
 	QPainter *myPainter;
 	QPixmap *myPixmap;
@@ -71,6 +91,14 @@ private:
 	int myStoredSize;
 	bool myStoredBold;
 	bool myStoredItalic;	
+
+	// widths are shared by all the paragraphs laid out in the same font
+	mutable std::map<std::string,shared_ptr<ZLQtFontWidthCache> > myWidthCaches;
+	mutable ZLQtFontWidthCache *myWidthCache;
+
+	// most recently used pages go first
+	std::list<std::pair<std::string,QPixmap> > myPageCache;
+	size_t myPageCacheBytes;
 };
 
 #endif /* __ZLQTPAINTCONTEXT_H__ */
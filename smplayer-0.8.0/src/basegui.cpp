@@ -51,6 +51,7 @@
 #include "preferences.h"
 #include "discname.h"
 #include "timeslider.h"
+#include "seekthumbnails.h"
 #include "logwindow.h"
 #include "playlist.h"
 #include "filepropertiesdialog.h"
@@ -139,6 +140,8 @@ BaseGui::BaseGui( QWidget* parent, Qt::WindowFlags flags )
 
 	createMplayerWindow();
 	createCore();
+
+	seek_thumbnails = new SeekThumbnails(Paths::configPath() + "/thumbnails", this);
 	createPlaylist();
 	createVideoEqualizer();
 	createAudioEqualizer();
@@ -165,9 +168,18 @@ BaseGui::BaseGui( QWidget* parent, Qt::WindowFlags flags )
 
 #ifdef LOG_MPLAYER
 	mplayer_log_window = new LogWindow(0);
+	mplayer_log_shown = 0;
+	mplayer_log_saved = 0;
 #endif
 #ifdef LOG_SMPLAYER
 	smplayer_log_window = new LogWindow(0);
+	smplayer_log_shown = 0;
+#endif
+#if defined(LOG_MPLAYER) || defined(LOG_SMPLAYER)
+	log_timer = new QTimer(this);
+	log_timer->setSingleShot(true);
+	log_timer->setInterval(250);
+	connect( log_timer, SIGNAL(timeout()), this, SLOT(flushLogs()) );
 #endif
 
 	createActions();
@@ -249,6 +261,9 @@ void BaseGui::handleMessageFromOtherInstances(const QString& message) {
 
 BaseGui::~BaseGui() {
 	delete core; // delete before mplayerwindow, otherwise, segfault...
+#if defined(LOG_MPLAYER) || defined(LOG_SMPLAYER)
+	flushLogs();
+#endif
 #ifdef LOG_MPLAYER
 	delete mplayer_log_window;
 #endif
@@ -2834,11 +2849,22 @@ void BaseGui::newMediaLoaded() {
 		QStringList files_to_add = Helper::searchForConsecutiveFiles(core->mdat.filename);
 		if (!files_to_add.empty()) playlist->addFiles(files_to_add);
 	}
+
+	// Thumbnails for the time slider
+	if ((pref->seekbar_thumbnails) && (core->mdat.type == TYPE_FILE) && (!core->mdat.novideo)) {
+		seek_thumbnails->setMplayerPath(pref->mplayer_bin);
+		seek_thumbnails->setFile(core->mdat.filename, core->mdat.duration);
+	} else {
+		seek_thumbnails->clear();
+	}
 }
 
 #ifdef LOG_MPLAYER
 void BaseGui::clearMplayerLog() {
 	mplayer_log.clear();
+	mplayer_log_shown = 0;
+	mplayer_log_saved = 0;
+	if (mplayer_log_file.isOpen()) mplayer_log_file.close();
 	if (mplayer_log_window->isVisible()) mplayer_log_window->clear();
 }
 
@@ -2847,24 +2873,26 @@ void BaseGui::recordMplayerLog(QString line) {
 		if ( (line.indexOf("A:")==-1) && (line.indexOf("V:")==-1) ) {
 			line.append("\n");
 			mplayer_log.append(line);
-			if (mplayer_log_window->isVisible()) mplayer_log_window->appendText(line);
+			if (!log_timer->isActive()) log_timer->start();
 		}
 	}
 }
 
 /*! 
 	Save the mplayer log to a file, so it can be used by external
-	applications.
+	applications. The lines received later are appended to the
+	file by flushLogs().
 */
 void BaseGui::autosaveMplayerLog() {
 
 	if (pref->autosave_mplayer_log) {
 		if (!pref->mplayer_log_saveto.isEmpty()) {
-			QFile file( pref->mplayer_log_saveto );
-			if ( file.open( QIODevice::WriteOnly ) ) {
-				QTextStream strm( &file );
-				strm << mplayer_log;
-				file.close();
+			if (mplayer_log_file.isOpen()) mplayer_log_file.close();
+			mplayer_log_file.setFileName( pref->mplayer_log_saveto );
+			if ( mplayer_log_file.open( QIODevice::WriteOnly ) ) {
+				QTextStream strm( &mplayer_log_file );
+				strm << mplayer_log.text();
+				mplayer_log_saved = mplayer_log.endLine();
 			}
 		}
 	}
@@ -2874,7 +2902,9 @@ void BaseGui::showMplayerLog() {
 
 	exitFullscreenIfNeeded();
 
-    mplayer_log_window->setText( mplayer_log );
+	mplayer_log_window->setMaximumLines( mplayer_log.endLine() - mplayer_log.firstLine() );
+	mplayer_log_window->setText( mplayer_log.text() );
+	mplayer_log_shown = mplayer_log.endLine();
 	mplayer_log_window->show();
 }
 #endif
@@ -2884,7 +2914,7 @@ void BaseGui::recordSmplayerLog(QString line) {
 	if (pref->log_smplayer) {
 		line.append("\n");
 		smplayer_log.append(line);
-		if (smplayer_log_window->isVisible()) smplayer_log_window->appendText(line);
+		if (!log_timer->isActive()) log_timer->start();
 	}
 }
 
@@ -2892,11 +2922,53 @@ void BaseGui::showLog() {
 
 	exitFullscreenIfNeeded();
 
-	smplayer_log_window->setText( smplayer_log );
+	smplayer_log_window->setMaximumLines( smplayer_log.endLine() - smplayer_log.firstLine() );
+	smplayer_log_window->setText( smplayer_log.text() );
+	smplayer_log_shown = smplayer_log.endLine();
 	smplayer_log_window->show();
 }
 #endif
 
+#if defined(LOG_MPLAYER) || defined(LOG_SMPLAYER)
+void BaseGui::flushLogs() {
+#ifdef LOG_MPLAYER
+	if ( (mplayer_log_window->isVisible()) && (mplayer_log_shown < mplayer_log.endLine()) ) {
+		// The window keeps the same lines as the buffer
+		mplayer_log_window->setMaximumLines( mplayer_log.endLine() - mplayer_log.firstLine() );
+		if (mplayer_log_shown < mplayer_log.firstLine()) {
+			mplayer_log_window->setText( mplayer_log.text() );
+		} else {
+			mplayer_log_window->appendText( mplayer_log.textFrom(mplayer_log_shown) );
+		}
+	}
+	mplayer_log_shown = mplayer_log.endLine();
+
+	if ( (mplayer_log_file.isOpen()) && (mplayer_log_saved < mplayer_log.endLine()) ) {
+		QTextStream strm( &mplayer_log_file );
+		if (mplayer_log_saved < mplayer_log.firstLine()) {
+			// The buffer has dropped lines before they could be saved
+			strm << QString("[%1 lines dropped]\n").arg(mplayer_log.firstLine() - mplayer_log_saved);
+			mplayer_log_saved = mplayer_log.firstLine();
+		}
+		strm << mplayer_log.textFrom(mplayer_log_saved);
+		mplayer_log_saved = mplayer_log.endLine();
+	}
+#endif
+
+#ifdef LOG_SMPLAYER
+	if ( (smplayer_log_window->isVisible()) && (smplayer_log_shown < smplayer_log.endLine()) ) {
+		smplayer_log_window->setMaximumLines( smplayer_log.endLine() - smplayer_log.firstLine() );
+		if (smplayer_log_shown < smplayer_log.firstLine()) {
+			smplayer_log_window->setText( smplayer_log.text() );
+		} else {
+			smplayer_log_window->appendText( smplayer_log.textFrom(smplayer_log_shown) );
+		}
+	}
+	smplayer_log_shown = smplayer_log.endLine();
+#endif
+}
+#endif
+
 
 void BaseGui::initializeMenus() {
 
@@ -4103,6 +4175,10 @@ void BaseGui::displayGotoTime(int t) {
 }
 
 void BaseGui::goToPosOnDragging(int t) {
+	// The thumbnails already show where we're going, don't
+	// make mplayer seek until the slider is released
+	if (seek_thumbnails->isReady()) return;
+
 	if (pref->update_while_seeking) {
 #if ENABLE_DELAYED_DRAGGING
 		#ifdef SEEKBAR_RESOLUTION
@@ -4334,7 +4410,7 @@ void BaseGui::showExitCodeFromMplayer(int exit_code) {
 		d.setText(tr("MPlayer has finished unexpectedly.") + " " + 
 	              tr("Exit code: %1").arg(exit_code));
 #ifdef LOG_MPLAYER
-		d.setLog( mplayer_log );
+		d.setLog( mplayer_log.text() );
 #endif
 		d.exec();
 	} 
@@ -4356,7 +4432,7 @@ void BaseGui::showErrorFromMplayer(QProcess::ProcessError e) {
                       tr("See the log for more info."));
 		}
 #ifdef LOG_MPLAYER
-		d.setLog( mplayer_log );
+		d.setLog( mplayer_log.text() );
 #endif
 		d.exec();
 	}
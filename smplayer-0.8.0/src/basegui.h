@@ -27,6 +27,8 @@
 #include "core.h"
 #include "config.h"
 #include "guiconfig.h"
+#include "logbuffer.h"
+#include <QFile>
 
 #ifdef Q_OS_WIN
 /* Disable screensaver by event */
@@ -35,6 +37,7 @@
 
 class QWidget;
 class QMenu;
+class QTimer;
 class LogWindow;
 class MplayerWindow;
 
@@ -58,6 +61,7 @@ class MyActionGroup;
 class PreferencesDialog;
 
 class Favorites;
+class SeekThumbnails;
 class TVList;
 
 class BaseGui : public QMainWindow
@@ -275,6 +279,12 @@ protected slots:
 	void autosaveMplayerLog();
 #endif
 
+#if defined(LOG_MPLAYER) || defined(LOG_SMPLAYER)
+	//! Sends the new lines of the logs to the log windows
+	//! and to the autosave file
+	void flushLogs();
+#endif
+
 signals:
 	void frameChanged(int);
 	void ABMarkersChanged(int secs_a, int secs_b);
@@ -701,6 +711,8 @@ protected:
 
 	Favorites * favorites;
 
+	SeekThumbnails * seek_thumbnails;
+
 	TVList * tvlist;
 	TVList * radiolist;
 
@@ -730,10 +742,18 @@ private:
 #endif
 
 #ifdef LOG_MPLAYER
-	QString mplayer_log;
+	LogBuffer mplayer_log;
+	int mplayer_log_shown; // Lines already sent to the log window
+	QFile mplayer_log_file;
+	int mplayer_log_saved; // Lines already written to mplayer_log_file
 #endif
 #ifdef LOG_SMPLAYER
-	QString smplayer_log;
+	LogBuffer smplayer_log;
+	int smplayer_log_shown;
+#endif
+#if defined(LOG_MPLAYER) || defined(LOG_SMPLAYER)
+	// New lines are sent to the windows in batches
+	QTimer * log_timer;
 #endif
 
 	bool ignore_show_hide_events;
@@ -519,6 +519,7 @@ void BaseGuiPlus::shrinkWindow() {
 TimeSliderAction * BaseGuiPlus::createTimeSliderAction(QWidget * parent) {
 	TimeSliderAction * timeslider_action = new TimeSliderAction( parent );
 	timeslider_action->setObjectName("timeslider_action");
+	timeslider_action->setThumbnails(seek_thumbnails);
 
 #ifdef SEEKBAR_RESOLUTION
 	connect( timeslider_action, SIGNAL( posChanged(int) ), 
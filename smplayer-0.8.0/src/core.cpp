@@ -41,6 +41,7 @@
 #include "colorutils.h"
 #include "discname.h"
 #include "filters.h"
+#include "inforeader.h"
 
 #if defined(Q_OS_WIN) || defined(Q_OS_OS2)
 #ifdef Q_OS_WIN
@@ -55,6 +56,7 @@
 #ifndef NO_USE_INI_FILES
 #include "filesettings.h"
 #include "filesettingshash.h"
+#include "filesettingsstore.h"
 #include "tvsettings.h"
 #endif
 
@@ -65,7 +67,7 @@
 using namespace Global;
 
 Core::Core( MplayerWindow *mpw, QWidget* parent ) 
-	: QObject( parent ) 
+	: QObject( parent ), vf_chain("vf"), af_chain("af")
 {
 	qRegisterMetaType<Core::State>("Core::State");
 
@@ -77,6 +79,8 @@ Core::Core( MplayerWindow *mpw, QWidget* parent )
 	just_loaded_external_subs = false;
 	just_unloaded_external_subs = false;
 	change_volume_after_unpause = false;
+	proc_screenshot_enabled = false;
+	proc_filters_changed = false;
 
 #if DVDNAV_SUPPORT
 	dvdnav_title_is_menu = true; // Enabled by default for compatibility with previous versions of mplayer
@@ -141,6 +145,10 @@ Core::Core( MplayerWindow *mpw, QWidget* parent )
 	connect( proc, SIGNAL(receivedScreenshot(QString)),
              this, SLOT(displayScreenshotName(QString)) );
 
+	// Queued: the slot restarts mplayer
+	connect( proc, SIGNAL(receivedFilterError(QString)),
+             this, SLOT(filterChangeFailed(QString)), Qt::QueuedConnection );
+
 	connect( proc, SIGNAL(receivedUpdatingFontCache()),
              this, SLOT(displayUpdatingFontCache()) );
 	
@@ -285,6 +293,9 @@ void Core::changeFileSettingsMethod(QString method) {
 
 	if (method.toLower() == "hash")
 		file_settings = new FileSettingsHash(Paths::iniPath());
+	else
+	if (method.toLower() == "store")
+		file_settings = new FileSettingsStore(Paths::iniPath());
 	else
 		file_settings = new FileSettings(Paths::iniPath());
 }
@@ -1857,100 +1868,214 @@ void Core::startMplayer( QString file, double seek ) {
 		}
 	}
 
-	bool force_noslices = false;
+	// Video filters
+	QStringList vf_options;
+	QStringList vf = videoFilters(screenshot_enabled, vf_options);
+	for (int n = 0; n < vf.count(); n++) {
+		proc->addArgument("-vf-add");
+		proc->addArgument(vf[n]);
+	}
+	for (int n = 0; n < vf_options.count(); n++) {
+		proc->addArgument(vf_options[n]);
+	}
+
+	// slices
+	if (!vf_options.contains("-noslices")) {
+		if (pref->use_slices) {
+			proc->addArgument("-slices");
+		} else {
+			proc->addArgument("-noslices");
+		}
+	}
+
+
+	// Audio channels
+	if (mset.audio_use_channels != 0) {
+		proc->addArgument("-channels");
+		proc->addArgument( QString::number( mset.audio_use_channels ) );
+	}
+
+	// Audio filters
+	QStringList af = audioFilters();
+	if (!af.isEmpty()) {
+		// Don't use audio filters if using the S/PDIF output
+		if (pref->use_hwac3) {
+			qDebug("Core::startMplayer: audio filters are disabled when using the S/PDIF output!");
+			af.clear();
+		} else {
+			proc->addArgument("-af");
+			proc->addArgument( af.join(",") );
+		}
+	}
+
+	// Remember the filters, so they can be changed later without a restart
+	vf_chain.setFilters(vf);
+	af_chain.setFilters(af);
+	proc_vf_options = vf_options;
+	proc_screenshot_enabled = screenshot_enabled;
+	proc_filters_changed = false;
+
+	if (pref->use_soft_vol) {
+		proc->addArgument("-softvol");
+		proc->addArgument("-softvol-max");
+		proc->addArgument( QString::number(pref->softvol_max) );
+	}
+
+	// Load edl file
+	if (pref->use_edl_files) {
+		QString edl_f;
+		QFileInfo f(file);
+		QString basename = f.path() + "/" + f.completeBaseName();
+
+		if (QFile::exists(basename+".edl")) 
+			edl_f = basename+".edl";
+		else
+		if (QFile::exists(basename+".EDL")) 
+			edl_f = basename+".EDL";
+
+		if (!edl_f.isEmpty()) {
+			proc->addArgument("-edl");
+			proc->addArgument(edl_f);
+		}
+	}
+
+	// Additional options supplied by the user
+	// File
+	if (!mset.mplayer_additional_options.isEmpty()) {
+		QStringList args = MyProcess::splitArguments(mset.mplayer_additional_options);
+        QStringList::Iterator it = args.begin();
+        while( it != args.end() ) {
+ 			proc->addArgument( (*it) );
+			++it;
+		}
+	}
+	// Global
+	if (!pref->mplayer_additional_options.isEmpty()) {
+		QStringList args = MyProcess::splitArguments(pref->mplayer_additional_options);
+        QStringList::Iterator it = args.begin();
+        while( it != args.end() ) {
+ 			proc->addArgument( (*it) );
+			++it;
+		}
+	}
+
+	// File to play
+	if (url_is_playlist) {
+		proc->addArgument("-playlist");
+	}
+
+#ifdef Q_OS_WIN
+	if (pref->use_short_pathnames)
+		proc->addArgument(Helper::shortPathName(file));
+	else
+#endif
+	proc->addArgument( file );
+
+	// It seems the loop option must be after the filename
+	if (mset.loop) {
+		proc->addArgument("-loop");
+		proc->addArgument("0");
+	}
+
+	emit aboutToStartPlaying();
+
+	QString commandline = proc->arguments().join(" ");
+
+
+	//Log command
+	QString line_for_log = commandline + "\n";
+	emit logLineAvailable(line_for_log);
+	
+	if ( !proc->start() ) {
+	    // error handling
+		qWarning("Core::startMplayer: mplayer process didn't start");
+	}
+
+}
+
+QStringList Core::videoFilters(bool screenshot_enabled, QStringList & options) {
+	QStringList vf;
 
 #ifndef Q_OS_WIN
 	if ((pref->vdpau.disable_video_filters) && (pref->vo.startsWith("vdpau"))) {
 
-		goto end_video_filters;
+		return vf;
 	}
 #endif
 
-	// Video filters:
 	// Phase
 	if (mset.phase_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( "phase=A" );
+		vf << "phase=A";
 	}
 
 	// Deinterlace
 	if (mset.current_deinterlacer != MediaSettings::NoDeinterlace) {
-		proc->addArgument("-vf-add");
 		switch (mset.current_deinterlacer) {
-			case MediaSettings::L5: 		proc->addArgument("pp=l5"); break;
-			case MediaSettings::Yadif: 		proc->addArgument("yadif"); break;
-			case MediaSettings::LB:			proc->addArgument("pp=lb"); break;
-			case MediaSettings::Yadif_1:	proc->addArgument("yadif=1"); break;
-			case MediaSettings::Kerndeint:	proc->addArgument("kerndeint=5"); break;
+			case MediaSettings::L5: 		vf << "pp=l5"; break;
+			case MediaSettings::Yadif: 		vf << "yadif"; break;
+			case MediaSettings::LB:			vf << "pp=lb"; break;
+			case MediaSettings::Yadif_1:	vf << "yadif=1"; break;
+			case MediaSettings::Kerndeint:	vf << "kerndeint=5"; break;
 		}
 	}
 
 	// Denoise
 	if (mset.current_denoiser != MediaSettings::NoDenoise) {
-		proc->addArgument("-vf-add");
 		if (mset.current_denoiser==MediaSettings::DenoiseSoft) {
-			proc->addArgument( pref->filters->item("denoise_soft").filter() );
+			vf << pref->filters->item("denoise_soft").filter();
 		} else {
-			proc->addArgument( pref->filters->item("denoise_normal").filter() );
+			vf << pref->filters->item("denoise_normal").filter();
 		}
 	}
 
 	// Unsharp
 	if (mset.current_unsharp != 0) {
-		proc->addArgument("-vf-add");
 		if (mset.current_unsharp == 1) {
-			proc->addArgument( pref->filters->item("blur").filter() );
+			vf << pref->filters->item("blur").filter();
 		} else {
-			proc->addArgument( pref->filters->item("sharpen").filter() );
+			vf << pref->filters->item("sharpen").filter();
 		}
 	}
 
 	// Deblock
 	if (mset.deblock_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( pref->filters->item("deblock").filter() );
+		vf << pref->filters->item("deblock").filter();
 	}
 
 	// Dering
 	if (mset.dering_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( "pp=dr" );
+		vf << "pp=dr";
 	}
 
 	// Gradfun
 	if (mset.gradfun_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( pref->filters->item("gradfun").filter() );
+		vf << pref->filters->item("gradfun").filter();
 	}
 
 	// Upscale
 	if (mset.upscaling_filter) {
 		int width = DesktopInfo::desktop_size(mplayerwindow).width();
-		proc->addArgument("-sws");
-		proc->addArgument("9");
-		proc->addArgument("-vf-add");
-		proc->addArgument("scale="+QString::number(width)+":-2");
+		options << "-sws" << "9";
+		vf << "scale="+QString::number(width)+":-2";
 	}
 
 	// Addnoise
 	if (mset.noise_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( pref->filters->item("noise").filter() );
+		vf << pref->filters->item("noise").filter();
 	}
 
 	// Postprocessing
 	if (mset.postprocessing_filter) {
-		proc->addArgument("-vf-add");
-		proc->addArgument("pp");
-		proc->addArgument("-autoq");
-		proc->addArgument( QString::number(pref->autoq) );
+		vf << "pp";
 	}
+	// -autoq is only used by pp. Pass it always, so pp can
+	// be added later without restarting mplayer.
+	options << "-autoq" << QString::number(pref->autoq);
 
 
 	// Letterbox (expand)
 	if ((mset.add_letterbox) || (pref->fullscreen && pref->add_blackborders_on_fullscreen)) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( QString("expand=:::::%1,harddup").arg( DesktopInfo::desktop_aspectRatio(mplayerwindow)) );
+		vf << QString("expand=:::::%1,harddup").arg( DesktopInfo::desktop_aspectRatio(mplayerwindow));
 		// Note: on some videos (h264 for instance) the subtitles doesn't disappear, 
 		// appearing the new ones on top of the old ones. It seems adding another 
 		// filter after expand fixes the problem. I chose harddup 'cos I think 
@@ -1960,106 +2085,82 @@ void Core::startMplayer( QString file, double seek ) {
 
 	// Software equalizer
 	if ( (pref->use_soft_video_eq) ) {
-		proc->addArgument("-vf-add");
 		QString eq_filter = "eq2,hue";
 		if ( (pref->vo == "gl") || (pref->vo == "gl2")
 #ifdef Q_OS_WIN
              || (pref->vo == "directx:noaccel")
 #endif
 		    ) eq_filter += ",scale";
-		proc->addArgument(eq_filter);
+		vf << eq_filter;
 	}
 
 	// Additional video filters, supplied by user
 	// File
 	if ( !mset.mplayer_additional_video_filters.isEmpty() ) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( mset.mplayer_additional_video_filters );
+		vf << mset.mplayer_additional_video_filters;
 	}
 	// Global
 	if ( !pref->mplayer_additional_video_filters.isEmpty() ) {
-		proc->addArgument("-vf-add");
-		proc->addArgument( pref->mplayer_additional_video_filters );
+		vf << pref->mplayer_additional_video_filters;
 	}
 
 	// Filters for subtitles on screenshots
 	if ((screenshot_enabled) && (pref->subtitles_on_screenshots)) 
 	{
 		if (pref->use_ass_subtitles) {
-			proc->addArgument("-vf-add");
-			proc->addArgument("ass");
+			vf << "ass";
 		} else {
-			proc->addArgument("-vf-add");
-			proc->addArgument("expand=osd=1");
-			//proc->addArgument("-noslices");
-			force_noslices = true;
+			vf << "expand=osd=1";
+			options << "-noslices";
 		}
 	}
 
 	// Rotate
 	if (mset.rotate != MediaSettings::NoRotate) {
-		proc->addArgument( "-vf-add" );
-		proc->addArgument( QString("rotate=%1").arg(mset.rotate) );
+		vf << QString("rotate=%1").arg(mset.rotate);
 	}
 
 	// Flip
 	if (mset.flip) {
-		proc->addArgument( "-vf-add" );
 		// expand + flip doesn't work well, a workaround is to add another
 		// filter between them, so that's why harddup is here
-		proc->addArgument("harddup,flip");
+		vf << "harddup,flip";
 	}
 
 	// Mirror
 	if (mset.mirror) {
-		proc->addArgument( "-vf-add" );
-		proc->addArgument("mirror");
+		vf << "mirror";
 	}
 
 	// Screenshots
 	if (screenshot_enabled)	{
-		proc->addArgument("-vf-add");
-		proc->addArgument("screenshot");
-	}
-
-end_video_filters:
-
-	// slices
-	if ((pref->use_slices) && (!force_noslices)) {
-		proc->addArgument("-slices");
-	} else {
-		proc->addArgument("-noslices");
+		vf << "screenshot";
 	}
 
+	return vf;
+}
 
-	// Audio channels
-	if (mset.audio_use_channels != 0) {
-		proc->addArgument("-channels");
-		proc->addArgument( QString::number( mset.audio_use_channels ) );
-	}
+QStringList Core::audioFilters() {
+	QStringList af;
 
-	// Audio filters
-	QString af="";
 	if (mset.karaoke_filter) {
-		af="karaoke";
+		af << "karaoke";
 	}
 
 	// Stereo mode
 	if (mset.stereo_mode != 0) {
 		if (mset.stereo_mode == MediaSettings::Left) 
-			af += "channels=2:2:0:1:0:0";
+			af << "channels=2:2:0:1:0:0";
 		else
-			af += "channels=2:2:1:0:1:1";
+			af << "channels=2:2:1:0:1:1";
 	}
 
 	if (mset.extrastereo_filter) {
-		if (!af.isEmpty()) af += ",";
-		af += "extrastereo";
+		af << "extrastereo";
 	}
 
 	if (mset.volnorm_filter) {
-		if (!af.isEmpty()) af += ",";
-		af += pref->filters->item("volnorm").filter();
+		af << pref->filters->item("volnorm").filter();
 	}
 
 	bool use_scaletempo = (pref->use_scaletempo == Preferences::Enabled);
@@ -2067,115 +2168,94 @@ end_video_filters:
 		use_scaletempo = (MplayerVersion::isMplayerAtLeast(24924));
 	}
 	if (use_scaletempo) {
-		if (!af.isEmpty()) af += ",";
-		af += "scaletempo";
+		af << "scaletempo";
 	}
 
 	// Audio equalizer
 	if (pref->use_audio_equalizer) {
-		if (!af.isEmpty()) af += ",";
-		af += "equalizer=" + Helper::equalizerListToString(mset.audio_equalizer);
+		af << "equalizer=" + Helper::equalizerListToString(mset.audio_equalizer);
 	}
 
 
 	// Additional audio filters, supplied by user
 	// File
 	if ( !pref->mplayer_additional_audio_filters.isEmpty() ) {
-		if (!af.isEmpty()) af += ",";
-		af += pref->mplayer_additional_audio_filters;
+		af << pref->mplayer_additional_audio_filters;
 	}
 	// Global
 	if ( !mset.mplayer_additional_audio_filters.isEmpty() ) {
-		if (!af.isEmpty()) af += ",";
-		af += mset.mplayer_additional_audio_filters;
+		af << mset.mplayer_additional_audio_filters;
 	}
 
-	if (!af.isEmpty()) {
-		// Don't use audio filters if using the S/PDIF output
-		if (pref->use_hwac3) {
-			qDebug("Core::startMplayer: audio filters are disabled when using the S/PDIF output!");
-		} else {
-			proc->addArgument("-af");
-			proc->addArgument( af );
-		}
+	return af;
+}
+
+bool Core::mplayerHasCommand(const QString & command) {
+	if (mplayer_commands_bin != pref->mplayer_bin) {
+		InfoReader i(pref->mplayer_bin);
+		i.getCommands();
+		mplayer_commands = i.commandList();
+		mplayer_commands_bin = pref->mplayer_bin;
 	}
+	return mplayer_commands.contains(command);
+}
 
-	if (pref->use_soft_vol) {
-		proc->addArgument("-softvol");
-		proc->addArgument("-softvol-max");
-		proc->addArgument( QString::number(pref->softvol_max) );
+bool Core::changeFiltersLive() {
+	QStringList options;
+	QStringList vf = videoFilters(proc_screenshot_enabled, options);
+	if (options != proc_vf_options) {
+		qDebug("Core::changeFiltersLive: the filters need different options");
+		return false;
 	}
 
-	// Load edl file
-	if (pref->use_edl_files) {
-		QString edl_f;
-		QFileInfo f(file);
-		QString basename = f.path() + "/" + f.completeBaseName();
+	QStringList af;
+	if (!pref->use_hwac3) af = audioFilters();
 
-		if (QFile::exists(basename+".edl")) 
-			edl_f = basename+".edl";
-		else
-		if (QFile::exists(basename+".EDL")) 
-			edl_f = basename+".EDL";
+	QStringList vf_commands = vf_chain.commandsFor(vf);
+	QStringList af_commands = af_chain.commandsFor(af);
 
-		if (!edl_f.isEmpty()) {
-			proc->addArgument("-edl");
-			proc->addArgument(edl_f);
-		}
+	if ( (!vf_commands.isEmpty()) && 
+         ((!mplayerHasCommand("vf_add")) || (!mplayerHasCommand("vf_del"))) ) 
+	{
+		qDebug("Core::changeFiltersLive: mplayer can't change video filters");
+		return false;
 	}
 
-	// Additional options supplied by the user
-	// File
-	if (!mset.mplayer_additional_options.isEmpty()) {
-		QStringList args = MyProcess::splitArguments(mset.mplayer_additional_options);
-        QStringList::Iterator it = args.begin();
-        while( it != args.end() ) {
- 			proc->addArgument( (*it) );
-			++it;
-		}
-	}
-	// Global
-	if (!pref->mplayer_additional_options.isEmpty()) {
-		QStringList args = MyProcess::splitArguments(pref->mplayer_additional_options);
-        QStringList::Iterator it = args.begin();
-        while( it != args.end() ) {
- 			proc->addArgument( (*it) );
-			++it;
-		}
+	if ( (!af_commands.isEmpty()) && 
+         ((!mplayerHasCommand("af_add")) || (!mplayerHasCommand("af_del"))) ) 
+	{
+		qDebug("Core::changeFiltersLive: mplayer can't change audio filters");
+		return false;
 	}
 
-	// File to play
-	if (url_is_playlist) {
-		proc->addArgument("-playlist");
+	QStringList commands = vf_commands + af_commands;
+	for (int n = 0; n < commands.count(); n++) {
+		qDebug("Core::changeFiltersLive: '%s'", commands[n].toUtf8().constData());
+		tellmp(commands[n]);
 	}
 
-#ifdef Q_OS_WIN
-	if (pref->use_short_pathnames)
-		proc->addArgument(Helper::shortPathName(file));
-	else
-#endif
-	proc->addArgument( file );
-
-	// It seems the loop option must be after the filename
-	if (mset.loop) {
-		proc->addArgument("-loop");
-		proc->addArgument("0");
-	}
+	// The slave commands don't report errors. If mplayer complains about
+	// a filter, filterChangeFailed() restarts it with these chains.
+	vf_chain.setFilters(vf);
+	af_chain.setFilters(af);
+	if (!commands.isEmpty()) proc_filters_changed = true;
+	return true;
+}
 
-	emit aboutToStartPlaying();
+void Core::filterChangeFailed(QString line) {
+	if (!proc_filters_changed) return;
 
-	QString commandline = proc->arguments().join(" ");
+	qDebug("Core::filterChangeFailed: '%s'", line.toUtf8().constData());
 
+	// vf_chain and af_chain don't match the running mplayer anymore
+	proc_filters_changed = false;
+	if (proc->isRunning()) restartPlay();
+}
 
-	//Log command
-	QString line_for_log = commandline + "\n";
-	emit logLineAvailable(line_for_log);
-	
-	if ( !proc->start() ) {
-	    // error handling
-		qWarning("Core::startMplayer: mplayer process didn't start");
-	}
+void Core::updateFilters() {
+	if ( (proc->isRunning()) && (changeFiltersLive()) ) return;
 
+	restartPlay();
 }
 
 void Core::stopMplayer() {
@@ -2382,7 +2462,7 @@ void Core::toggleFlip(bool b) {
 
 	if (mset.flip != b) {
 		mset.flip = b;
-		if (proc->isRunning()) restartPlay();
+		if (proc->isRunning()) updateFilters();
 	}
 }
 
@@ -2395,7 +2475,7 @@ void Core::toggleMirror(bool b) {
 
 	if (mset.mirror != b) {
 		mset.mirror = b;
-		if (proc->isRunning()) restartPlay();
+		if (proc->isRunning()) updateFilters();
 	}
 }
 
@@ -2408,12 +2488,7 @@ void Core::toggleKaraoke(bool b) {
 
 	if (b != mset.karaoke_filter) {
 		mset.karaoke_filter = b;
-		if (MplayerVersion::isMplayerAtLeast(31030)) {
-
-			if (b) tellmp("af_add karaoke"); else tellmp("af_del karaoke");
-		} else {
-			restartPlay();
-		}
+		updateFilters();
 	}
 }
 
@@ -2425,12 +2500,7 @@ void Core::toggleExtrastereo(bool b) {
 
 	if (b != mset.extrastereo_filter) {
 		mset.extrastereo_filter = b;
-		if (MplayerVersion::isMplayerAtLeast(31030)) {
-			// Change filter without restarting
-			if (b) tellmp("af_add extrastereo"); else tellmp("af_del extrastereo");
-		} else {
-			restartPlay();
-		}
+		updateFilters();
 	}
 }
 
@@ -2442,13 +2512,7 @@ void Core::toggleVolnorm(bool b) {
 
 	if (b != mset.volnorm_filter) {
 		mset.volnorm_filter = b;
-		if (MplayerVersion::isMplayerAtLeast(31030)) {
-			// Change filter without restarting
-			QString f = pref->filters->item("volnorm").filter();
-			if (b) tellmp("af_add " + f); else tellmp("af_del volnorm");
-		} else {
-			restartPlay();
-		}
+		updateFilters();
 	}
 }
 
@@ -2464,7 +2528,7 @@ void Core::setStereoMode(int mode) {
 
 	if (mode != mset.stereo_mode ) {
 		mset.stereo_mode = mode;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2478,7 +2542,7 @@ void Core::toggleAutophase( bool b ) {
 
 	if ( b != mset.phase_filter) {
 		mset.phase_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2490,7 +2554,7 @@ void Core::toggleDeblock(bool b) {
 
 	if ( b != mset.deblock_filter ) {
 		mset.deblock_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2502,7 +2566,7 @@ void Core::toggleDering(bool b) {
 
 	if ( b != mset.dering_filter) {
 		mset.dering_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2514,7 +2578,7 @@ void Core::toggleGradfun(bool b) {
 
 	if ( b != mset.gradfun_filter) {
 		mset.gradfun_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2526,7 +2590,7 @@ void Core::toggleNoise(bool b) {
 
 	if ( b!= mset.noise_filter ) {
 		mset.noise_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2538,7 +2602,7 @@ void Core::togglePostprocessing(bool b) {
 
 	if ( b != mset.postprocessing_filter ) {
 		mset.postprocessing_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2546,7 +2610,7 @@ void Core::changeDenoise(int id) {
 
 	if (id != mset.current_denoiser) {
 		mset.current_denoiser = id;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2554,7 +2618,7 @@ void Core::changeUnsharp(int id) {
 
 	if (id != mset.current_unsharp) {
 		mset.current_unsharp = id;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2562,7 +2626,7 @@ void Core::changeUpscale(bool b) {
 
 	if (mset.upscaling_filter != b) {
 		mset.upscaling_filter = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -2944,6 +3008,8 @@ void Core::setAudioEqualizer(AudioEqualizerList values, bool restart) {
 		if (!MplayerVersion::isMplayerAtLeast(32505))
 			command = "af_eq_set_bands ";
 		tellmp( command + Helper::equalizerListToString(values) );
+		// The equalizer has been changed in place
+		if (!pref->use_hwac3) af_chain.setFilters(audioFilters());
 	} else {
 		restartPlay();
 	}
@@ -3062,7 +3128,7 @@ void Core::changeDeinterlace(int ID) {
 
 	if (ID!=mset.current_deinterlacer) {
 		mset.current_deinterlacer = ID;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -3444,7 +3510,7 @@ void Core::changeLetterbox(bool b) {
 
 	if (mset.add_letterbox != b) {
 		mset.add_letterbox = b;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -3468,7 +3534,7 @@ void Core::changeRotate(int r) {
 
 	if (mset.rotate != r) {
 		mset.rotate = r;
-		restartPlay();
+		updateFilters();
 	}
 }
 
@@ -24,6 +24,7 @@
 #include "mediadata.h"
 #include "mediasettings.h"
 #include "mplayerprocess.h"
+#include "filterchain.h"
 #include "config.h"
 
 #ifndef NO_USE_INI_FILES
@@ -357,6 +358,7 @@ protected slots:
     
 	void displayMessage(QString text);
 	void displayScreenshotName(QString filename);
+	void filterChangeFailed(QString line);
 	void displayUpdatingFontCache();
 
 	void streamTitleChanged(QString);
@@ -418,6 +420,22 @@ protected:
 	//! Returns true if changing the subscale requires to restart mplayer
 	bool subscale_need_restart();
 
+	//! Returns the video filters for the current settings, in the order
+	//! they are passed with -vf-add. Other options needed by the filters
+	//! are added to \a options.
+	QStringList videoFilters(bool screenshot_enabled, QStringList & options);
+	QStringList audioFilters();
+
+	//! Changes the filters of the running mplayer with slave commands.
+	//! Returns false if mplayer has to be restarted instead.
+	bool changeFiltersLive();
+
+	//! Applies the current filter settings, restarting mplayer
+	//! only if it's necessary.
+	void updateFilters();
+
+	bool mplayerHasCommand(const QString & command);
+
 signals:
 	void aboutToStartPlaying(); // Signal emited just before to start mplayer
 	void mediaLoaded();
@@ -490,6 +508,18 @@ private:
 
 	QString initial_subtitle;
 
+	// Filters of the running mplayer
+	FilterChain vf_chain;
+	FilterChain af_chain;
+	QStringList proc_vf_options;
+	bool proc_screenshot_enabled;
+	// Filters were changed with slave commands since mplayer was started
+	bool proc_filters_changed;
+
+	// Slave commands supported by mplayer_commands_bin
+	QStringList mplayer_commands;
+	QString mplayer_commands_bin;
+
 #if DVDNAV_SUPPORT
 	bool dvdnav_title_is_menu;
 #endif
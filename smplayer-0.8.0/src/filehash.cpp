@@ -18,34 +18,91 @@
 
 #include "filehash.h"
 #include <QFile>
-#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#define HASH_CHUNK_SIZE 65536
+#define HASH_MEMO_MAX 1000
+
+struct FileHashMemo {
+	qint64 size;
+	uint mtime;
+	QString hash;
+};
+
+static QHash<QString, FileHashMemo> hash_memo;
+static QMutex hash_memo_mutex;
+
+// Sums the complete little endian 64-bit words of the chunk.
+// A trailing partial word is ignored, as it always has been.
+quint64 FileHash::sumChunk(const char * data, qint64 len) {
+	quint64 sum = 0;
+	qint64 words = len / 8;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	// Plain loop over aligned words, the compiler can vectorize it
+	const quint64 * w = reinterpret_cast<const quint64 *>(data);
+	for (qint64 i = 0; i < words; i++) sum += w[i];
+#else
+	const uchar * p = reinterpret_cast<const uchar *>(data);
+	for (qint64 i = 0; i < words; i++) sum += qFromLittleEndian<quint64>(p + i * 8);
+#endif
+	return sum;
+}
 
 // From the patch by Kamil Dziobek turbos11(at)gmail.com
 // (c) Kamil Dziobek turbos11(at)gmail.com | BSD or GPL or public domain
 QString FileHash::calculateHash(QString filename) {
-	QFile file(filename);
+	QFileInfo fi(filename);
 
-	if (!file.exists()) {
+	if (!fi.exists()) {
 		qWarning("OSParser:calculateHash: error hashing file. File doesn't exist.");
 		return QString();
 	}
 
-	file.open(QIODevice::ReadOnly);
-	QDataStream in(&file);
-	in.setByteOrder(QDataStream::LittleEndian);
-	quint64 size=file.size ();
-	quint64 hash=size; 
-	quint64 a;
-	for(int i = 0; i < 8192; i++) {
-		in >> a ; hash += a;
-	};
-	file.seek(size-65536);
-	for(int i = 0; i < 8192; i++) {
-		in >> a ; hash += a;
-	};
+	qint64 size = fi.size();
+	uint mtime = fi.lastModified().toTime_t();
+
+	{
+		QMutexLocker locker(&hash_memo_mutex);
+		QHash<QString, FileHashMemo>::const_iterator it = hash_memo.constFind(filename);
+		if ((it != hash_memo.constEnd()) && (it->size == size) && (it->mtime == mtime)) {
+			return it->hash;
+		}
+	}
+
+	quint64 hash = size;
+
+	QFile file(filename);
+	if (file.open(QIODevice::ReadOnly)) {
+		// quint64 buffer, so the words are aligned
+		quint64 buffer[HASH_CHUNK_SIZE / 8];
+		char * data = reinterpret_cast<char *>(buffer);
+
+		// Head of the file
+		qint64 len = file.read(data, HASH_CHUNK_SIZE);
+		if (len > 0) hash += sumChunk(data, len);
+
+		// Tail of the file (only if the file is big enough to have one)
+		if ((size >= HASH_CHUNK_SIZE) && (file.seek(size - HASH_CHUNK_SIZE))) {
+			len = file.read(data, HASH_CHUNK_SIZE);
+			if (len > 0) hash += sumChunk(data, len);
+		}
+	}
 
 	QString hexhash = QString("%1").arg(hash, 16, 16, QChar('0'));
 
+	FileHashMemo m;
+	m.size = size;
+	m.mtime = mtime;
+	m.hash = hexhash;
+
+	QMutexLocker locker(&hash_memo_mutex);
+	if (hash_memo.count() >= HASH_MEMO_MAX) hash_memo.clear();
+	hash_memo.insert(filename, m);
+
 	return hexhash;
 }
-
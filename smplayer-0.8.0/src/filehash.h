@@ -25,7 +25,12 @@ class FileHash
 {
 public:
 
+	//! Returns the hash of the file. Results are remembered for as long
+	//! as the size and modification time of the file don't change.
 	static QString calculateHash(QString filename);
+
+private:
+	static quint64 sumChunk(const char * data, qint64 len);
 };
 
 #endif
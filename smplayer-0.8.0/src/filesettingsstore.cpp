@@ -0,0 +1,345 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "filesettingsstore.h"
+#include "mediasettings.h"
+#include "filehash.h"
+#include <QSettings>
+#include <QVariant>
+#include <QStringList>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#define STORE_MAGIC 0x534d4653
+#define STORE_VERSION 1
+
+#define HEADER_SIZE 8         // magic + version
+#define RECORD_HEADER_SIZE 16 // key + capacity + length
+#define CAPACITY_ROUND 256
+
+static bool readNothing(QIODevice &, QSettings::SettingsMap &) { return true; }
+static bool writeNothing(QIODevice &, const QSettings::SettingsMap &) { return true; }
+
+FileSettingsStore::FileSettingsStore(QString directory) : FileSettingsBase(directory)
+{
+	store_file = directory + "/file_settings.dat";
+
+	QDir d;
+	if (!d.exists(directory)) d.mkpath(directory);
+
+	// MediaSettings can only be loaded from and saved to a QSettings.
+	// This one is only used to convert them from and to a QVariantMap:
+	// its format neither reads nor writes anything and it points
+	// to a directory, so it never touches the disk.
+	static QSettings::Format scratch_format = QSettings::registerFormat("scratch", readNothing, writeNothing);
+	scratch = new QSettings(directory, scratch_format);
+
+	load();
+}
+
+FileSettingsStore::~FileSettingsStore() {
+	delete scratch;
+}
+
+// Returns 0 if there's no valid hash. 0 is also used to mark
+// free records, but only an empty file would have that hash.
+quint64 FileSettingsStore::key(const QString & filename, QString * hash) {
+	QString h = FileHash::calculateHash(filename);
+	if (hash != 0) (*hash) = h;
+	if (h.isEmpty()) return 0;
+
+	bool ok;
+	quint64 k = h.toULongLong(&ok, 16);
+	return ok ? k : 0;
+}
+
+// Settings saved by FileSettingsHash, loaded if there's nothing in the store yet
+QString FileSettingsStore::legacyFile(const QString & hash) {
+	return output_directory + "/file_settings/" + hash[0] + "/" + hash + ".ini";
+}
+
+void FileSettingsStore::load() {
+	index.clear();
+	free_slots.clear();
+
+	QFile f(store_file);
+	if (!f.open(QIODevice::ReadOnly)) {
+		rememberFileState();
+		return;
+	}
+
+	QDataStream in(&f);
+	in.setVersion(QDataStream::Qt_4_2);
+
+	quint32 magic, version;
+	in >> magic >> version;
+	if ((in.status() != QDataStream::Ok) || (magic != STORE_MAGIC) || (version != STORE_VERSION)) {
+		qWarning("FileSettingsStore::load: '%s' is not valid, starting a new one", store_file.toUtf8().constData());
+		f.close();
+		QFile::resize(store_file, 0);
+		rememberFileState();
+		return;
+	}
+
+	qint64 file_size = f.size();
+	qint64 pos = HEADER_SIZE;
+	while (pos + RECORD_HEADER_SIZE <= file_size) {
+		quint64 k;
+		Slot s;
+		f.seek(pos);
+		in >> k >> s.capacity >> s.length;
+		if ((in.status() != QDataStream::Ok) || (s.length > s.capacity) ||
+            (pos + RECORD_HEADER_SIZE + s.capacity > file_size))
+		{
+			// Probably a record truncated by a crash
+			break;
+		}
+		s.pos = pos;
+		if (k == 0) {
+			free_slots.append(s);
+		} else {
+			if (index.contains(k)) free_slots.append(index.value(k));
+			index.insert(k, s);
+		}
+		pos += RECORD_HEADER_SIZE + s.capacity;
+	}
+	f.close();
+
+	qDebug("FileSettingsStore::load: %d entries, %d free records", index.count(), free_slots.count());
+
+	if (pos < file_size) {
+		qWarning("FileSettingsStore::load: discarding %lld damaged bytes", file_size - pos);
+		QFile::resize(store_file, pos);
+	}
+	rememberFileState();
+}
+
+void FileSettingsStore::rememberFileState() {
+	QFileInfo fi(store_file);
+	store_size = fi.size();
+	store_mtime = fi.lastModified();
+}
+
+// Other instances of smplayer may have written to the file
+// since the index was built
+void FileSettingsStore::reloadIfChanged() {
+	QFileInfo fi(store_file);
+	if ((fi.size() != store_size) || (fi.lastModified() != store_mtime)) {
+		qDebug("FileSettingsStore::reloadIfChanged: '%s' has changed, reloading it", store_file.toUtf8().constData());
+		load();
+	}
+}
+
+// Checks that the record at s.pos is still the one in the index.
+// The length of a free record doesn't matter.
+bool FileSettingsStore::checkRecord(QFile & f, const Slot & s, quint64 key) {
+	if (!f.seek(s.pos)) return false;
+
+	QDataStream in(&f);
+	in.setVersion(QDataStream::Qt_4_2);
+	quint64 k;
+	quint32 capacity, length;
+	in >> k >> capacity >> length;
+	return ((in.status() == QDataStream::Ok) && (k == key) && (capacity == s.capacity) &&
+            ((key == 0) || (length == s.length)));
+}
+
+// Finds the record of key and leaves f at the start of its data.
+// The mtime of the file has a resolution of one second, so a change
+// may have gone unnoticed: if the record doesn't match the index,
+// the index is built again.
+bool FileSettingsStore::findRecord(QFile & f, quint64 key, Slot & s) {
+	QHash<quint64, Slot>::const_iterator it = index.constFind(key);
+	if (it == index.constEnd()) return false;
+
+	s = *it;
+	if (checkRecord(f, s, key)) return true;
+
+	qWarning("FileSettingsStore::findRecord: the index is out of date, reloading it");
+	load();
+	it = index.constFind(key);
+	if (it == index.constEnd()) return false;
+
+	s = *it;
+	return checkRecord(f, s, key);
+}
+
+bool FileSettingsStore::takeFreeSlot(quint32 length, Slot & s) {
+	int best = -1;
+	for (int n = 0; n < free_slots.count(); n++) {
+		if ((free_slots[n].capacity >= length) &&
+            ((best == -1) || (free_slots[n].capacity < free_slots[best].capacity)))
+		{
+			best = n;
+		}
+	}
+	if (best == -1) return false;
+
+	s = free_slots.takeAt(best);
+	return true;
+}
+
+bool FileSettingsStore::writeRecord(QFile & f, const Slot & s, quint64 key, const QByteArray & data) {
+	if (!f.seek(s.pos)) return false;
+
+	QDataStream out(&f);
+	out.setVersion(QDataStream::Qt_4_2);
+	out << key << s.capacity << s.length;
+	if (!data.isEmpty()) {
+		if (f.write(data) != data.size()) return false;
+	}
+
+	// Reserve the whole record at the end of the file
+	qint64 end = s.pos + RECORD_HEADER_SIZE + s.capacity;
+	if ((f.size() < end) && (!f.resize(end))) return false;
+
+	return (out.status() == QDataStream::Ok);
+}
+
+QByteArray FileSettingsStore::toData(MediaSettings & mset) {
+	scratch->clear();
+	mset.save(scratch);
+
+	QVariantMap m;
+	QStringList keys = scratch->allKeys();
+	for (int n = 0; n < keys.count(); n++) {
+		m.insert(keys[n], scratch->value(keys[n]));
+	}
+	scratch->clear();
+
+	QByteArray data;
+	QDataStream out(&data, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_4_2);
+	out << m;
+	return data;
+}
+
+bool FileSettingsStore::fromData(const QByteArray & data, MediaSettings & mset) {
+	QVariantMap m;
+	QDataStream in(data);
+	in.setVersion(QDataStream::Qt_4_2);
+	in >> m;
+	if (in.status() != QDataStream::Ok) return false;
+
+	scratch->clear();
+	QVariantMap::const_iterator it = m.constBegin();
+	for (; it != m.constEnd(); ++it) {
+		scratch->setValue(it.key(), it.value());
+	}
+	mset.load(scratch);
+	scratch->clear();
+	return true;
+}
+
+bool FileSettingsStore::existSettingsFor(QString filename) {
+	QString hash;
+	quint64 k = key(filename, &hash);
+	if (k == 0) return false;
+
+	reloadIfChanged();
+
+	return (index.contains(k) || QFile::exists(legacyFile(hash)));
+}
+
+void FileSettingsStore::loadSettingsFor(QString filename, MediaSettings & mset) {
+	mset.reset();
+
+	QString hash;
+	quint64 k = key(filename, &hash);
+	if (k == 0) return;
+
+	reloadIfChanged();
+
+	QFile f(store_file);
+	Slot s;
+	if ((f.open(QIODevice::ReadOnly)) && (findRecord(f, k, s))) {
+		QByteArray data = f.read(s.length);
+		if ((data.size() != (int) s.length) || (!fromData(data, mset))) {
+			qWarning("FileSettingsStore::loadSettingsFor: damaged record for '%s'", filename.toUtf8().constData());
+			mset.reset();
+		}
+	}
+	else {
+		QString legacy_file = legacyFile(hash);
+		if (QFile::exists(legacy_file)) {
+			QSettings settings(legacy_file, QSettings::IniFormat);
+			settings.beginGroup("file_settings");
+			mset.load(&settings);
+			settings.endGroup();
+		}
+	}
+}
+
+void FileSettingsStore::saveSettingsFor(QString filename, MediaSettings & mset) {
+	quint64 k = key(filename);
+	if (k == 0) return;
+
+	QByteArray data = toData(mset);
+
+	reloadIfChanged();
+
+	QFile f(store_file);
+	if (!f.open(QIODevice::ReadWrite)) {
+		qWarning("FileSettingsStore::saveSettingsFor: can't open '%s'", store_file.toUtf8().constData());
+		return;
+	}
+
+	if (f.size() < HEADER_SIZE) {
+		QDataStream out(&f);
+		out.setVersion(QDataStream::Qt_4_2);
+		out << (quint32) STORE_MAGIC << (quint32) STORE_VERSION;
+	}
+
+	Slot s;
+	bool found = findRecord(f, k, s);
+	if ((found) && (s.capacity >= (quint32) data.size())) {
+		// Update in place
+	} else {
+		if (found) {
+			// Doesn't fit, free the old record
+			Slot old = s;
+			old.length = 0;
+			index.remove(k);
+			if (writeRecord(f, old, 0, QByteArray())) free_slots.append(old);
+		}
+		bool have_slot = false;
+		while ((!have_slot) && (takeFreeSlot(data.size(), s))) {
+			// Skip the free records reused by another instance
+			have_slot = checkRecord(f, s, 0);
+		}
+		if (!have_slot) {
+			// Append a new record with some room to grow
+			s.pos = f.size();
+			s.capacity = data.size() + data.size() / 4;
+			s.capacity = (s.capacity + CAPACITY_ROUND - 1) / CAPACITY_ROUND * CAPACITY_ROUND;
+		}
+	}
+	s.length = data.size();
+
+	if (writeRecord(f, s, k, data)) {
+		index.insert(k, s);
+	} else {
+		qWarning("FileSettingsStore::saveSettingsFor: error writing '%s'", store_file.toUtf8().constData());
+		index.remove(k);
+	}
+
+	f.close();
+	rememberFileState();
+}
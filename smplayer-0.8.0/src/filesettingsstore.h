@@ -0,0 +1,79 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef _FILESETTINGS_STORE_H_
+#define _FILESETTINGS_STORE_H_
+
+#include "filesettingsbase.h"
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <QDateTime>
+
+class QFile;
+class QSettings;
+
+/*!
+ The settings of all files are kept in a single binary file, indexed in
+ memory by the FileHash of the file. Every record reserves some extra
+ space so the settings can usually be updated in place; when they don't
+ fit anymore the record is freed and reused later for other settings.
+*/
+
+class FileSettingsStore : public FileSettingsBase
+{
+public:
+	FileSettingsStore(QString directory);
+	virtual ~FileSettingsStore();
+
+	virtual bool existSettingsFor(QString filename);
+
+	virtual void loadSettingsFor(QString filename, MediaSettings & mset);
+
+	virtual void saveSettingsFor(QString filename, MediaSettings & mset);
+
+private:
+	struct Slot {
+		qint64 pos;       // position of the record in the file
+		quint32 capacity; // bytes reserved for the data
+		quint32 length;   // bytes used by the data
+	};
+
+	static quint64 key(const QString & filename, QString * hash = 0);
+	QString legacyFile(const QString & hash);
+
+	void load();
+	void rememberFileState();
+	void reloadIfChanged();
+	bool findRecord(QFile & f, quint64 key, Slot & s);
+	bool takeFreeSlot(quint32 length, Slot & s);
+	static bool checkRecord(QFile & f, const Slot & s, quint64 key);
+	static bool writeRecord(QFile & f, const Slot & s, quint64 key, const QByteArray & data);
+
+	QByteArray toData(MediaSettings & mset);
+	bool fromData(const QByteArray & data, MediaSettings & mset);
+
+	QString store_file;
+	QHash<quint64, Slot> index;
+	QList<Slot> free_slots;
+	qint64 store_size;      // size and modification time of the file
+	QDateTime store_mtime;  // when the index was built
+	QSettings * scratch;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "filterchain.h"
+
+FilterChain::FilterChain(const QString & type) {
+	this->type = type;
+}
+
+void FilterChain::setFilters(const QStringList & filters) {
+	chain = split(filters);
+}
+
+QStringList FilterChain::split(const QStringList & filters) {
+	QStringList l;
+	for (int n = 0; n < filters.count(); n++) {
+		QStringList parts = filters[n].split(",", QString::SkipEmptyParts);
+		for (int i = 0; i < parts.count(); i++) {
+			QString f = parts[i].trimmed();
+			if (!f.isEmpty()) l.append(f);
+		}
+	}
+	return l;
+}
+
+QString FilterChain::filterName(const QString & filter) {
+	int pos = filter.indexOf('=');
+	if (pos == -1) return filter;
+	return filter.left(pos);
+}
+
+QStringList FilterChain::commandsFor(const QStringList & new_filters) const {
+	QStringList wanted = split(new_filters);
+
+	// New filters are inserted at the start of the chain, so
+	// the filters at the end which don't change can be kept
+	int kept = 0;
+	while ( (kept < chain.count()) && (kept < wanted.count()) &&
+            (chain[chain.count() - 1 - kept] == wanted[wanted.count() - 1 - kept]) ) 
+	{
+		kept++;
+	}
+
+	QStringList commands;
+
+	// Remove the filters in front of them, from the first one. This way
+	// the first filter with a name is always the one to be removed.
+	for (int n = 0; n < chain.count() - kept; n++) {
+		commands.append(type + "_del " + filterName(chain[n]));
+	}
+
+	// Add the new ones from the last one, every filter goes
+	// in front of the previous
+	for (int n = wanted.count() - kept - 1; n >= 0; n--) {
+		commands.append(type + "_add " + wanted[n]);
+	}
+
+	return commands;
+}
@@ -0,0 +1,60 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef _FILTERCHAIN_H_
+#define _FILTERCHAIN_H_
+
+#include <QStringList>
+
+//! Keeps track of the video or audio filters of a running mplayer.
+/*!
+ It computes the vf_add/vf_del (or af_add/af_del) slave commands
+ needed to change the filters without restarting mplayer.
+ A filter added with one of these commands goes to the start of the
+ chain, and a delete removes the first filter with the given name.
+*/
+class FilterChain
+{
+public:
+	//! \a type is the prefix of the slave commands, "vf" or "af".
+	FilterChain(const QString & type);
+
+	//! Sets the filters mplayer is using right now. Every entry
+	//! can have several filters separated by commas, like the
+	//! arguments of -vf-add or -af.
+	void setFilters(const QStringList & filters);
+	QStringList filters() const { return chain; };
+
+	void clear() { chain.clear(); };
+
+	//! Returns the slave commands that change the current filters
+	//! into \a new_filters. The list is empty if there's nothing to do.
+	QStringList commandsFor(const QStringList & new_filters) const;
+
+	//! Splits the entries into single filters.
+	static QStringList split(const QStringList & filters);
+
+	//! Returns the name of the filter, without its parameters.
+	static QString filterName(const QString & filter);
+
+protected:
+	QString type;
+	QStringList chain;
+};
+
+#endif
@@ -20,12 +20,17 @@
 #include "global.h"
 #include "preferences.h"
 #include "mplayerprocess.h"
+#include "mediainfocache.h"
+#include "paths.h"
 #include <QFileInfo>
+#include <QThread>
 
-MediaData InfoProvider::getInfo(QString mplayer_bin, QString filename) {
-
-	MplayerProcess proc;
+MediaInfoCache * InfoProvider::cache() {
+	static MediaInfoCache c(Paths::configPath() + "/media_info.cache");
+	return &c;
+}
 
+void InfoProvider::setupProcess(MplayerProcess & proc, QString mplayer_bin, const QString & filename) {
 	QFileInfo fi(mplayer_bin);
     if (fi.exists() && fi.isExecutable() && !fi.isDir()) {
         mplayer_bin = fi.absoluteFilePath();
@@ -40,15 +45,77 @@ MediaData InfoProvider::getInfo(QString mplayer_bin, QString filename) {
 	proc.addArgument("-ao");
 	proc.addArgument("null");
 	proc.addArgument(filename);
+}
+
+MediaData InfoProvider::getInfo(QString mplayer_bin, QString filename) {
+	MediaData data;
+	if (cache()->lookup(filename, data)) {
+		return data;
+	}
+
+	MplayerProcess proc;
+	setupProcess(proc, mplayer_bin, filename);
 
 	proc.start();
 	if (!proc.waitForFinished()) {
 		proc.kill();
+		return proc.mediaData();
 	}
 
-	return proc.mediaData();
+	data = proc.mediaData();
+	cache()->insert(filename, data);
+	return data;
 }
 
 MediaData InfoProvider::getInfo(QString filename) {
 	return getInfo( Global::pref->mplayer_bin, filename );
 }
+
+QList<MediaData> InfoProvider::getInfo(QString mplayer_bin, QStringList filenames) {
+	QList<MediaData> result;
+	QList<int> missing;
+
+	for (int n = 0; n < filenames.count(); n++) {
+		MediaData data;
+		if (!cache()->lookup(filenames[n], data)) missing.append(n);
+		result.append(data);
+	}
+
+	qDebug("InfoProvider::getInfo: %d files, %d not in cache", filenames.count(), missing.count());
+
+	// Probe the remaining files, keeping up to one mplayer per processor
+	// running. The results are collected in order.
+	int max_processes = qMax(1, QThread::idealThreadCount());
+	QList<MplayerProcess *> running;
+	QList<int> running_index;
+	int next = 0;
+
+	while ((next < missing.count()) || (!running.isEmpty())) {
+		while ((next < missing.count()) && (running.count() < max_processes)) {
+			MplayerProcess * proc = new MplayerProcess;
+			setupProcess(*proc, mplayer_bin, filenames[missing[next]]);
+			proc->start();
+			running.append(proc);
+			running_index.append(missing[next]);
+			next++;
+		}
+
+		MplayerProcess * proc = running.takeFirst();
+		int n = running_index.takeFirst();
+		if (proc->waitForFinished()) {
+			result[n] = proc->mediaData();
+			cache()->insert(filenames[n], result[n]);
+		} else {
+			proc->kill();
+			proc->waitForFinished();
+			result[n] = proc->mediaData();
+		}
+		delete proc;
+	}
+
+	return result;
+}
+
+QList<MediaData> InfoProvider::getInfo(QStringList filenames) {
+	return getInfo( Global::pref->mplayer_bin, filenames );
+}
@@ -22,8 +22,13 @@
 #define _INFOPROVIDER_H_
 
 #include <QString>
+#include <QStringList>
+#include <QList>
 #include "mediadata.h"
 
+class MplayerProcess;
+class MediaInfoCache;
+
 class InfoProvider 
 {
 
@@ -34,6 +39,17 @@ public:
 	//! Gets info about the specified filename. The mplayer executable will be
     // obtained from the global preferences.
 	static MediaData getInfo(QString filename);
+
+	//! Gets info about several files. Files not found in the cache
+	// are probed by several mplayer processes at the same time.
+	static QList<MediaData> getInfo(QString mplayer_bin, QStringList filenames);
+
+	//! Same as above, using the mplayer executable from the global preferences.
+	static QList<MediaData> getInfo(QStringList filenames);
+
+protected:
+	static void setupProcess(MplayerProcess & proc, QString mplayer_bin, const QString & filename);
+	static MediaInfoCache * cache();
 };
 
 #endif
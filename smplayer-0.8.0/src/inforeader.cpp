@@ -40,6 +40,7 @@ using namespace Global;
 #define DEMUXER 3
 #define VC 4
 #define AC 5
+#define COMMANDS 6
 
 InfoReader * InfoReader::static_obj = 0;
 
@@ -55,6 +56,8 @@ InfoReader::InfoReader( QString mplayer_bin, QObject * parent )
 	: QObject(parent)
 {
 	mplayerbin = mplayer_bin;
+	waiting_for_key = TRUE;
+	reading_type = NOME;
 
 #if USE_QPROCESS
 	proc = new QProcess(this);
@@ -82,6 +85,21 @@ void InfoReader::getInfo() {
 	//list();
 }
 
+void InfoReader::getCommands() {
+	command_list.clear();
+
+	// The output of -input cmdlist has no key line
+	waiting_for_key = FALSE;
+	reading_type = COMMANDS;
+
+	run("-input cmdlist");
+
+	reading_type = NOME;
+	waiting_for_key = TRUE;
+
+	qDebug("InfoReader::getCommands: %d commands", command_list.count());
+}
+
 void InfoReader::list() {
     qDebug("InfoReader::list");
 
@@ -113,6 +131,7 @@ static QRegExp rx_vc_key("^ID_VIDEO_CODECS");
 
 static QRegExp rx_driver("\\t(.*)\\t(.*)");
 static QRegExp rx_demuxer("^\\s+([A-Z,a-z,0-9]+)\\s+(\\d+)\\s+(\\S.*)");
+static QRegExp rx_command("^([a-z][a-z0-9_]*)\\s+");
 static QRegExp rx_codec("^([A-Z,a-z,0-9]+)\\s+([A-Z,a-z,0-9]+)\\s+([A-Z,a-z,0-9]+)\\s+(\\S.*)");
 
 void InfoReader::readLine(QByteArray ba) {
@@ -125,6 +144,13 @@ void InfoReader::readLine(QByteArray ba) {
     qDebug("InfoReader::readLine: line: '%s'", line.toUtf8().data());
     //qDebug("waiting_for_key: %d", waiting_for_key);
 
+	if (reading_type == COMMANDS) {
+		if ( rx_command.indexIn(line) > -1 ) {
+			command_list.append( rx_command.cap(1) );
+		}
+		return;
+	}
+
 	if (!waiting_for_key) {
 		if ( rx_driver.indexIn(line) > -1 ) {
 			QString name = rx_driver.cap(1);
@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QStringList>
 
 #define USE_QPROCESS 1
 
@@ -64,11 +65,15 @@ public:
 
 	void getInfo();
 
+	//! Reads the list of slave commands supported by mplayer.
+	void getCommands();
+
 	InfoList voList() { return vo_list; };
 	InfoList aoList() { return ao_list; };
 	InfoList demuxerList() { return demuxer_list; };
 	InfoList vcList() { return vc_list; };
 	InfoList acList() { return ac_list; };
+	QStringList commandList() { return command_list; };
 
 	int mplayerVersion() { return mplayer_svn; };
 
@@ -96,6 +101,7 @@ protected:
 	InfoList demuxer_list;
 	InfoList vc_list;
 	InfoList ac_list;
+	QStringList command_list;
 
 	int mplayer_svn;
 
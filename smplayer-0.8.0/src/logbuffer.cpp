@@ -0,0 +1,99 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "logbuffer.h"
+
+LogBuffer::LogBuffer(int max_size) {
+	this->max_size = max_size;
+	bytes = 0;
+	end_line = 0;
+}
+
+void LogBuffer::setMaxSize(int max_size) {
+	this->max_size = max_size;
+	shrink();
+}
+
+void LogBuffer::append(const QString & line) {
+	if ( (chunks.isEmpty()) || (chunks.last().text.size() >= CHUNK_SIZE) ) {
+		Chunk c;
+		c.first_line = end_line;
+		c.text.reserve(CHUNK_SIZE + line.size());
+		chunks.append(c);
+	}
+
+	Chunk & c = chunks.last();
+	c.offsets.append(c.text.size());
+	c.text.append(line);
+
+	bytes += line.size() * sizeof(QChar);
+	end_line++;
+
+	shrink();
+}
+
+void LogBuffer::shrink() {
+	// The last chunk is always kept, even if it's too big
+	while ( (bytes > max_size) && (chunks.count() > 1) ) {
+		bytes -= chunks.first().text.size() * sizeof(QChar);
+		chunks.removeFirst();
+	}
+}
+
+void LogBuffer::clear() {
+	chunks.clear();
+	bytes = 0;
+	end_line = 0;
+}
+
+int LogBuffer::firstLine() const {
+	if (chunks.isEmpty()) return end_line;
+	return chunks.first().first_line;
+}
+
+QString LogBuffer::text() const {
+	return textFrom(firstLine());
+}
+
+QString LogBuffer::textFrom(int line) const {
+	QString s;
+	if (line >= end_line) return s;
+
+	int first = 0;
+	int offset = 0;
+
+	if (line > firstLine()) {
+		// Look for the chunk with the line, starting from the newest
+		// ones, as the line is usually recent
+		first = chunks.count() - 1;
+		while (chunks[first].first_line > line) first--;
+		offset = chunks[first].offsets[line - chunks[first].first_line];
+	}
+
+	int len = chunks[first].text.size() - offset;
+	for (int n = first + 1; n < chunks.count(); n++) {
+		len += chunks[n].text.size();
+	}
+	s.reserve(len);
+
+	s.append( chunks[first].text.mid(offset) );
+	for (int n = first + 1; n < chunks.count(); n++) {
+		s.append( chunks[n].text );
+	}
+	return s;
+}
@@ -0,0 +1,82 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef _LOGBUFFER_H_
+#define _LOGBUFFER_H_
+
+#include <QString>
+#include <QList>
+#include <QVector>
+
+//! Keeps the last lines of a log within a fixed size.
+/*!
+ Lines are stored in chunks of about CHUNK_SIZE characters. When the
+ buffer grows over its maximum size the oldest chunk is dropped.
+ Lines are numbered from the last clear(), so a reader can ask only
+ for the lines it hasn't seen yet.
+*/
+class LogBuffer
+{
+public:
+	//! \a max_size is in bytes.
+	LogBuffer(int max_size = 4 * 1024 * 1024);
+
+	void setMaxSize(int max_size);
+	int maxSize() const { return max_size; };
+
+	//! Adds a line. It should include the line terminator.
+	void append(const QString & line);
+	void clear();
+
+	//! Returns the whole contents of the buffer.
+	QString text() const;
+
+	//! Returns the text from line number \a line. If that line has
+	//! already been dropped, the whole buffer is returned.
+	QString textFrom(int line) const;
+
+	//! Returns the number of the oldest line still in the buffer.
+	int firstLine() const;
+
+	//! Returns the number of the next line to be added.
+	int endLine() const { return end_line; };
+
+	//! Returns the bytes used by the text.
+	int size() const { return bytes; };
+
+	bool isEmpty() const { return (bytes == 0); };
+
+protected:
+	void shrink();
+
+protected:
+	struct Chunk {
+		QString text;
+		QVector<int> offsets; // Position of every line in text
+		int first_line;
+	};
+
+	QList<Chunk> chunks;
+	int max_size;
+	int bytes;
+	int end_line;
+
+	static const int CHUNK_SIZE = 64 * 1024;
+};
+
+#endif
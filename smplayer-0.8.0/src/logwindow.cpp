@@ -18,6 +18,7 @@
 
 #include "logwindow.h"
 #include <QTextEdit>
+#include <QTextDocument>
 #include "filedialog.h"
 #include <QFile>
 #include <QTextStream>
@@ -89,6 +90,11 @@ void LogWindow::appendHtml(QString text) {
 	browser->insertHtml(text);
 }
 
+void LogWindow::setMaximumLines(int lines) {
+	// The text ends with a line break, which leaves an empty block at the end
+	browser->document()->setMaximumBlockCount( (lines > 0) ? lines + 1 : 0 );
+}
+
 void LogWindow::on_copyButton_clicked() {
 	browser->selectAll();
 	browser->copy();
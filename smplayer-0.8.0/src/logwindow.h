@@ -42,6 +42,10 @@ public:
 	void appendText(QString text);
 	void appendHtml(QString text);
 
+	//! Older lines are removed when there are more than \a lines.
+	//! 0 means no limit.
+	void setMaximumLines(int lines);
+
 	/* QTextEdit * editor(); */
 
 protected:
@@ -0,0 +1,178 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "mediainfocache.h"
+#include "filehash.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+
+#define CACHE_MAGIC 0x534d4943
+#define CACHE_VERSION 1
+
+MediaInfoCache::MediaInfoCache(const QString & cache_file) {
+	this->cache_file = cache_file;
+	records = 0;
+	load();
+}
+
+MediaInfoCache::~MediaInfoCache() {
+}
+
+QString MediaInfoCache::key(const QString & filename, qint64 * mtime) {
+	QFileInfo fi(filename);
+	if (!fi.exists() || fi.isDir()) return QString();
+
+	*mtime = fi.lastModified().toTime_t();
+	return FileHash::calculateHash(filename);
+}
+
+bool MediaInfoCache::lookup(const QString & filename, MediaData & data) {
+	qint64 mtime;
+	QString k = key(filename, &mtime);
+	if (k.isEmpty()) return false;
+
+	QHash<QString, Entry>::const_iterator it = entries.constFind(k);
+	if ((it == entries.constEnd()) || (it->mtime != mtime)) return false;
+
+	const Entry & e = *it;
+	data.reset();
+	data.filename = filename;
+	data.type = TYPE_FILE;
+	data.duration = e.duration;
+	data.video_width = e.video_width;
+	data.video_height = e.video_height;
+	data.novideo = e.novideo;
+	data.clip_name = e.clip_name;
+	data.clip_artist = e.clip_artist;
+	data.clip_album = e.clip_album;
+	data.clip_genre = e.clip_genre;
+	data.demuxer = e.demuxer;
+	data.video_format = e.video_format;
+	data.audio_format = e.audio_format;
+	data.video_codec = e.video_codec;
+	data.audio_codec = e.audio_codec;
+	return true;
+}
+
+void MediaInfoCache::insert(const QString & filename, const MediaData & data) {
+	Entry e;
+	QString k = key(filename, &e.mtime);
+	if (k.isEmpty()) return;
+
+	e.duration = data.duration;
+	e.video_width = data.video_width;
+	e.video_height = data.video_height;
+	e.novideo = data.novideo;
+	e.clip_name = data.clip_name;
+	e.clip_artist = data.clip_artist;
+	e.clip_album = data.clip_album;
+	e.clip_genre = data.clip_genre;
+	e.demuxer = data.demuxer;
+	e.video_format = data.video_format;
+	e.audio_format = data.audio_format;
+	e.video_codec = data.video_codec;
+	e.audio_codec = data.audio_codec;
+	entries.insert(k, e);
+
+	QFile f(cache_file);
+	bool is_new = !f.exists();
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		qWarning("MediaInfoCache::insert: can't open '%s'", cache_file.toUtf8().constData());
+		return;
+	}
+	QDataStream out(&f);
+	out.setVersion(QDataStream::Qt_4_2);
+	if (is_new) out << (quint32) CACHE_MAGIC << (quint32) CACHE_VERSION;
+	writeEntry(out, k, e);
+	records++;
+}
+
+void MediaInfoCache::writeEntry(QDataStream & out, const QString & key, const Entry & e) {
+	out << key << e.mtime << e.duration
+        << (qint32) e.video_width << (qint32) e.video_height << e.novideo
+        << e.clip_name << e.clip_artist << e.clip_album << e.clip_genre
+        << e.demuxer << e.video_format << e.audio_format
+        << e.video_codec << e.audio_codec;
+}
+
+bool MediaInfoCache::readEntry(QDataStream & in, QString & key, Entry & e) {
+	qint32 width, height;
+	in >> key >> e.mtime >> e.duration
+       >> width >> height >> e.novideo
+       >> e.clip_name >> e.clip_artist >> e.clip_album >> e.clip_genre
+       >> e.demuxer >> e.video_format >> e.audio_format
+       >> e.video_codec >> e.audio_codec;
+	e.video_width = width;
+	e.video_height = height;
+	return (in.status() == QDataStream::Ok);
+}
+
+void MediaInfoCache::load() {
+	entries.clear();
+	records = 0;
+
+	QFile f(cache_file);
+	if (!f.open(QIODevice::ReadOnly)) return;
+
+	QDataStream in(&f);
+	in.setVersion(QDataStream::Qt_4_2);
+
+	quint32 magic, version;
+	in >> magic >> version;
+	bool damaged = (in.status() != QDataStream::Ok) || (magic != CACHE_MAGIC) || (version != CACHE_VERSION);
+
+	while (!damaged && !in.atEnd()) {
+		QString k;
+		Entry e;
+		if (readEntry(in, k, e)) {
+			entries.insert(k, e);
+			records++;
+		} else {
+			// Probably a record truncated by a crash
+			damaged = true;
+		}
+	}
+	f.close();
+
+	qDebug("MediaInfoCache::load: %d entries, %d records", entries.count(), records);
+
+	if (damaged || (records > 2 * entries.count() + 64)) {
+		save();
+	}
+}
+
+void MediaInfoCache::save() {
+	qDebug("MediaInfoCache::save: writing %d entries", entries.count());
+
+	QFile f(cache_file);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		qWarning("MediaInfoCache::save: can't open '%s'", cache_file.toUtf8().constData());
+		return;
+	}
+	QDataStream out(&f);
+	out.setVersion(QDataStream::Qt_4_2);
+	out << (quint32) CACHE_MAGIC << (quint32) CACHE_VERSION;
+
+	QHash<QString, Entry>::const_iterator it = entries.constBegin();
+	for (; it != entries.constEnd(); ++it) {
+		writeEntry(out, it.key(), it.value());
+	}
+	records = entries.count();
+}
@@ -0,0 +1,72 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+//! Persistent cache of the info mplayer reports about files
+
+#ifndef _MEDIAINFOCACHE_H_
+#define _MEDIAINFOCACHE_H_
+
+#include <QString>
+#include <QHash>
+#include "mediadata.h"
+
+class QDataStream;
+
+/*!
+ All entries are kept in a single binary file. New entries are appended
+ to it, so the file may contain outdated records for the same key; they're
+ dropped the next time the file is loaded, rewriting it if it has grown
+ too much. Entries are keyed by the FileHash of the file and are only
+ valid while its modification time doesn't change.
+*/
+
+class MediaInfoCache
+{
+public:
+	MediaInfoCache(const QString & cache_file);
+	~MediaInfoCache();
+
+	//! Fills data and returns true if there's valid info about filename
+	bool lookup(const QString & filename, MediaData & data);
+
+	//! Stores the info about filename
+	void insert(const QString & filename, const MediaData & data);
+
+private:
+	struct Entry {
+		qint64 mtime;
+		double duration;
+		int video_width, video_height;
+		bool novideo;
+		QString clip_name, clip_artist, clip_album, clip_genre;
+		QString demuxer, video_format, audio_format, video_codec, audio_codec;
+	};
+
+	static QString key(const QString & filename, qint64 * mtime);
+	static void writeEntry(QDataStream & out, const QString & key, const Entry & e);
+	static bool readEntry(QDataStream & in, QString & key, Entry & e);
+
+	void load();
+	void save();
+
+	QString cache_file;
+	QHash<QString, Entry> entries;
+	int records; // number of records in the file
+};
+
+#endif
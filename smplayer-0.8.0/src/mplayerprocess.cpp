@@ -146,8 +146,6 @@ void MplayerProcess::MPpipeWrite( const QByteArray text ) {
 }
 #endif
 
-static QRegExp rx_av("^[AV]: *([0-9,:.-]+)");
-static QRegExp rx_frame("^[AV]:.* (\\d+)\\/.\\d+");// [0-9,.]+");
 static QRegExp rx("^(.*)=(.*)");
 #if !NOTIFY_AUDIO_CHANGES
 static QRegExp rx_audio_mat("^ID_AID_(\\d+)_(LANG|NAME)=(.*)");
@@ -161,17 +159,13 @@ static QRegExp rx_paused("^ID_PAUSED");
 #if !CHECK_VIDEO_CODEC_FOR_NO_VIDEO
 static QRegExp rx_novideo("^Video: no video");
 #endif
-static QRegExp rx_cache("^Cache fill:.*");
-static QRegExp rx_create_index("^Generating Index:.*");
 static QRegExp rx_play("^Starting playback...");
-static QRegExp rx_connecting("^Connecting to .*");
-static QRegExp rx_resolving("^Resolving .*");
 static QRegExp rx_screenshot("^\\*\\*\\* screenshot '(.*)'");
+static QRegExp rx_filter_error("^Couldn't (find|open) video filter '(.*)'|^\\[libaf\\] Couldn't (find|create or open) audio filter '(.*)'");
 static QRegExp rx_endoffile("^Exiting... \\(End of file\\)|^ID_EXIT=EOF");
 static QRegExp rx_mkvchapters("\\[mkv\\] Chapter (\\d+) from");
 static QRegExp rx_aspect2("^Movie-Aspect is ([0-9,.]+):1");
 static QRegExp rx_fontcache("^\\[ass\\] Updating font cache|^\\[ass\\] Init");
-static QRegExp rx_scanning_font("Scanning file");
 #if DVDNAV_SUPPORT
 static QRegExp rx_dvdnav_switch_title("^DVDNAV, switched to title: (\\d+)");
 static QRegExp rx_dvdnav_length("^ANS_length=(.*)");
@@ -215,6 +209,99 @@ static QRegExp rx_clip_software("^ software: (.*)", Qt::CaseInsensitive);
 static QRegExp rx_stream_title("^.* StreamTitle='(.*)';");
 static QRegExp rx_stream_title_and_url("^.* StreamTitle='(.*)';StreamUrl='(.*)';");
 
+// Status line: "A:  12.3 V:  12.3 A-V:  0.000 ct:  0.000  301/301 ..."
+// It's received several times per second, so it's parsed directly from the
+// raw data, without regular expressions and conversion to QString.
+// Same as matching "^[AV]: *([0-9,:.-]+)" for the time and
+// "^[AV]:.* (\\d+)\\/.\\d+" for the frame (-1 if not found).
+static bool parseStatusLine(const QByteArray & ba, double & sec, int & frame) {
+	const char * data = ba.constData();
+	const int size = ba.size();
+
+	if ((size < 3) || ((data[0] != 'A') && (data[0] != 'V')) || (data[1] != ':')) {
+		return false;
+	}
+
+	int pos = 2;
+	while ((pos < size) && (data[pos] == ' ')) pos++;
+	const int start = pos;
+	while ((pos < size) && (((data[pos] >= '0') && (data[pos] <= '9')) ||
+           (data[pos] == ',') || (data[pos] == ':') || (data[pos] == '.') || (data[pos] == '-')))
+	{
+		pos++;
+	}
+	const int end = pos;
+	if (end == start) {
+		return false;
+	}
+
+	// Like QString::toDouble(), return 0 if the whole token is not a number
+	sec = 0;
+	pos = start;
+	bool negative = false;
+	if (data[pos] == '-') {
+		negative = true;
+		pos++;
+	}
+	double value = 0;
+	int digits = 0;
+	while ((pos < end) && (data[pos] >= '0') && (data[pos] <= '9')) {
+		value = value * 10 + (data[pos++] - '0');
+		digits++;
+	}
+	if ((pos < end) && (data[pos] == '.')) {
+		pos++;
+		double fraction = 0;
+		double divisor = 1;
+		while ((pos < end) && (data[pos] >= '0') && (data[pos] <= '9')) {
+			fraction = fraction * 10 + (data[pos++] - '0');
+			divisor *= 10;
+			digits++;
+		}
+		value += fraction / divisor;
+	}
+	if ((pos == end) && (digits > 0)) {
+		sec = negative ? -value : value;
+	}
+
+	// The regular expression is greedy, so the last match is used
+	frame = -1;
+	for (int space = size - 1; space >= 2; space--) {
+		if (data[space] != ' ') continue;
+		int p = space + 1;
+		int number = 0;
+		while ((p < size) && (data[p] >= '0') && (data[p] <= '9')) {
+			number = number * 10 + (data[p++] - '0');
+		}
+		if ((p > space + 1) && (p + 2 < size) && (data[p] == '/') &&
+            (data[p + 2] >= '0') && (data[p + 2] <= '9'))
+		{
+			frame = number;
+			break;
+		}
+	}
+
+	return true;
+}
+
+// Most of the regular expressions are anchored to the start of the line,
+// so only the ones for the line prefix have to be tried.
+enum LinePrefix { OtherPrefix, IdPrefix, AnsPrefix, VoPrefix, AoPrefix, DvdnavPrefix, SpacePrefix };
+
+static LinePrefix linePrefix(const QString & line) {
+	if (line.isEmpty()) return OtherPrefix;
+
+	switch (line.at(0).unicode()) {
+		case 'I': if (line.startsWith("ID_")) return IdPrefix; break;
+		case 'A': if (line.startsWith("ANS_")) return AnsPrefix;
+		          if (line.startsWith("AO: ")) return AoPrefix;
+		          break;
+		case 'V': if (line.startsWith("VO: ")) return VoPrefix; break;
+		case 'D': if (line.startsWith("DVDNAV")) return DvdnavPrefix; break;
+		case ' ': return SpacePrefix;
+	}
+	return OtherPrefix;
+}
 
 void MplayerProcess::parseLine(QByteArray ba) {
 	//qDebug("MplayerProcess::parseLine: '%s'", ba.data() );
@@ -223,16 +310,16 @@ void MplayerProcess::parseLine(QByteArray ba) {
 	QString value;
 
 #if COLOR_OUTPUT_SUPPORT
-    QString line = ColorUtils::stripColorsTags(QString::fromLocal8Bit(ba));
-#else
-	QString line = QString::fromLocal8Bit(ba);
+	// The status line never has color tags
+	if (ba.contains('\033')) {
+		ba = ColorUtils::stripColorsTags(QString::fromLocal8Bit(ba)).toLocal8Bit();
+	}
 #endif
 
 	// Parse A: V: line
-	//qDebug("%s", line.toUtf8().data());
-    if (rx_av.indexIn(line) > -1) {
-		double sec = rx_av.cap(1).toDouble();
-		//qDebug("cap(1): '%s'", rx_av.cap(1).toUtf8().data() );
+	double sec;
+	int frame;
+	if (parseStatusLine(ba, sec, frame)) {
 		//qDebug("sec: %f", sec);
 
 #if NOTIFY_SUB_CHANGES
@@ -290,24 +377,32 @@ void MplayerProcess::parseLine(QByteArray ba) {
 	    emit receivedCurrentSec( sec );
 
 		// Check for frame
-        if (rx_frame.indexIn(line) > -1) {
-			int frame = rx_frame.cap(1).toInt();
+		if (frame > -1) {
 			//qDebug(" frame: %d", frame);
 			emit receivedCurrentFrame(frame);
 		}
 	}
 	else {
+		QString line = QString::fromLocal8Bit(ba);
+		LinePrefix prefix = linePrefix(line);
+
 		emit lineAvailable(line);
 
 		// Screenshot
-		if (rx_screenshot.indexIn(line) > -1) {
+		if (line.startsWith("***") && rx_screenshot.indexIn(line) > -1) {
             QString shot = rx_screenshot.cap(1);
 			emit receivedScreenshot( shot );
 		}
 		else
 
+		// A filter added with vf_add or af_add failed
+		if ((prefix == OtherPrefix) && rx_filter_error.indexIn(line) > -1) {
+			emit receivedFilterError(line);
+		}
+		else
+
 		// End of file
-		if (rx_endoffile.indexIn(line) > -1)  {
+		if ((prefix == IdPrefix || line.startsWith("Exiting")) && rx_endoffile.indexIn(line) > -1)  {
 			if (!received_end_of_file) {
 				// In case of playing VCDs or DVDs, maybe the first title
     	        // is not playable, so the GUI doesn't get the info about
@@ -324,7 +419,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Window resolution
-		if (rx_winresolution.indexIn(line) > -1) {
+		if (prefix == VoPrefix && rx_winresolution.indexIn(line) > -1) {
 
 			int w = rx_winresolution.cap(4).toInt();
 			int h = rx_winresolution.cap(5).toInt();
@@ -337,7 +432,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 
 #if !CHECK_VIDEO_CODEC_FOR_NO_VIDEO
 		// No video
-		if (rx_novideo.indexIn(line) > -1) {
+		if (line.startsWith("Video: ") && rx_novideo.indexIn(line) > -1) {
 			md.novideo = TRUE;
 			emit receivedNoVideo();
 			//emit mplayerFullyLoaded();
@@ -346,12 +441,13 @@ void MplayerProcess::parseLine(QByteArray ba) {
 #endif
 
 		// Pause
-		if (rx_paused.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_paused.indexIn(line) > -1) {
 			emit receivedPause();
 		}
 
 		// Stream title
-		if (rx_stream_title_and_url.indexIn(line) > -1) {
+		bool has_stream_title = line.contains(" StreamTitle='");
+		if (has_stream_title && rx_stream_title_and_url.indexIn(line) > -1) {
 			QString s = rx_stream_title_and_url.cap(1);
 			QString url = rx_stream_title_and_url.cap(2);
 
@@ -360,7 +456,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 			emit receivedStreamTitleAndUrl( s, url );
 		}
 		else
-		if (rx_stream_title.indexIn(line) > -1) {
+		if (has_stream_title && rx_stream_title.indexIn(line) > -1) {
 			QString s = rx_stream_title.cap(1);
 
 			md.stream_title = s;
@@ -369,7 +465,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 
 #if NOTIFY_SUB_CHANGES
 		// Subtitles
-		if ((rx_subtitle.indexIn(line) > -1) || (rx_sid.indexIn(line) > -1) || (rx_subtitle_file.indexIn(line) > -1)) {
+		if (prefix == IdPrefix && ((rx_subtitle.indexIn(line) > -1) || (rx_sid.indexIn(line) > -1) || (rx_subtitle_file.indexIn(line) > -1))) {
 			int r = subs.parse(line);
 
 			subtitle_info_received = true;
@@ -379,13 +475,13 @@ void MplayerProcess::parseLine(QByteArray ba) {
 
 #if NOTIFY_AUDIO_CHANGES
 		// Audio
-		if (rx_audio.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_audio.indexIn(line) > -1) {
 			int ID = rx_audio.cap(1).toInt();
 			if (audios.find(ID) == -1) audio_info_changed = true;
 			audios.addID( ID );
 		}
 
-		if (rx_audio_info.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_audio_info.indexIn(line) > -1) {
 			int ID = rx_audio_info.cap(1).toInt();
 			QString lang = rx_audio_info.cap(3);
 			QString t = rx_audio_info.cap(2);
@@ -417,21 +513,21 @@ void MplayerProcess::parseLine(QByteArray ba) {
 #endif
 
 #if DVDNAV_SUPPORT
-		if (rx_dvdnav_switch_title.indexIn(line) > -1) {
+		if (prefix == DvdnavPrefix && rx_dvdnav_switch_title.indexIn(line) > -1) {
 			int title = rx_dvdnav_switch_title.cap(1).toInt();
 			emit receivedDVDTitle(title);
 		}
-		if (rx_dvdnav_length.indexIn(line) > -1) {
+		if (prefix == AnsPrefix && rx_dvdnav_length.indexIn(line) > -1) {
 			double length = rx_dvdnav_length.cap(1).toDouble();
 			if (length != md.duration) {
 				md.duration = length;
 				emit receivedDuration(length);
 			}
 		}
-		if (rx_dvdnav_title_is_menu.indexIn(line) > -1) {
+		if (prefix == DvdnavPrefix && rx_dvdnav_title_is_menu.indexIn(line) > -1) {
 			emit receivedTitleIsMenu();
 		}
-		if (rx_dvdnav_title_is_movie.indexIn(line) > -1) {
+		if (prefix == DvdnavPrefix && rx_dvdnav_title_is_movie.indexIn(line) > -1) {
 			emit receivedTitleIsMovie();
 		}
 #endif
@@ -452,27 +548,27 @@ void MplayerProcess::parseLine(QByteArray ba) {
 
 #if !NOTIFY_SUB_CHANGES
 		// Subtitles
-		if (rx_subtitle.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_subtitle.indexIn(line) > -1) {
 			md.subs.parse(line);
 		}
 		else
-		if (rx_sid.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_sid.indexIn(line) > -1) {
 			md.subs.parse(line);
 		}
 		else
-		if (rx_subtitle_file.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_subtitle_file.indexIn(line) > -1) {
 			md.subs.parse(line);
 		}
 #endif
 		// AO
-		if (rx_ao.indexIn(line) > -1) {
+		if (prefix == AoPrefix && rx_ao.indexIn(line) > -1) {
 			emit receivedAO( rx_ao.cap(1) );
 		}
 		else
 
 #if !NOTIFY_AUDIO_CHANGES
 		// Matroska audio
-		if (rx_audio_mat.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_audio_mat.indexIn(line) > -1) {
 			int ID = rx_audio_mat.cap(1).toInt();
 			QString lang = rx_audio_mat.cap(3);
 			QString t = rx_audio_mat.cap(2);
@@ -487,7 +583,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 
 #if PROGRAM_SWITCH
 		// Program
-		if (rx_program.indexIn(line) > -1) {
+		if (line.startsWith("PROGRAM_ID=") && rx_program.indexIn(line) > -1) {
 			int ID = rx_program.cap(1).toInt();
 			md.programs.addID( ID );
 		}
@@ -495,7 +591,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 #endif
 
 		// Video tracks
-		if (rx_video.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_video.indexIn(line) > -1) {
 			int ID = rx_video.cap(1).toInt();
 			QString lang = rx_video.cap(3);
 			QString t = rx_video.cap(2);
@@ -509,7 +605,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Matroshka chapters
-		if (rx_mkvchapters.indexIn(line)!=-1) {
+		if (line.contains("[mkv]") && rx_mkvchapters.indexIn(line)!=-1) {
 			int c = rx_mkvchapters.cap(1).toInt();
 
 			if ((c+1) > md.n_chapters) {
@@ -518,7 +614,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		}
 		else
 		// Chapter info
-		if (rx_chapters.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_chapters.indexIn(line) > -1) {
 			int const chap_ID = rx_chapters.cap(1).toInt();
 			QString const chap_type = rx_chapters.cap(2);
 			QString const chap_value = rx_chapters.cap(3);
@@ -540,7 +636,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// VCD titles
-		if (rx_vcd.indexIn(line) > -1 ) {
+		if (prefix == IdPrefix && rx_vcd.indexIn(line) > -1 ) {
 			int ID = rx_vcd.cap(1).toInt();
 			QString length = rx_vcd.cap(2);
 			//md.titles.addID( ID );
@@ -549,7 +645,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Audio CD titles
-		if (rx_cdda.indexIn(line) > -1 ) {
+		if (prefix == IdPrefix && rx_cdda.indexIn(line) > -1 ) {
 			int ID = rx_cdda.cap(1).toInt();
 			QString length = rx_cdda.cap(2);
 			double duration = 0;
@@ -565,7 +661,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// DVD titles
-		if (rx_title.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx_title.indexIn(line) > -1) {
 			int ID = rx_title.cap(1).toInt();
 			QString t = rx_title.cap(2);
 
@@ -590,31 +686,31 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Catch cache messages
-		if (rx_cache.indexIn(line) > -1) {
+		if (line.startsWith("Cache fill:")) {
 			emit receivedCacheMessage(line);
 		}
 		else
 
 		// Creating index
-		if (rx_create_index.indexIn(line) > -1) {
+		if (line.startsWith("Generating Index:")) {
 			emit receivedCreatingIndex(line);
 		}
 		else
 
 		// Catch connecting message
-		if (rx_connecting.indexIn(line) > -1) {
+		if (line.startsWith("Connecting to ")) {
 			emit receivedConnectingToMessage(line);
 		}
 		else
 
 		// Catch resolving message
-		if (rx_resolving.indexIn(line) > -1) {
+		if (line.startsWith("Resolving ")) {
 			emit receivedResolvingMessage(line);
 		}
 		else
 
 		// Aspect ratio for old versions of mplayer
-		if (rx_aspect2.indexIn(line) > -1) {
+		if (line.startsWith("Movie-Aspect is ") && rx_aspect2.indexIn(line) > -1) {
 			md.video_aspect = rx_aspect2.cap(1).toDouble();
 
 		}
@@ -627,14 +723,14 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		//Unfortunately MPlayer gives us leading and trailing whitespaces, Winamp for example doesn't show them
 
 		// Name
-		if (rx_clip_name.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_name.indexIn(line) > -1) {
 			QString s = rx_clip_name.cap(2).trimmed();
 			md.clip_name = s;
 		}
 		else
 
 		// Artist
-		if (rx_clip_artist.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_artist.indexIn(line) > -1) {
 			QString s = rx_clip_artist.cap(1).trimmed();
 
 			md.clip_artist = s;
@@ -642,21 +738,21 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Author
-		if (rx_clip_author.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_author.indexIn(line) > -1) {
 			QString s = rx_clip_author.cap(1).trimmed();
 			md.clip_author = s;
 		}
 		else
 
 		// Album
-		if (rx_clip_album.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_album.indexIn(line) > -1) {
 			QString s = rx_clip_album.cap(1).trimmed();
 			md.clip_album = s;
 		}
 		else
 
 		// Genre
-		if (rx_clip_genre.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_genre.indexIn(line) > -1) {
 			QString s = rx_clip_genre.cap(1).trimmed();
 
 			md.clip_genre = s;
@@ -664,7 +760,7 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Date
-		if (rx_clip_date.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_date.indexIn(line) > -1) {
 			QString s = rx_clip_date.cap(2).trimmed();
 
 			md.clip_date = s;
@@ -672,14 +768,14 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Track
-		if (rx_clip_track.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_track.indexIn(line) > -1) {
 			QString s = rx_clip_track.cap(1).trimmed();
 			md.clip_track = s;
 		}
 		else
 
 		// Copyright
-		if (rx_clip_copyright.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_copyright.indexIn(line) > -1) {
 			QString s = rx_clip_copyright.cap(1).trimmed();
 
 			md.clip_copyright = s;
@@ -687,31 +783,31 @@ void MplayerProcess::parseLine(QByteArray ba) {
 		else
 
 		// Comment
-		if (rx_clip_comment.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_comment.indexIn(line) > -1) {
 			QString s = rx_clip_comment.cap(1).trimmed();
 			md.clip_comment = s;
 		}
 		else
 
 		// Software
-		if (rx_clip_software.indexIn(line) > -1) {
+		if (prefix == SpacePrefix && rx_clip_software.indexIn(line) > -1) {
 			QString s = rx_clip_software.cap(1).trimmed();
 			md.clip_software = s;
 		}
 		else
 
-		if (rx_fontcache.indexIn(line) > -1) {
+		if (line.startsWith("[ass]") && rx_fontcache.indexIn(line) > -1) {
 
 			emit receivedUpdatingFontCache();
 		}
 		else
-		if (rx_scanning_font.indexIn(line) > -1) {
+		if (line.contains("Scanning file")) {
 			emit receivedScanningFont(line);
 		}
 		else
 
 		//Generic things
-		if (rx.indexIn(line) > -1) {
+		if (prefix == IdPrefix && rx.indexIn(line) > -1) {
 			tag = rx.cap(1);
 			value = rx.cap(2);
 
@@ -82,6 +82,8 @@ signals:
 	void receivedConnectingToMessage(QString);
 	void receivedResolvingMessage(QString);
 	void receivedScreenshot(QString);
+	//! mplayer couldn't add a video or audio filter
+	void receivedFilterError(QString);
 	void receivedUpdatingFontCache();
 	void receivedScanningFont(QString);
 
@@ -37,10 +37,11 @@
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include <QHeaderView>
+#include <QTableView>
+#include <QItemSelectionModel>
 #include <QTextCodec>
 #include <QApplication>
 
-#include "mytablewidget.h"
 #include "myaction.h"
 #include "filedialog.h"
 #include "helper.h"
@@ -60,10 +61,6 @@
 
 #define DRAG_ITEMS 0
 
-#define COL_PLAY 0
-#define COL_NAME 1
-#define COL_TIME 2
-
 using namespace Global;
 
 
@@ -143,23 +140,31 @@ void Playlist::setModified(bool mod) {
 }
 
 void Playlist::createTable() {
-	listView = new MyTableWidget( 0, COL_TIME + 1, this);
+	model = new PlaylistModel(this);
+
+	listView = new QTableView(this);
+	listView->setModel(model);
 	listView->setObjectName("playlist_table");
 	listView->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Expanding );
 	listView->setSelectionBehavior(QAbstractItemView::SelectRows);
 	listView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 	listView->setContextMenuPolicy( Qt::CustomContextMenu );
 	listView->setShowGrid(false);
+	listView->setWordWrap(false);
 	listView->setSortingEnabled(false);
 	//listView->setAlternatingRowColors(true);
 	listView->horizontalHeader()->setResizeMode(QHeaderView::Interactive);
 	listView->horizontalHeader()->setResizeMode(COL_NAME, QHeaderView::Stretch);
-	/*
-	listView->horizontalHeader()->setResizeMode(COL_TIME, QHeaderView::ResizeToContents);
-	listView->horizontalHeader()->setResizeMode(COL_PLAY, QHeaderView::ResizeToContents);
-	*/
+	// Their widths are computed in updateView, resizing them to the
+	// contents would make Qt measure every row
+	listView->horizontalHeader()->setResizeMode(COL_TIME, QHeaderView::Fixed);
+	listView->horizontalHeader()->setResizeMode(COL_PLAY, QHeaderView::Fixed);
 	listView->setIconSize( Images::icon("ok").size() );
 
+	// All rows have the same height, so the view only has to deal
+	// with the rows that are visible
+	listView->verticalHeader()->setResizeMode(QHeaderView::Fixed);
+
 #if DRAG_ITEMS
 	listView->setSelectionMode(QAbstractItemView::SingleSelection);
 	listView->setDragEnabled(true);
@@ -168,8 +173,8 @@ void Playlist::createTable() {
 	listView->setDragDropMode(QAbstractItemView::InternalMove);
 #endif
 
-	connect( listView, SIGNAL(cellActivated(int,int)),
-             this, SLOT(itemDoubleClicked(int)) );
+	connect( listView, SIGNAL(activated(const QModelIndex &)),
+             this, SLOT(itemActivated(const QModelIndex &)) );
 
 	// EDIT BY NEO -->
 	connect( listView->horizontalHeader(), SIGNAL(sectionClicked(int)), this, SLOT(sortBy(int)));
@@ -277,8 +282,7 @@ void Playlist::createToolbar() {
 }
 
 void Playlist::retranslateStrings() {
-	listView->setHorizontalHeaderLabels( QStringList() << "   " <<
-        tr("Name") << tr("Length") );
+	model->retranslateStrings();
 
 	openAct->change( Images::icon("open"), tr("&Load") );
 	saveAct->change( Images::icon("save"), tr("&Save") );
@@ -329,7 +333,8 @@ void Playlist::retranslateStrings() {
 
 void Playlist::list() {
 
-	PlaylistItemList::iterator it;
+	const PlaylistItemList & pl = model->items();
+	PlaylistItemList::const_iterator it;
 	for ( it = pl.begin(); it != pl.end(); ++it ) {
 
 	}
@@ -340,7 +345,8 @@ QString Playlist::print(QString seperator){
 
 	QString output = "";
 
-	PlaylistItemList::iterator it;
+	const PlaylistItemList & pl = model->items();
+	PlaylistItemList::const_iterator it;
 	for ( it = pl.begin(); it != pl.end(); ++it ) {
 		output += it->filename() + seperator + it->name() + seperator + QString::number(it->duration()) + "\r\n";
 	}
@@ -350,72 +356,34 @@ QString Playlist::print(QString seperator){
 
 void Playlist::updateView() {
 
+	// The view asks the model only for the rows it shows
+	model->updateAll();
 
-	listView->setRowCount( pl.count() );
-
-	//QString number;
-	QString name;
-	QString time;
-
-	for (int n=0; n < pl.count(); n++) {
-		name = pl[n].name();
-		if (name.isEmpty()) name = pl[n].filename();
-		time = Helper::formatTime( (int) pl[n].duration() );
-		
-		listView->setText(n, COL_NAME, name);
-		listView->setText(n, COL_TIME, time);
-
-		if (pl[n].played()) {
-			listView->setIcon(n, COL_PLAY, Images::icon("ok") );
-		} else {
-			listView->setIcon(n, COL_PLAY, QPixmap() );
-		}
-
-		if (row_spacing > -1) listView->setRowHeight(n, listView->font().pointSize() + row_spacing);
+	if (row_spacing > -1) {
+		listView->verticalHeader()->setDefaultSectionSize(listView->font().pointSize() + row_spacing);
 	}
 
-	listView->resizeColumnToContents(COL_PLAY);
-	listView->resizeColumnToContents(COL_TIME);
+	// Resizing to contents would look at every row while the playlist is hidden
+	QHeaderView * header = listView->horizontalHeader();
+	listView->setColumnWidth(COL_PLAY, qMax(listView->iconSize().width() + 10, header->sectionSizeHint(COL_PLAY)));
+	listView->setColumnWidth(COL_TIME, qMax(listView->fontMetrics().width("00:00:00") + 10, header->sectionSizeHint(COL_TIME)));
 
-	setCurrentItem(current_item);
+	setCurrentItem(model->currentRow());
 
 	//adjustSize();
 }
 
 void Playlist::setCurrentItem(int current) {
-	QIcon play_icon;
-	if (qApp->isLeftToRight()) {
-		play_icon = Images::icon("play");
-	} else {
-		play_icon = Images::flippedIcon("play");
-	}
-
-	int old_current = current_item;
-	current_item = current;
+	model->setCurrentRow(current);
 
-	if ((current_item > -1) && (current_item < pl.count())) {
-		pl[current_item].setPlayed(TRUE);
-	}
-
-	if ( (old_current >= 0) && (old_current < listView->rowCount()) ) {
-		listView->setIcon(old_current, COL_PLAY, QPixmap() );
-	}
-
-	if ( (current_item >= 0) && (current_item < listView->rowCount()) ) {
-		listView->setIcon(current_item, COL_PLAY, play_icon );
-	}
-
-	if (current_item >= 0) {
+	if (current >= 0) {
 		listView->clearSelection();
-		listView->setCurrentCell( current_item, 0);
+		listView->setCurrentIndex( model->index(current, 0) );
 	}
 }
 
 void Playlist::clear() {
-	pl.clear();
-
-	listView->clearContents();
-	listView->setRowCount(0);
+	model->clear();
 
 	setCurrentItem(0);
 
@@ -423,21 +391,19 @@ void Playlist::clear() {
 }
 
 void Playlist::remove(int i){
-	if(i > -1 && i < pl.count()){
-		pl.removeAt(i);
-		if(current_item == i && i == (pl.count() - 1))
-			setCurrentItem(i - 1);
+	if(i > -1 && i < model->count()){
+		model->remove(i);
 		setModified(false);
 		updateView();
 	} //end if
 }
 
 int Playlist::count() {
-	return pl.count();
+	return model->count();
 }
 
 bool Playlist::isEmpty() {
-	return pl.isEmpty();
+	return (model->count() == 0);
 }
 
 void Playlist::addItem(QString filename, QString name, double duration) {
@@ -448,23 +414,10 @@ void Playlist::addItem(QString filename, QString name, double duration) {
 	#endif
 
 	// Test if already is in the list
-	bool exists = false;
-	for ( int n = 0; n < pl.count(); n++) {
-		if ( pl[n].filename() == filename ) {
-			exists = true;
-			int last_item =  pl.count()-1;
-			pl.move(n, last_item);
-
-			if (current_item > -1) {
-				if (current_item > n) current_item--;
-				else
-				if (current_item == n) current_item = last_item;
-			}
-			break;
-		}
-	}
-
-	if (!exists) {
+	int n = model->find(filename);
+	if (n > -1) {
+		model->move(n, model->count()-1);
+	} else {
 		if (name.isEmpty()) {
 			QFileInfo fi(filename);
 			// Let's see if it looks like a file (no dvd://1 or something)
@@ -476,101 +429,24 @@ void Playlist::addItem(QString filename, QString name, double duration) {
 				name = filename;
 			}
 		}
-		pl.append( PlaylistItem(filename, name, duration) );
+		model->append( PlaylistItem(filename, name, duration) );
 		//setModified( true ); // Better set the modified on a higher level
-	} else {
-
 	}
 }
 
 // EDIT BY NEO -->
 void Playlist::sortBy(int section) {
 
+	// Clicking again on the same column reverts the order
+	Qt::SortOrder order = Qt::AscendingOrder;
+	if (model->isSortedBy(section, order)) order = Qt::DescendingOrder;
 
-	sortBy(section, false, 0);
-}
-
-void Playlist::sortBy(int section, bool revert, int count) {
-    // Bubble sort
-    bool swaped = false;
-
-    for ( int n = 0; n < (pl.count() - count); n++) {
-
-      int last = n - 1;
-      int current = n;
-
-      // Revert the sort
-      if (revert) {
-          last = n;
-          current = n - 1;
-      }
-
-      if (n > 0) {
-          int compare = 0;
-
-          if (section == 0) {
-              // Sort by played
-              bool lastItem = pl[last].played();
-              bool currentItem = pl[current].played();
-
-              if (!lastItem && currentItem) {
-                  compare = 1;
-              } else if (lastItem && currentItem) {
-                  if (last == current_item) {
-                     compare = 1;
-                 } else {
-                     compare = -1;
-                 }
-              } else {
-                  compare = -1;
-              }
-          }
-          else if (section == 1) {
-              // Sort alphabetically
-              QString lastItem = pl[last].name();
-              QString currentItem = pl[current].name();
-              compare = lastItem.compare(currentItem);
-          } else if (section == 2) {
-              // Sort by duration
-              double lastItem = pl[last].duration();
-              double currentItem = pl[current].duration();
-
-              if (lastItem == currentItem) {
-                  compare = 0;
-              } else if (lastItem > currentItem) {
-                  compare = 1;
-              } else {
-                  compare = -1;
-              }
-          }
-
-          // Swap items
-          if(compare > 0) {
-              swapItems(n, n - 1);
-
-              if (current_item == (n - 1)) {
-                  current_item = n;
-              } else if (current_item == n) {
-                  current_item = n - 1;
-              }
-
-              listView->clearSelection();
-              listView->setCurrentCell(n - 1, 0);
-
-              swaped = true;
-          }
-      }
-    }
-
-    if ((count == 0) && !swaped && !revert) {
-        // Revert sort
-        sortBy(section, true, 0);
-    }else if(swaped) {
-        // Sort until there is nothing to sort
-        sortBy(section, revert, ++count);
-    } else {
-        updateView();
-    }
+	// The selection and the current index follow the items, so the
+	// view is not reset here
+	if (model->sortBy(section, order)) {
+		setModified( true );
+		listView->scrollTo(listView->currentIndex());
+	}
 }
 // <--
 
@@ -586,6 +462,7 @@ void Playlist::load_m3u(QString file) {
     if ( f.open( QIODevice::ReadOnly ) ) {
 		playlist_path = QFileInfo(file).path();
 
+		model->beginUpdate();
 		clear();
 		QString filename="";
 		QString name="";
@@ -633,6 +510,7 @@ void Playlist::load_m3u(QString file) {
 			}
         }
         f.close();
+		model->endUpdate();
 		list();
 		updateView();
 
@@ -653,6 +531,8 @@ void Playlist::load_pls(QString file) {
 	QSettings set(file, QSettings::IniFormat);
 	set.beginGroup("playlist");
 
+	model->beginUpdate();
+
 	if (set.status() == QSettings::NoError) {
 		clear();
 		QString filename;
@@ -681,6 +561,7 @@ void Playlist::load_pls(QString file) {
 
 	set.endGroup();
 
+	model->endUpdate();
 	list();
 	updateView();
 
@@ -716,7 +597,8 @@ bool Playlist::save_m3u(QString file) {
 		stream << "#EXTM3U" << "\n";
 		stream << "# Playlist created by SMPlayer " << smplayerVersion() << " \n";
 
-		PlaylistItemList::iterator it;
+		const PlaylistItemList & pl = model->items();
+		PlaylistItemList::const_iterator it;
 		for ( it = pl.begin(); it != pl.end(); ++it ) {
 			filename = (*it).filename();
 			#if defined(Q_OS_WIN) || defined(Q_OS_OS2)
@@ -757,7 +639,7 @@ bool Playlist::save_pls(QString file) {
 	
 	QString filename;
 
-	PlaylistItemList::iterator it;
+	const PlaylistItemList & pl = model->items();
 	for ( int n=0; n < pl.count(); n++ ) {
 		filename = pl[n].filename();
 		#if defined(Q_OS_WIN) || defined(Q_OS_OS2)
@@ -861,7 +743,7 @@ bool Playlist::maybeSave() {
 }
 
 void Playlist::playCurrent() {
-	int current = listView->currentRow();
+	int current = listView->currentIndex().row();
 	if (current > -1) {
 		playItem(current);
 	}
@@ -872,6 +754,10 @@ void Playlist::itemDoubleClicked(int row) {
 	playItem(row);
 }
 
+void Playlist::itemActivated(const QModelIndex & index) {
+	itemDoubleClicked(index.row());
+}
+
 void Playlist::showPopup(const QPoint & pos) {
 
 	if (!popup->isVisible()) {
@@ -890,12 +776,12 @@ void Playlist::startPlay() {
 
 void Playlist::playItem( int n ) {
 
-	if ( (n >= pl.count()) || (n < 0) ) {
+	if ( (n >= model->count()) || (n < 0) ) {
 		emit playlistEnded();
 		return;
 	}
 
-	QString filename = pl[n].filename();
+	QString filename = model->item(n).filename();
 	QString filename_with_path = playlist_path + "/" + filename;
 
 	if (!filename.isEmpty()) {
@@ -921,7 +807,8 @@ void Playlist::playNext() {
 		}
 		playItem( chosen_item );
 	} else {
-		bool finished_list = (current_item+1 >= pl.count());
+		int current_item = model->currentRow();
+		bool finished_list = (current_item+1 >= model->count());
 		if (finished_list) clearPlayedTag();
 
 		if ( (repeatAct->isChecked()) && (finished_list) ) {
@@ -934,10 +821,11 @@ void Playlist::playNext() {
 
 void Playlist::playPrev() {
 
+	int current_item = model->currentRow();
 	if (current_item > 0) {
 		playItem( current_item-1 );
 	} else {
-		if (pl.count() > 1) playItem( pl.count() -1 );
+		if (model->count() > 1) playItem( model->count() -1 );
 	}
 }
 
@@ -965,26 +853,23 @@ void Playlist::getMediaInfo() {
 	}
 	if (!artist.isEmpty()) name = artist + " - " + name;
 
-	int pos=0;
-	PlaylistItemList::iterator it;
-	for ( it = pl.begin(); it != pl.end(); ++it ) {
-		if ( (*it).filename() == filename ) {
-			if ((*it).duration()<1) {
-				if (!name.isEmpty()) {
-					(*it).setName(name);
-				}
-				(*it).setDuration(duration);
-				//setModified( true );
-			} 
-			else 
-			// Edited name (sets duration to 1)
-			if ((*it).duration()==1) {
-				(*it).setDuration(duration);
-				//setModified( true );
+	int pos = model->find(filename);
+	if (pos > -1) {
+		PlaylistItem & item = model->item(pos);
+		if (item.duration()<1) {
+			if (!name.isEmpty()) {
+				item.setName(name);
 			}
-			setCurrentItem(pos);
+			item.setDuration(duration);
+			//setModified( true );
+		} 
+		else 
+		// Edited name (sets duration to 1)
+		if (item.duration()==1) {
+			item.setDuration(duration);
+			//setModified( true );
 		}
-		pos++;
+		setCurrentItem(pos);
 	}
 	updateView();
 }
@@ -1018,15 +903,27 @@ void Playlist::addFiles(QStringList files, AutoGetInfo auto_get_info) {
 		get_info = automatically_get_info;
 	}
 
-	MediaData data;
 	setCursor(Qt::WaitCursor);
+
+	// Get the info of all files at once, so the ones not in the
+	// cache can be probed in parallel
+	QStringList info_files;
+	if (get_info) {
+		for (int n = 0; n < files.count(); n++) {
+			if (QFile::exists(files[n])) info_files.append(files[n]);
+		}
+	}
+	QList<MediaData> info = InfoProvider::getInfo(info_files);
+	int info_index = 0;
 #endif
 
+	model->beginUpdate();
+
     QStringList::Iterator it = files.begin();
     while( it != files.end() ) {
 #if USE_INFOPROVIDER
-		if ( (get_info) && (QFile::exists((*it))) ) {
-			data = InfoProvider::getInfo( (*it) );
+		if ( (info_index < info_files.count()) && (info_files[info_index] == (*it)) ) {
+			MediaData & data = info[info_index++];
 			addItem( (*it), data.displayName(), data.duration );
 
 		} else {
@@ -1042,6 +939,8 @@ void Playlist::addFiles(QStringList files, AutoGetInfo auto_get_info) {
 
         ++it;
     }
+	model->endUpdate();
+
 #if USE_INFOPROVIDER
 	unsetCursor();
 #endif
@@ -1107,39 +1006,28 @@ void Playlist::addDirectory(QString dir) {
 void Playlist::removeSelected() {
 
 	int first_selected = -1;
-	int number_previous_item = 0;
 
-	for (int n=0; n < listView->rowCount(); n++) {
-		if (listView->isSelected(n, 0)) {
-			pl[n].setMarkForDeletion(TRUE);
-			number_previous_item++;
-			if (first_selected == -1) first_selected = n;
-		}
+	QModelIndexList selected = listView->selectionModel()->selectedRows();
+	for (int n=0; n < selected.count(); n++) {
+		int row = selected[n].row();
+		model->item(row).setMarkForDeletion(TRUE);
+		if ( (first_selected == -1) || (row < first_selected) ) first_selected = row;
 	}
 
-	PlaylistItemList::iterator it;
-	for ( it = pl.begin(); it != pl.end(); ++it ) {
-		if ( (*it).markedForDeletion() ) {
-			it = pl.erase(it);
-			it--;
-			setModified( true );
-		}
+	if (!selected.isEmpty()) {
+		model->removeMarked();
+		setModified( true );
 	}
 
-
-    if (first_selected < current_item) {
-        current_item -= number_previous_item;
-    }
-
 	if (isEmpty()) setModified(false);
 	updateView();
 
-	if (first_selected >= listView->rowCount()) 
-		first_selected = listView->rowCount() - 1;
+	if (first_selected >= model->count()) 
+		first_selected = model->count() - 1;
 
-	if ( ( first_selected > -1) && ( first_selected < listView->rowCount() ) ) {
+	if ( ( first_selected > -1) && ( first_selected < model->count() ) ) {
 		listView->clearSelection();
-		listView->setCurrentCell( first_selected, 0);
+		listView->setCurrentIndex( model->index(first_selected, 0) );
 	}
 }
 
@@ -1153,9 +1041,8 @@ void Playlist::removeAll() {
 }
 
 void Playlist::clearPlayedTag() {
-	PlaylistItemList::iterator it;
-	for ( it = pl.begin(); it != pl.end(); ++it ) {
-		(*it).setPlayed(FALSE);
+	for (int n=0; n < model->count(); n++) {
+		model->item(n).setPlayed(FALSE);
 	}
 	updateView();
 }
@@ -1164,7 +1051,8 @@ int Playlist::chooseRandomItem() {
 	QList <int> fi; //List of not played items (free items)
 
 	int n=0;
-	PlaylistItemList::iterator it;
+	const PlaylistItemList & pl = model->items();
+	PlaylistItemList::const_iterator it;
 	for ( it = pl.begin(); it != pl.end(); ++it ) {
 		if (! (*it).played() ) fi.append(n);
 		n++;
@@ -1181,16 +1069,14 @@ int Playlist::chooseRandomItem() {
 }
 
 void Playlist::swapItems(int item1, int item2 ) {
-	PlaylistItem it1 = pl[item1];
-	pl[item1] = pl[item2];
-	pl[item2] = it1;
+	model->swap(item1, item2);
 	setModified( true );
 }
 
 
 void Playlist::upItem() {
 
-	int current = listView->currentRow();
+	int current = listView->currentIndex().row();
 
 	moveItemUp(current);
 
@@ -1198,7 +1084,7 @@ void Playlist::upItem() {
 
 void Playlist::downItem() {
 
-	int current = listView->currentRow();
+	int current = listView->currentIndex().row();
 
 	moveItemDown(current);
 }
@@ -1207,35 +1093,29 @@ void Playlist::moveItemUp(int current){
 
 	if (current >= 1) {
 		swapItems( current, current-1 );
-		if (current_item == (current-1)) current_item = current;
-		else
-		if (current_item == current) current_item = current-1;
 		updateView();
 		listView->clearSelection();
-		listView->setCurrentCell( current-1, 0);
+		listView->setCurrentIndex( model->index(current-1, 0) );
 	}
 }
 void Playlist::moveItemDown(int current	){
 
-	if ( (current > -1) && (current < (pl.count()-1)) ) {
+	if ( (current > -1) && (current < (model->count()-1)) ) {
 		swapItems( current, current+1 );
-		if (current_item == (current+1)) current_item = current;
-		else
-		if (current_item == current) current_item = current+1;
 		updateView();
 		listView->clearSelection();
-		listView->setCurrentCell( current+1, 0);
+		listView->setCurrentIndex( model->index(current+1, 0) );
 	}
 }
 
 void Playlist::editCurrentItem() {
-	int current = listView->currentRow();
+	int current = listView->currentIndex().row();
 	if (current > -1) editItem(current);
 }
 
 void Playlist::editItem(int item) {
-	QString current_name = pl[item].name();
-	if (current_name.isEmpty()) current_name = pl[item].filename();
+	QString current_name = model->item(item).name();
+	if (current_name.isEmpty()) current_name = model->item(item).filename();
 
 	bool ok;
 	QString text = QInputDialog::getText( this,
@@ -1245,10 +1125,10 @@ void Playlist::editItem(int item) {
             current_name, &ok );
     if ( ok && !text.isEmpty() ) {
         // user entered something and pressed OK
-		pl[item].setName(text);
+		model->item(item).setName(text);
 
 		// If duration == 0 the name will be overwritten!
-		if (pl[item].duration()<1) pl[item].setDuration(1); 
+		if (model->item(item).duration()<1) model->item(item).setDuration(1); 
 		updateView();
 
 		setModified( true );
@@ -1342,13 +1222,14 @@ void Playlist::saveSettings() {
 		//Save current list
 		set->beginGroup( "playlist_contents");
 
+		const PlaylistItemList & pl = model->items();
 		set->setValue( "count", (int) pl.count() );
 		for ( int n=0; n < pl.count(); n++ ) {
 			set->setValue( QString("item_%1_filename").arg(n), pl[n].filename() );
 			set->setValue( QString("item_%1_duration").arg(n), pl[n].duration() );
 			set->setValue( QString("item_%1_name").arg(n), pl[n].name() );
 		}
-		set->setValue( "current_item", current_item );
+		set->setValue( "current_item", model->currentRow() );
 		set->setValue( "modified", modified );
 
 		set->endGroup();
@@ -1387,12 +1268,14 @@ void Playlist::loadSettings() {
 		int count = set->value( "count", 0 ).toInt();
 		QString filename, name;
 		double duration;
+		model->beginUpdate();
 		for ( int n=0; n < count; n++ ) {
 			filename = set->value( QString("item_%1_filename").arg(n), "" ).toString();
 			duration = set->value( QString("item_%1_duration").arg(n), -1 ).toDouble();
 			name = set->value( QString("item_%1_name").arg(n), "" ).toString();
 			addItem( filename, name, duration );
 		}
+		model->endUpdate();
 		setCurrentItem( set->value( "current_item", -1 ).toInt() );
 		setModified( set->value( "modified", false ).toBool() );
 		updateView();
@@ -23,36 +23,10 @@
 #include <QList>
 #include <QStringList>
 #include <QWidget>
+#include "playlistmodel.h"
 
-class PlaylistItem {
-
-public:
-	PlaylistItem() { _filename=""; _name=""; _duration=0; 
-                     _played = FALSE; _deleted=FALSE; };
-	PlaylistItem(QString filename, QString name, double duration) {
-		         _filename = filename; _name = name; _duration = duration; 
-                 _played = FALSE; _deleted = FALSE; };
-	~PlaylistItem() {};
-
-	void setFilename(QString filename) { _filename = filename; };
-	void setName(QString name) { _name = name; };
-	void setDuration(double duration) { _duration = duration; };
-	void setPlayed(bool b) { _played = b; };
-	void setMarkForDeletion(bool b) { _deleted = b; };
-
-	QString filename() { return _filename; };
-	QString name() { return _name; };
-	double duration() { return _duration; };
-	bool played() { return _played; };
-	bool markedForDeletion() { return _deleted; };
-
-private:
-	QString _filename, _name;
-	double _duration;
-	bool _played, _deleted;
-};
-
-class MyTableWidget;
+class QTableView;
+class QModelIndex;
 class QToolBar;
 class MyAction;
 class Core;
@@ -141,7 +115,7 @@ public:
 	bool savePlaylistOnExit() { return save_playlist_in_config; };
 	bool playFilesFromStart() { return play_files_from_start; };
 
-	QList<PlaylistItem> playlist(){return pl;};
+	QList<PlaylistItem> playlist(){return model->items();};
 
 /*
 public:
@@ -160,14 +134,12 @@ protected:
 	void clearPlayedTag();
 	int chooseRandomItem();
 	void swapItems(int item1, int item2 );
-	// EDIT BY NEO -->
-	void sortBy(int section, bool revert, int count);
-	// <--
 	QString lastDir();
 
 protected slots:
 	virtual void playCurrent();
 	virtual void itemDoubleClicked(int row);
+	virtual void itemActivated(const QModelIndex & index);
 	virtual void showPopup(const QPoint & pos);
 	virtual void upItem();
 	virtual void downItem();
@@ -194,9 +166,7 @@ protected:
 	virtual void closeEvent( QCloseEvent * e );
 
 protected:
-	typedef QList <PlaylistItem> PlaylistItemList;
-	PlaylistItemList pl;
-	int current_item;
+	PlaylistModel * model;
 
 	QString playlist_path;
 	QString latest_dir;
@@ -206,7 +176,7 @@ protected:
 	QMenu * remove_menu;
 	QMenu * popup;
 
-	MyTableWidget * listView;
+	QTableView * listView;
 
 	QToolBar * toolbar;
 	QToolButton * add_button;
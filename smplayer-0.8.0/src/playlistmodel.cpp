@@ -0,0 +1,347 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "playlistmodel.h"
+
+#include <QApplication>
+#include <algorithm>
+#include <vector>
+
+#include "images.h"
+#include "helper.h"
+
+class PlaylistRowLessThan {
+public:
+	PlaylistRowLessThan(const PlaylistModel * m, int c, Qt::SortOrder o) {
+		model = m; column = c; order = o;
+	}
+	bool operator()(int row1, int row2) const {
+		if (order == Qt::AscendingOrder)
+			return model->lessThan(column, row1, row2);
+		else
+			return model->lessThan(column, row2, row1);
+	}
+private:
+	const PlaylistModel * model;
+	int column;
+	Qt::SortOrder order;
+};
+
+
+PlaylistModel::PlaylistModel(QObject * parent) 
+	: QAbstractTableModel(parent)
+{
+	current_row = -1;
+	index_valid = true;
+	update_level = 0;
+
+	retranslateStrings();
+}
+
+PlaylistModel::~PlaylistModel() {
+}
+
+int PlaylistModel::rowCount(const QModelIndex & parent) const {
+	if (parent.isValid()) return 0;
+	return list.count();
+}
+
+int PlaylistModel::columnCount(const QModelIndex & parent) const {
+	if (parent.isValid()) return 0;
+	return COL_TIME + 1;
+}
+
+QVariant PlaylistModel::data(const QModelIndex & index, int role) const {
+	if ( (!index.isValid()) || (index.row() >= list.count()) ) return QVariant();
+
+	const PlaylistItem & i = list[index.row()];
+
+	if (role == Qt::DisplayRole) {
+		if (index.column() == COL_NAME) {
+			return (i.name().isEmpty() ? i.filename() : i.name());
+		}
+		else
+		if (index.column() == COL_TIME) {
+			return Helper::formatTime( (int) i.duration() );
+		}
+	}
+	else
+	if ( (role == Qt::DecorationRole) && (index.column() == COL_PLAY) ) {
+		if (index.row() == current_row) return play_icon;
+		if (i.played()) return played_icon;
+	}
+
+	return QVariant();
+}
+
+QVariant PlaylistModel::headerData(int section, Qt::Orientation orientation, int role) const {
+	if ( (orientation == Qt::Horizontal) && (role == Qt::DisplayRole) ) {
+		switch (section) {
+			case COL_PLAY: return QString("   ");
+			case COL_NAME: return tr("Name");
+			case COL_TIME: return tr("Length");
+		}
+	}
+	return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags PlaylistModel::flags(const QModelIndex & index) const {
+	if (!index.isValid()) return 0;
+	return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled;
+}
+
+int PlaylistModel::find(const QString & filename) const {
+	if (!index_valid) {
+		filename_index.clear();
+		filename_index.reserve(list.count());
+		for (int n = 0; n < list.count(); n++) {
+			filename_index.insert(list[n].filename(), n);
+		}
+		index_valid = true;
+	}
+	return filename_index.value(filename, -1);
+}
+
+void PlaylistModel::reindex(int first, int last) {
+	if (!index_valid) return;
+	for (int n = first; n <= last; n++) {
+		filename_index.insert(list[n].filename(), n);
+	}
+}
+
+void PlaylistModel::append(const PlaylistItem & item) {
+	int row = list.count();
+
+	if (update_level == 0) beginInsertRows(QModelIndex(), row, row);
+	list.append(item);
+	if (index_valid) filename_index.insert(item.filename(), row);
+	if (update_level == 0) endInsertRows();
+}
+
+void PlaylistModel::move(int from, int to) {
+	if ( (from == to) || (from < 0) || (to < 0) || 
+         (from >= list.count()) || (to >= list.count()) ) return;
+
+	if (update_level == 0) emit layoutAboutToBeChanged();
+
+	list.move(from, to);
+	reindex(qMin(from, to), qMax(from, to));
+
+	if (current_row > -1) {
+		if (current_row == from) current_row = to;
+		else
+		if ( (from < current_row) && (current_row <= to) ) current_row--;
+		else
+		if ( (to <= current_row) && (current_row < from) ) current_row++;
+	}
+
+	if (update_level == 0) {
+		QVector<int> new_rows(list.count());
+		for (int n = 0; n < new_rows.count(); n++) {
+			if (n == from) new_rows[n] = to;
+			else
+			if ( (from < n) && (n <= to) ) new_rows[n] = n - 1;
+			else
+			if ( (to <= n) && (n < from) ) new_rows[n] = n + 1;
+			else
+			new_rows[n] = n;
+		}
+		remapPersistentRows(new_rows);
+		emit layoutChanged();
+	}
+}
+
+void PlaylistModel::swap(int row1, int row2) {
+	if ( (row1 < 0) || (row2 < 0) || (row1 >= list.count()) || (row2 >= list.count()) ) return;
+
+	list.swap(row1, row2);
+	reindex(row1, row1);
+	reindex(row2, row2);
+
+	if (current_row == row1) current_row = row2;
+	else
+	if (current_row == row2) current_row = row1;
+
+	updateRow(row1);
+	updateRow(row2);
+}
+
+void PlaylistModel::remove(int row) {
+	if ( (row < 0) || (row >= list.count()) ) return;
+
+	if (update_level == 0) beginRemoveRows(QModelIndex(), row, row);
+	filename_index.remove(list[row].filename());
+	list.removeAt(row);
+	reindex(row, list.count() - 1);
+
+	if (current_row > row) current_row--;
+	if (current_row >= list.count()) current_row = list.count() - 1;
+	if (update_level == 0) endRemoveRows();
+}
+
+void PlaylistModel::removeMarked() {
+	PlaylistItemList kept;
+
+	int new_current = current_row;
+	for (int n = 0; n < list.count(); n++) {
+		if (!list[n].markedForDeletion()) {
+			kept.append(list[n]);
+		}
+		else
+		if (n < current_row) {
+			new_current--;
+		}
+	}
+	if (kept.count() == list.count()) return;
+
+	list = kept;
+	current_row = qMin(new_current, list.count() - 1);
+	index_valid = false;
+
+	if (update_level == 0) reset();
+}
+
+void PlaylistModel::clear() {
+	list.clear();
+	filename_index.clear();
+	index_valid = true;
+	current_row = -1;
+
+	if (update_level == 0) reset();
+}
+
+int PlaylistModel::playedRank(int row) const {
+	// Played items first, then the one being played, then the rest
+	if (!list[row].played()) return 2;
+	return (row == current_row) ? 1 : 0;
+}
+
+bool PlaylistModel::lessThan(int column, int row1, int row2) const {
+	const PlaylistItem & i1 = list[row1];
+	const PlaylistItem & i2 = list[row2];
+
+	switch (column) {
+		case COL_PLAY: return playedRank(row1) < playedRank(row2);
+		case COL_NAME: return i1.name().compare(i2.name()) < 0;
+		case COL_TIME: return i1.duration() < i2.duration();
+	}
+	return false;
+}
+
+bool PlaylistModel::isSortedBy(int column, Qt::SortOrder order) const {
+	PlaylistRowLessThan less(this, column, order);
+	for (int n = 1; n < list.count(); n++) {
+		if (less(n, n - 1)) return false;
+	}
+	return true;
+}
+
+bool PlaylistModel::sortBy(int column, Qt::SortOrder order) {
+	// Sort the rows instead of the items, so the comparison can use the
+	// current row and the old positions are known afterwards
+	std::vector<int> rows(list.count());
+	for (int n = 0; n < list.count(); n++) rows[n] = n;
+
+	std::stable_sort(rows.begin(), rows.end(), PlaylistRowLessThan(this, column, order));
+
+	bool changed = false;
+	for (int n = 0; n < (int) rows.size(); n++) {
+		if (rows[n] != n) { changed = true; break; }
+	}
+	if (!changed) return false;
+
+	if (update_level == 0) emit layoutAboutToBeChanged();
+
+	PlaylistItemList sorted;
+	QVector<int> new_rows(list.count());
+	for (int n = 0; n < (int) rows.size(); n++) {
+		sorted.append(list[rows[n]]);
+		new_rows[rows[n]] = n;
+	}
+	list = sorted;
+	if ( (current_row > -1) && (current_row < new_rows.count()) ) {
+		current_row = new_rows[current_row];
+	}
+	index_valid = false;
+
+	if (update_level == 0) {
+		remapPersistentRows(new_rows);
+		emit layoutChanged();
+	}
+	return true;
+}
+
+void PlaylistModel::remapPersistentRows(const QVector<int> & new_rows) {
+	QModelIndexList from = persistentIndexList();
+	QModelIndexList to;
+	for (int n = 0; n < from.count(); n++) {
+		int row = from[n].row();
+		if ( (row >= 0) && (row < new_rows.count()) ) {
+			to.append( index(new_rows[row], from[n].column()) );
+		} else {
+			to.append( QModelIndex() );
+		}
+	}
+	changePersistentIndexList(from, to);
+}
+
+void PlaylistModel::setCurrentRow(int row) {
+	int old_row = current_row;
+	current_row = row;
+
+	if ( (current_row > -1) && (current_row < list.count()) ) {
+		list[current_row].setPlayed(true);
+	}
+	updateRow(old_row);
+	updateRow(current_row);
+}
+
+void PlaylistModel::beginUpdate() {
+	update_level++;
+}
+
+void PlaylistModel::endUpdate() {
+	if (update_level > 0) {
+		update_level--;
+		if (update_level == 0) reset();
+	}
+}
+
+void PlaylistModel::updateRow(int row) {
+	if ( (update_level > 0) || (row < 0) || (row >= list.count()) ) return;
+	emit dataChanged( index(row, 0), index(row, COL_TIME) );
+}
+
+void PlaylistModel::updateAll() {
+	if ( (update_level > 0) || (list.isEmpty()) ) return;
+	emit dataChanged( index(0, 0), index(list.count() - 1, COL_TIME) );
+}
+
+void PlaylistModel::retranslateStrings() {
+	if (qApp->isLeftToRight()) {
+		play_icon = Images::icon("play");
+	} else {
+		play_icon = Images::flippedIcon("play");
+	}
+	played_icon = Images::icon("ok");
+
+	emit headerDataChanged(Qt::Horizontal, 0, COL_TIME);
+	updateAll();
+}
+
+#include "moc_playlistmodel.cpp"
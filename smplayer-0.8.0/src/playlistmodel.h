@@ -0,0 +1,147 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef _PLAYLISTMODEL_H_
+#define _PLAYLISTMODEL_H_
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include <QPixmap>
+
+#define COL_PLAY 0
+#define COL_NAME 1
+#define COL_TIME 2
+
+class PlaylistItem {
+
+public:
+	PlaylistItem() { _filename=""; _name=""; _duration=0; 
+                     _played = FALSE; _deleted=FALSE; };
+	PlaylistItem(QString filename, QString name, double duration) {
+		         _filename = filename; _name = name; _duration = duration; 
+                 _played = FALSE; _deleted = FALSE; };
+	~PlaylistItem() {};
+
+	void setFilename(QString filename) { _filename = filename; };
+	void setName(QString name) { _name = name; };
+	void setDuration(double duration) { _duration = duration; };
+	void setPlayed(bool b) { _played = b; };
+	void setMarkForDeletion(bool b) { _deleted = b; };
+
+	QString filename() const { return _filename; };
+	QString name() const { return _name; };
+	double duration() const { return _duration; };
+	bool played() const { return _played; };
+	bool markedForDeletion() const { return _deleted; };
+
+private:
+	QString _filename, _name;
+	double _duration;
+	bool _played, _deleted;
+};
+
+typedef QList <PlaylistItem> PlaylistItemList;
+
+//! Table model holding the items of the playlist.
+/*!
+ Filenames are indexed in a hash, so looking for a duplicate doesn't
+ need to go through the whole list. The view only asks for the rows
+ it actually shows, so the cost of a change doesn't depend on the
+ size of the list.
+*/
+class PlaylistModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	PlaylistModel(QObject * parent = 0);
+	~PlaylistModel();
+
+	virtual int rowCount(const QModelIndex & parent = QModelIndex()) const;
+	virtual int columnCount(const QModelIndex & parent = QModelIndex()) const;
+	virtual QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const;
+	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+	virtual Qt::ItemFlags flags(const QModelIndex & index) const;
+
+	int count() const { return list.count(); };
+	const PlaylistItemList & items() const { return list; };
+
+	//! Gives access to the item at row \a n. Call updateRow() after
+	//! changing it. The filename of the item must not be changed.
+	PlaylistItem & item(int n) { return list[n]; };
+	const PlaylistItem & item(int n) const { return list[n]; };
+
+	//! Returns the row of the item with the given filename, or -1.
+	int find(const QString & filename) const;
+
+	void append(const PlaylistItem & item);
+	void move(int from, int to);
+	void swap(int row1, int row2);
+	void remove(int row);
+	//! Removes all the items marked for deletion.
+	void removeMarked();
+	void clear();
+
+	//! Sorts the items by \a column. The sort is stable, so items
+	//! which compare equal keep their relative order.
+	//! Returns false if the order didn't change.
+	bool sortBy(int column, Qt::SortOrder order);
+	//! Returns true if the items are already sorted by \a column.
+	bool isSortedBy(int column, Qt::SortOrder order) const;
+
+	//! The row of the item being played. It's kept up to date when
+	//! items are moved, removed or sorted.
+	void setCurrentRow(int row);
+	int currentRow() const { return current_row; };
+
+	//! Batch changes. Rows aren't reported one by one until
+	//! endUpdate(), the view is reset once instead.
+	void beginUpdate();
+	void endUpdate();
+
+	void updateRow(int row);
+	void updateAll();
+
+	void retranslateStrings();
+
+protected:
+	int playedRank(int row) const;
+	bool lessThan(int column, int row1, int row2) const;
+	void reindex(int first, int last);
+	void remapPersistentRows(const QVector<int> & new_rows);
+
+	friend class PlaylistRowLessThan;
+
+protected:
+	PlaylistItemList list;
+	int current_row;
+
+	// filename -> row. Rebuilt lazily after a change that moves rows.
+	mutable QHash<QString,int> filename_index;
+	mutable bool index_valid;
+
+	int update_level;
+
+	QPixmap play_icon;
+	QPixmap played_icon;
+};
+
+#endif
+
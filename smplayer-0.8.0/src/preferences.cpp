@@ -140,7 +140,7 @@ void Preferences::reset() {
 	osd = Seek;
 	osd_delay = 2200;
 
-	file_settings_method = "hash"; // Possible values: normal & hash
+	file_settings_method = "store"; // Possible values: normal, hash & store
 
 
     /* ***************
@@ -336,6 +336,7 @@ void Preferences::reset() {
 	seeking4 = 30;
 
 	update_while_seeking = false;
+	seekbar_thumbnails = true;
 #if ENABLE_DELAYED_DRAGGING
 	time_slider_drag_delay = 100;
 #endif
@@ -746,6 +747,7 @@ void Preferences::save() {
 	set->setValue("seeking4", seeking4);
 
 	set->setValue("update_while_seeking", update_while_seeking);
+	set->setValue("seekbar_thumbnails", seekbar_thumbnails);
 #if ENABLE_DELAYED_DRAGGING
 	set->setValue("time_slider_drag_delay", time_slider_drag_delay);
 #endif
@@ -1177,6 +1179,7 @@ void Preferences::load() {
 	seeking4 = set->value("seeking4", seeking4).toInt();
 
 	update_while_seeking = set->value("update_while_seeking", update_while_seeking).toBool();
+	seekbar_thumbnails = set->value("seekbar_thumbnails", seekbar_thumbnails).toBool();
 #if ENABLE_DELAYED_DRAGGING
 	time_slider_drag_delay = set->value("time_slider_drag_delay", time_slider_drag_delay).toInt();
 #endif
@@ -329,6 +329,10 @@ public:
 	int seeking4; // For mouse wheel, by default 30s
 
 	bool update_while_seeking;
+
+	//! If true, a strip of thumbnails is created in the background
+	//! for the current file and shown when hovering the time slider
+	bool seekbar_thumbnails;
 #if ENABLE_DELAYED_DRAGGING	
 	int time_slider_drag_delay;
 #endif
@@ -110,6 +110,7 @@ void PrefGeneral::retranslateStrings() {
 	filesettings_method_combo->clear();
 	filesettings_method_combo->addItem( tr("one ini file"), "normal");
 	filesettings_method_combo->addItem( tr("multiple ini files"), "hash");
+	filesettings_method_combo->addItem( tr("single indexed file"), "store");
 	filesettings_method_combo->setCurrentIndex(filesettings_method_item);
 
 	updateDriverCombos();
@@ -841,8 +842,11 @@ void PrefGeneral::createHelp() {
 		tr("<b>one ini file</b>: the settings for all played files will be "
            "saved in a single ini file (%1)").arg(QString("<i>"+Paths::iniPath()+"/smplayer.ini</i>")) + "</li><li>" +
 		tr("<b>multiple ini files</b>: one ini file will be used for each played file. "
-           "Those ini files will be saved in the folder %1").arg(QString("<i>"+Paths::iniPath()+"/file_settings</i>")) + "</li></ul>" +
-		tr("The latter method could be faster if there is info for a lot of files.") );
+           "Those ini files will be saved in the folder %1").arg(QString("<i>"+Paths::iniPath()+"/file_settings</i>")) + "</li><li>" +
+		tr("<b>single indexed file</b>: the settings for all played files will be "
+           "saved in a binary file (%1) which is indexed when SMPlayer starts. "
+           "Settings previously saved in multiple ini files are still used.").arg(QString("<i>"+Paths::iniPath()+"/file_settings.dat</i>")) + "</li></ul>" +
+		tr("The latter methods could be faster if there is info for a lot of files.") );
 
 	setWhatsThis(use_screenshots_check, tr("Enable screenshots"),
 		tr("You can use this option to enable or disable the possibility to "
@@ -0,0 +1,284 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "seekthumbnails.h"
+#include "filehash.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QBuffer>
+#include <QPainter>
+#include <QStringList>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+#include <sys/types.h>
+#include <utime.h>
+
+#define CACHE_MAGIC 0x534d5354
+#define CACHE_VERSION 1
+#define CACHE_MAX_FILES 200
+
+#define THUMB_WIDTH 160
+#define MAX_THUMBS 120
+#define MIN_INTERVAL 5 // seconds
+#define GRID_COLUMNS 10
+
+SeekThumbnails::SeekThumbnails(const QString & cache_dir, QObject * parent) : QObject(parent)
+{
+	this->cache_dir = cache_dir;
+	mplayer_bin = "mplayer";
+	temp_dir = QDir::tempPath() + "/smplayer_thumbnails_" + QString::number(QCoreApplication::applicationPid());
+	process = 0;
+	failed = false;
+
+	media_duration = 0;
+	interval = 0;
+	count = 0;
+}
+
+SeekThumbnails::~SeekThumbnails() {
+	stopProcess();
+	cleanDir();
+}
+
+void SeekThumbnails::clear() {
+	stopProcess();
+	cleanDir();
+
+	cache_file.clear();
+	current_file.clear();
+	failed = false;
+	grid = QImage();
+	thumb_size = QSize();
+	media_duration = 0;
+	interval = 0;
+	count = 0;
+}
+
+void SeekThumbnails::setFile(const QString & filename, double duration) {
+	// mplayer was just restarted
+	if ((filename == current_file) && ((process) || (isReady()) || (failed))) return;
+
+	clear();
+
+	if (duration <= 0) return;
+
+	QString hash = FileHash::calculateHash(filename);
+	if (hash.isEmpty()) return;
+
+	current_file = filename;
+	media_duration = duration;
+	cache_file = cache_dir + "/" + hash + ".thumbs";
+
+	if (loadCache(cache_file)) {
+		qDebug("SeekThumbnails::setFile: %d thumbnails loaded from cache", count);
+		emit ready();
+		return;
+	}
+
+	// -sstep only takes whole seconds
+	int step = qMax(MIN_INTERVAL, qRound(duration / MAX_THUMBS));
+	int frames = qMax(1, (int) (duration / step));
+	interval = step;
+
+	QDir d;
+	if (!d.mkpath(temp_dir)) {
+		qWarning("SeekThumbnails::setFile: can't create '%s'", temp_dir.toUtf8().constData());
+		failed = true;
+		return;
+	}
+
+	QStringList args;
+#ifdef Q_OS_WIN
+	args << "-priority" << "idle";
+#endif
+	args << "-nosound"
+         << "-vo" << "jpeg:outdir=\""+temp_dir+"\""
+         << "-vf" << QString("scale=%1:-3").arg(THUMB_WIDTH)
+         << "-lavdopts" << "skipframe=nonkey"
+         << "-frames" << QString::number(frames)
+         << "-ss" << "0" << "-sstep" << QString::number(step)
+         << filename;
+
+	qDebug("SeekThumbnails::setFile: command: %s %s", mplayer_bin.toUtf8().constData(), args.join(" ").toUtf8().constData());
+
+	process = new QProcess(this);
+	connect( process, SIGNAL(started()), this, SLOT(processStarted()) );
+	connect( process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processFinished()) );
+	connect( process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(processFinished()) );
+	process->start(mplayer_bin, args);
+}
+
+void SeekThumbnails::processStarted() {
+#ifdef Q_OS_UNIX
+	// Don't steal the cpu from the mplayer which is playing the file
+	if (process) setpriority(PRIO_PROCESS, process->pid(), 19);
+#endif
+}
+
+void SeekThumbnails::processFinished() {
+	// Called again if the process crashed
+	if (!process) return;
+
+	process->deleteLater();
+	process = 0;
+
+	QStringList files = QDir(temp_dir).entryList(QStringList() << "*.jpg", QDir::Files, QDir::Name);
+	qDebug("SeekThumbnails::processFinished: %d thumbnails", files.count());
+
+	QImage first;
+	if ((files.isEmpty()) || (!first.load(temp_dir + "/" + files[0]))) {
+		// Don't decode the file again every time mplayer is restarted
+		cleanDir();
+		failed = true;
+		return;
+	}
+
+	count = files.count();
+	thumb_size = first.size();
+
+	int cols = qMin(count, GRID_COLUMNS);
+	int rows = (count + GRID_COLUMNS - 1) / GRID_COLUMNS;
+	QImage g(cols * thumb_size.width(), rows * thumb_size.height(), QImage::Format_RGB32);
+	g.fill(0);
+
+	QPainter painter(&g);
+	for (int n = 0; n < count; n++) {
+		QImage img(temp_dir + "/" + files[n]);
+		if (img.isNull()) continue;
+		QPoint p((n % GRID_COLUMNS) * thumb_size.width(), (n / GRID_COLUMNS) * thumb_size.height());
+		painter.drawImage(QRect(p, thumb_size), img);
+	}
+	painter.end();
+
+	cleanDir();
+
+	grid = g;
+	saveCache(cache_file);
+
+	emit ready();
+}
+
+QPixmap SeekThumbnails::thumbnailAt(double sec) {
+	if ((grid.isNull()) || (count < 1) || (interval <= 0)) return QPixmap();
+
+	int n = qBound(0, qRound(sec / interval), count - 1);
+	QRect r((n % GRID_COLUMNS) * thumb_size.width(), (n / GRID_COLUMNS) * thumb_size.height(),
+            thumb_size.width(), thumb_size.height());
+
+	return QPixmap::fromImage(grid.copy(r));
+}
+
+bool SeekThumbnails::loadCache(const QString & file) {
+	QFile f(file);
+	if (!f.open(QIODevice::ReadOnly)) return false;
+
+	QDataStream in(&f);
+	in.setVersion(QDataStream::Qt_4_2);
+
+	quint32 magic, version;
+	qint32 c;
+	QByteArray data;
+	in >> magic >> version;
+	if ((in.status() != QDataStream::Ok) || (magic != CACHE_MAGIC) || (version != CACHE_VERSION)) {
+		return false;
+	}
+	in >> interval >> c >> thumb_size >> data;
+	if ((in.status() != QDataStream::Ok) || (c < 1) || (interval <= 0) || (thumb_size.isEmpty())) {
+		return false;
+	}
+
+	QImage g;
+	if (!g.loadFromData(data, "JPG")) return false;
+
+	int rows = (c + GRID_COLUMNS - 1) / GRID_COLUMNS;
+	if ((g.width() < qMin((int) c, GRID_COLUMNS) * thumb_size.width()) ||
+        (g.height() < rows * thumb_size.height()))
+	{
+		return false;
+	}
+
+	count = c;
+	grid = g;
+
+	// pruneCache() removes the least recently used files
+	f.close();
+	utime(QFile::encodeName(file).constData(), 0);
+
+	return true;
+}
+
+void SeekThumbnails::saveCache(const QString & file) {
+	QDir d;
+	if ((!d.exists(cache_dir)) && (!d.mkpath(cache_dir))) return;
+
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly);
+	if (!grid.save(&buffer, "JPG", 80)) return;
+
+	QFile f(file);
+	if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		qWarning("SeekThumbnails::saveCache: can't open '%s'", file.toUtf8().constData());
+		return;
+	}
+
+	QDataStream out(&f);
+	out.setVersion(QDataStream::Qt_4_2);
+	out << (quint32) CACHE_MAGIC << (quint32) CACHE_VERSION
+        << interval << (qint32) count << thumb_size << data;
+	f.close();
+
+	pruneCache();
+}
+
+// Removes the least recently used files if there are too many
+void SeekThumbnails::pruneCache() {
+	QFileInfoList l = QDir(cache_dir).entryInfoList(QStringList() << "*.thumbs", QDir::Files, QDir::Time);
+	for (int n = CACHE_MAX_FILES; n < l.count(); n++) {
+		qDebug("SeekThumbnails::pruneCache: removing '%s'", l[n].fileName().toUtf8().constData());
+		QFile::remove(l[n].absoluteFilePath());
+	}
+}
+
+void SeekThumbnails::stopProcess() {
+	if (process) {
+		process->disconnect(this);
+		process->kill();
+		process->waitForFinished(1000);
+		delete process;
+		process = 0;
+	}
+}
+
+void SeekThumbnails::cleanDir() {
+	QDir d(temp_dir);
+	if (!d.exists()) return;
+
+	QStringList l = d.entryList(QDir::Files);
+	for (int n = 0; n < l.count(); n++) {
+		d.remove(l[n]);
+	}
+	QDir().rmdir(temp_dir);
+}
+
+#include "moc_seekthumbnails.cpp"
@@ -0,0 +1,88 @@
+/*  smplayer, GUI front-end for mplayer.
+    Copyright (C) 2006-2012 Ricardo Villalba <rvm@users.sourceforge.net>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef _SEEKTHUMBNAILS_H_
+#define _SEEKTHUMBNAILS_H_
+
+#include <QObject>
+#include <QString>
+#include <QImage>
+#include <QPixmap>
+#include <QProcess>
+
+/*!
+ Creates in the background a grid of small thumbnails of the current
+ file, taken every few seconds by a low priority mplayer which only
+ decodes keyframes. The grid is cached in a directory, keyed by the
+ FileHash of the file, so it's only created once per file.
+*/
+
+class SeekThumbnails : public QObject
+{
+	Q_OBJECT
+
+public:
+	SeekThumbnails(const QString & cache_dir, QObject * parent = 0);
+	~SeekThumbnails();
+
+	void setMplayerPath(const QString & mplayer_path) { mplayer_bin = mplayer_path; };
+	QString mplayerPath() { return mplayer_bin; };
+
+	//! Loads the thumbnails of filename or starts creating them.
+	//! Nothing is done if they're already loaded or being created,
+	//! or if creating them has already failed.
+	void setFile(const QString & filename, double duration);
+	void clear();
+
+	bool isReady() { return !grid.isNull(); };
+	double duration() { return media_duration; };
+
+	//! Returns the thumbnail nearest to sec
+	QPixmap thumbnailAt(double sec);
+
+signals:
+	void ready();
+
+protected slots:
+	void processStarted();
+	void processFinished();
+
+protected:
+	bool loadCache(const QString & file);
+	void saveCache(const QString & file);
+	void pruneCache();
+	void stopProcess();
+	void cleanDir();
+
+	QString cache_dir;
+	QString mplayer_bin;
+	QString temp_dir;
+	QString cache_file;
+	QString current_file;
+
+	QProcess * process;
+	bool failed; // Creating the thumbnails of current_file failed
+
+	double media_duration;
+	double interval;
+	int count;
+	QSize thumb_size;
+	QImage grid;
+};
+
+#endif
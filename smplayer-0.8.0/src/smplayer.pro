@@ -53,16 +53,19 @@ HEADERS += guiconfig.h \
 	mplayerversion.h \
 	mplayerprocess.h \
 	infoprovider.h \
+	mediainfocache.h \
 	mplayerwindow.h \
 	mediadata.h \
 	audioequalizerlist.h \
 	mediasettings.h \
 	assstyles.h \
 	filters.h \
+	filterchain.h \
 	preferences.h \
 	filesettingsbase.h \
 	filesettings.h \
 	filesettingshash.h \
+	filesettingsstore.h \
 	filehash.h \
 	tvsettings.h \
 	images.h \
@@ -72,6 +75,7 @@ HEADERS += guiconfig.h \
 	urlhistory.h \
 	core.h \
 	logwindow.h \
+	logbuffer.h \
 	infofile.h \
 	seekwidget.h \
 	mytablewidget.h \
@@ -99,6 +103,7 @@ HEADERS += guiconfig.h \
 	preftv.h \
 	filepropertiesdialog.h \
 	playlist.h \
+	playlistmodel.h \
 	playlistdock.h \
 	verticaltext.h \
 	eqslider.h \
@@ -106,6 +111,7 @@ HEADERS += guiconfig.h \
 	audioequalizer.h \
 	myslider.h \
 	timeslider.h \
+	seekthumbnails.h \
 	inputdvddirectory.h \
 	inputurl.h \
 	myaction.h \
@@ -151,15 +157,18 @@ SOURCES	+= version.cpp \
 	mplayerversion.cpp \
 	mplayerprocess.cpp \
 	infoprovider.cpp \
+	mediainfocache.cpp \
 	mplayerwindow.cpp \
 	mediadata.cpp \
 	mediasettings.cpp \
 	assstyles.cpp \
 	filters.cpp \
+	filterchain.cpp \
 	preferences.cpp \
 	filesettingsbase.cpp \
 	filesettings.cpp \
 	filesettingshash.cpp \
+	filesettingsstore.cpp \
 	filehash.cpp \
 	tvsettings.cpp \
 	images.cpp \
@@ -169,6 +178,7 @@ SOURCES	+= version.cpp \
 	urlhistory.cpp \
 	core.cpp \
 	logwindow.cpp \
+	logbuffer.cpp \
 	infofile.cpp \
 	seekwidget.cpp \
 	mytablewidget.cpp \
@@ -196,6 +206,7 @@ SOURCES	+= version.cpp \
 	preftv.cpp \
 	filepropertiesdialog.cpp \
 	playlist.cpp \
+	playlistmodel.cpp \
 	playlistdock.cpp \
 	verticaltext.cpp \
 	eqslider.cpp \
@@ -203,6 +214,7 @@ SOURCES	+= version.cpp \
 	audioequalizer.cpp \
 	myslider.cpp \
 	timeslider.cpp \
+	seekthumbnails.cpp \
 	inputdvddirectory.cpp \
 	inputurl.cpp \
 	myaction.cpp \
@@ -17,15 +17,22 @@
 */
 
 #include "timeslider.h"
+#include "seekthumbnails.h"
+#include "helper.h"
 
 #include <QWheelEvent>
 #include <QTimer>
+#include <QLabel>
+#include <QPainter>
+#include <QStyle>
 
 #define DEBUG 0
 
 TimeSlider::TimeSlider( QWidget * parent ) : MySlider(parent)
 {
 	dont_update = FALSE;
+	thumbnails = 0;
+	thumbnail_label = 0;
 	setMinimum(0);
 #ifdef SEEKBAR_RESOLUTION
 	setMaximum(SEEKBAR_RESOLUTION);
@@ -35,6 +42,7 @@ TimeSlider::TimeSlider( QWidget * parent ) : MySlider(parent)
 
 	setFocusPolicy( Qt::NoFocus );
 	setSizePolicy( QSizePolicy::Expanding , QSizePolicy::Fixed );
+	setMouseTracking(true);
 
 	connect( this, SIGNAL( sliderPressed() ), this, SLOT( stopUpdate() ) );
 	connect( this, SIGNAL( sliderReleased() ), this, SLOT( resumeUpdate() ) );
@@ -59,6 +67,7 @@ void TimeSlider::stopUpdate() {
 
 void TimeSlider::resumeUpdate() {
 	dont_update = FALSE;
+	hideThumbnail();
 }
 
 void TimeSlider::mouseReleased() {
@@ -117,5 +126,58 @@ void TimeSlider::wheelEvent( QWheelEvent * e ) {
 	e->ignore();
 }
 
+void TimeSlider::mouseMoveEvent( QMouseEvent * e ) {
+	MySlider::mouseMoveEvent(e);
+
+	if ((thumbnails) && (thumbnails->isReady()) && (isEnabled())) {
+		if (isSliderDown()) {
+			showThumbnail(value(), e->x());
+		} else {
+			int v = QStyle::sliderValueFromPosition(minimum(), maximum(), e->x(), width(),
+                                                    layoutDirection() == Qt::RightToLeft);
+			showThumbnail(v, e->x());
+		}
+	}
+}
+
+void TimeSlider::leaveEvent( QEvent * e ) {
+	MySlider::leaveEvent(e);
+	if (!isSliderDown()) hideThumbnail();
+}
+
+void TimeSlider::hideEvent( QHideEvent * e ) {
+	MySlider::hideEvent(e);
+	hideThumbnail();
+}
+
+void TimeSlider::showThumbnail(int v, int x) {
+	if (maximum() <= minimum()) return;
+
+	double sec = thumbnails->duration() * (v - minimum()) / (maximum() - minimum());
+	QPixmap pixmap = thumbnails->thumbnailAt(sec);
+	if (pixmap.isNull()) return;
+
+	QPainter painter(&pixmap);
+	painter.setPen(Qt::white);
+	painter.drawText(pixmap.rect().adjusted(2, 2, -2, -2), Qt::AlignRight | Qt::AlignBottom,
+                     Helper::formatTime((int) sec));
+	painter.end();
+
+	if (!thumbnail_label) {
+		thumbnail_label = new QLabel(this, Qt::ToolTip);
+		thumbnail_label->setFrameStyle(QFrame::Box | QFrame::Plain);
+	}
+	thumbnail_label->setPixmap(pixmap);
+	thumbnail_label->adjustSize();
+
+	QPoint p = mapToGlobal(QPoint(x - thumbnail_label->width() / 2, -thumbnail_label->height() - 2));
+	thumbnail_label->move(p);
+	thumbnail_label->show();
+}
+
+void TimeSlider::hideThumbnail() {
+	if (thumbnail_label) thumbnail_label->hide();
+}
+
 
 #include "moc_timeslider.cpp"
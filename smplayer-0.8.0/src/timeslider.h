@@ -22,6 +22,9 @@
 #include "myslider.h"
 #include "config.h"
 
+class QLabel;
+class SeekThumbnails;
+
 class TimeSlider : public MySlider 
 {
 	Q_OBJECT
@@ -30,6 +33,9 @@ public:
 	TimeSlider( QWidget * parent );
 	~TimeSlider();
 
+	//! Thumbnails shown while hovering or dragging the slider
+	void setThumbnails(SeekThumbnails * t) { thumbnails = t; };
+
 public slots:
 	virtual void setPos(int); // Don't use setValue!
 	virtual int pos();
@@ -58,9 +64,20 @@ protected slots:
 
 	virtual void wheelEvent( QWheelEvent * e );
 
+protected:
+	virtual void mouseMoveEvent( QMouseEvent * e );
+	virtual void leaveEvent( QEvent * e );
+	virtual void hideEvent( QHideEvent * e );
+
+	void showThumbnail(int v, int x);
+	void hideThumbnail();
+
 private:
 	bool dont_update;
 	int position;
+
+	SeekThumbnails * thumbnails;
+	QLabel * thumbnail_label;
 	
 #if ENABLE_DELAYED_DRAGGING
 	int last_pos_to_send;
@@ -37,11 +37,10 @@
 #include <QPixmapCache>
 #include <QImageWriter>
 #include <QImageReader>
+#include <QThread>
 
 #include <cmath>
 
-#define RENAME_PICTURES 0
-
 VideoPreview::VideoPreview(QString mplayer_path, QWidget * parent) : QWidget(parent, Qt::Window)
 {
 	setMplayerPath(mplayer_path);
@@ -220,8 +219,6 @@ bool VideoPreview::extractImages() {
 	length -= prop.initial_step;
 	int s_step = length / num_pictures;
 
-	int current_time = prop.initial_step;
-
 	canceled = false;
 	progress->setLabelText(tr("Creating thumbnails..."));
 	progress->setRange(0, num_pictures-1);
@@ -230,52 +227,121 @@ bool VideoPreview::extractImages() {
 	double aspect_ratio = i.aspect;
 	if (prop.aspect_ratio != 0) aspect_ratio = prop.aspect_ratio;
 
-	for (int n = 0; n < num_pictures; n++) {
-		qDebug("VideoPreview::extractImages: getting frame %d of %d...", n+1, num_pictures);
-		progress->setValue(n);
-		qApp->processEvents();
-
-		if (canceled) return false;
+	// Instead of launching mplayer once per picture, the pictures are
+	// split in contiguous ranges and every range is extracted in a single
+	// pass by one mplayer (using -sstep to jump between the positions).
+	// The ranges run in parallel, as many as processors are available.
+	int num_jobs = qBound(1, QThread::idealThreadCount(), num_pictures);
+	qDebug("VideoPreview::extractImages: %d pictures, %d processes", num_pictures, num_jobs);
+
+	QList<ExtractJob> jobs;
+	int first = 0;
+	for (int n = 0; n < num_jobs; n++) {
+		ExtractJob job;
+		job.first = first;
+		job.count = num_pictures / num_jobs + ((n < num_pictures % num_jobs) ? 1 : 0);
+		job.dir = full_output_dir + "/" + QString::number(n);
+		job.process = new QProcess(this);
+		jobs.append(job);
+		first += job.count;
+
+		d.mkpath(job.dir);
+		QStringList args = mplayerArgs(job.dir, prop.initial_step + job.first * s_step, job.count, s_step, aspect_ratio);
+		qDebug("VideoPreview::extractImages: command: %s %s", mplayer_bin.toUtf8().constData(), args.join(" ").toUtf8().constData());
+		job.process->start(mplayer_bin, args);
+	}
 
-		if (!runMplayer(current_time, aspect_ratio)) return false;
+	bool result = collectPictures(jobs, s_step, aspect_ratio);
 
-		QString frame_picture = full_output_dir + "/" + framePicture();
-		if (!QFile::exists(frame_picture)) {
-			error_message = tr("The file %1 doesn't exist").arg(frame_picture);
-			return false;
+	for (int n = 0; n < jobs.count(); n++) {
+		if (jobs[n].process->state() != QProcess::NotRunning) {
+			jobs[n].process->kill();
+			jobs[n].process->waitForFinished();
 		}
+		delete jobs[n].process;
+		cleanDir(jobs[n].dir);
+	}
 
-#if RENAME_PICTURES 
-		QString extension = (extractFormat()==PNG) ? "png" : "jpg";
-		QString output_file = output_dir + QString("/picture_%1.%2").arg(current_time, 8, 10, QLatin1Char('0')).arg(extension);
-		d.rename(output_dir + "/" + framePicture(), output_file);
-#else
-		QString output_file = output_dir + "/" + framePicture();
-#endif
+	return result;
+}
+
+bool VideoPreview::collectPictures(QList<ExtractJob> & jobs, int s_step, double aspect_ratio) {
+	QString extension = (extractFormat()==PNG) ? "png" : "jpg";
+	QStringList filter;
+	filter << "*." + extension;
+
+	for (int j = 0; j < jobs.count(); j++) {
+		ExtractJob & job = jobs[j];
 
-		if (!addPicture(QDir::tempPath() +"/"+ output_file, n, current_time)) {
+		if (!job.process->waitForStarted()) {
+			qDebug("VideoPreview::collectPictures: error running process");
+			error_message = tr("The mplayer process didn't run");
 			return false;
 		}
 
-		current_time += s_step;
+		// Keep the progress dialog alive while the other ranges are
+		// being extracted too
+		while (!job.process->waitForFinished(100)) {
+			if (job.process->state() == QProcess::NotRunning) break;
+			progress->setValue(job.first + QDir(job.dir).entryList(filter, QDir::Files).count());
+			qApp->processEvents();
+			if (canceled) return false;
+		}
+
+		for (int k = 0; k < job.count; k++) {
+			int n = job.first + k;
+			int current_time = prop.initial_step + n * s_step;
+			qDebug("VideoPreview::collectPictures: getting frame %d of %d...", n+1, prop.n_cols * prop.n_rows);
+			progress->setValue(n);
+			qApp->processEvents();
+
+			if (canceled) return false;
+
+			QString frame_picture = job.dir + "/" + QString("%1.%2").arg(k+1, 8, 10, QLatin1Char('0')).arg(extension);
+			if (!QFile::exists(frame_picture)) {
+				// mplayer stopped early (e.g. a seek went past the end),
+				// try again with a process just for this picture
+				qDebug("VideoPreview::collectPictures: '%s' not found, falling back to a single frame", frame_picture.toUtf8().constData());
+				if (!runMplayer(current_time, aspect_ratio)) return false;
+
+				frame_picture = full_output_dir + "/" + framePicture();
+				if (!QFile::exists(frame_picture)) {
+					error_message = tr("The file %1 doesn't exist").arg(frame_picture);
+					return false;
+				}
+			}
+
+			bool ok = addPicture(frame_picture, n, current_time);
+			QFile::remove(frame_picture);
+			if (!ok) return false;
+		}
 	}
 
 	return true;
 }
 
-bool VideoPreview::runMplayer(int seek, double aspect_ratio) {
+QStringList VideoPreview::mplayerArgs(const QString & outdir, int seek, int frames, int step, double aspect_ratio) {
 	QStringList args;
 	args << "-nosound";
 
 	if (prop.extract_format == PNG) {
 		args << "-vo"
-		<< "png:outdir=\""+full_output_dir+"\"";
+		<< "png:outdir=\""+outdir+"\"";
 	} else {
 		args << "-vo"
-		<< "jpeg:outdir=\""+full_output_dir+"\"";
+		<< "jpeg:outdir=\""+outdir+"\"";
 	}
 
-	args << "-frames" << "6" << "-ss" << QString::number(seek);
+	args << "-frames" << QString::number(frames) << "-ss" << QString::number(seek);
+
+	if (step > 0) {
+		// Every picture of a range is the first frame after a jump, which
+		// is often grey or smeared when it isn't a keyframe. So only the
+		// keyframes are decoded (the single frame passes use the last of
+		// several frames instead, see framePicture()).
+		args << "-sstep" << QString::number(step)
+		<< "-lavdopts" << "skipframe=nonkey";
+	}
 
 	if (aspect_ratio != 0) {
 		args << "-aspect" << QString::number(aspect_ratio) << "-zoom";
@@ -293,6 +359,12 @@ bool VideoPreview::runMplayer(int seek, double aspect_ratio) {
 
 	args << prop.input_video;
 
+	return args;
+}
+
+bool VideoPreview::runMplayer(int seek, double aspect_ratio) {
+	QStringList args = mplayerArgs(full_output_dir, seek, 6, 0, aspect_ratio);
+
 	QString command = mplayer_bin + " ";
 	for (int n = 0; n < args.count(); n++) command = command + args[n] + " ";
 	qDebug("VideoPreview::runMplayer: command: %s", command.toUtf8().constData());
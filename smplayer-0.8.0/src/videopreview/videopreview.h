@@ -22,8 +22,10 @@
 #include <QWidget>
 #include <QString>
 #include <QList>
+#include <QStringList>
 
 class QProgressDialog;
+class QProcess;
 class QGridLayout;
 class QLabel;
 class QScrollArea;
@@ -116,7 +118,16 @@ protected:
 	virtual void changeEvent( QEvent * event );
 
 protected:
+	// A single mplayer extracting a contiguous range of the pictures
+	struct ExtractJob {
+		QProcess * process;
+		QString dir;
+		int first, count;
+	};
+
 	bool extractImages();
+	bool collectPictures(QList<ExtractJob> & jobs, int s_step, double aspect_ratio);
+	QStringList mplayerArgs(const QString & outdir, int seek, int frames, int step, double aspect_ratio);
 	bool runMplayer(int seek, double aspect_ratio);
 	bool addPicture(const QString & filename, int num, int time); 
 	void displayVideoInfo(const VideoInfo & i);
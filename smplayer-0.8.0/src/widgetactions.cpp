@@ -58,11 +58,22 @@ TimeSliderAction::TimeSliderAction( QWidget * parent )
 #if ENABLE_DELAYED_DRAGGING
 	drag_delay = 200;
 #endif
+	thumbnails = 0;
 }
 
 TimeSliderAction::~TimeSliderAction() {
 }
 
+void TimeSliderAction::setThumbnails(SeekThumbnails * t) {
+	thumbnails = t;
+
+	QList<QWidget *> l = createdWidgets();
+	for (int n=0; n < l.count(); n++) {
+		TimeSlider *s = (TimeSlider*) l[n];
+		s->setThumbnails(thumbnails);
+	}
+}
+
 void TimeSliderAction::setPos(int v) {
 	QList<QWidget *> l = createdWidgets();
 	for (int n=0; n < l.count(); n++) {
@@ -102,6 +113,7 @@ int TimeSliderAction::dragDelay() {
 QWidget * TimeSliderAction::createWidget ( QWidget * parent ) {
 	TimeSlider *t = new TimeSlider(parent);
 	t->setEnabled( isEnabled() );
+	t->setThumbnails(thumbnails);
 
 	if (custom_style) t->setStyle(custom_style);
 	if (!custom_stylesheet.isEmpty()) t->setStyleSheet(custom_stylesheet);
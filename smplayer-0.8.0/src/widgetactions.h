@@ -61,16 +61,21 @@ public:
 	TimeSliderAction( QWidget * parent );
 	~TimeSliderAction();
 
+	void setThumbnails(SeekThumbnails * t);
+
 public slots:
 	virtual void setPos(int);
 	virtual int pos();
 #if ENABLE_DELAYED_DRAGGING
 	void setDragDelay(int);
 	int dragDelay();
+#endif
 
 private:
+#if ENABLE_DELAYED_DRAGGING
 	int drag_delay;
 #endif
+	SeekThumbnails * thumbnails;
 
 signals:
 	void posChanged(int value);
@@ -0,0 +1,63 @@
+#!/bin/sh
+
+# Checks that the filter toggles change the filters of the running
+# mplayer with slave commands, and that mplayer is restarted when
+# one of those commands fails. mplayer is replaced by fake_mplayer.sh.
+#
+# Usage: check_filters.sh [path to the smplayer binary]
+# It needs a display, e.g. run it with xvfb-run.
+
+here=$(cd "$(dirname "$0")" && pwd)
+smplayer=${1:-$here/../src/smplayer}
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' 0
+
+mkdir -p "$tmp/smplayer"
+cat > "$tmp/smplayer/smplayer.ini" <<EOF
+[general]
+mplayer_bin=$here/fake_mplayer.sh
+
+[gui]
+seekbar_thumbnails=false
+
+[instances]
+single_instance_enabled=false
+EOF
+touch "$tmp/movie.avi"
+
+failed=0
+
+fail() {
+	echo "FAILED: $1"
+	failed=1
+}
+
+# $1: filters the fake mplayer can't add, $2: actions to run
+run() {
+	: > "$tmp/log"
+	FAKE_MPLAYER_LOG="$tmp/log" FAKE_MPLAYER_BAD_FILTERS="$1" XDG_CONFIG_HOME="$tmp" \
+		"$smplayer" -close-at-end -actions "$2" "$tmp/movie.avi" > "$tmp/output" 2>&1
+}
+
+starts() {
+	grep -c "^START " "$tmp/log"
+}
+
+# The toggles don't restart mplayer
+run "" "flip mirror karaoke_filter"
+[ "$(starts)" = "1" ] || fail "mplayer was started $(starts) times"
+grep -q "^CMD vf_add .*flip" "$tmp/log" || fail "flip wasn't added with vf_add"
+grep -q "^CMD vf_add .*mirror" "$tmp/log" || fail "mirror wasn't added with vf_add"
+grep -q "^CMD af_add .*karaoke" "$tmp/log" || fail "karaoke wasn't added with af_add"
+
+# A filter mplayer can't add makes smplayer start it again
+run "karaoke" "karaoke_filter"
+[ "$(starts)" = "2" ] || fail "mplayer was started $(starts) times after a failed af_add"
+grep "^START " "$tmp/log" | tail -n 1 | grep -q "karaoke" || \
+	fail "mplayer wasn't restarted with the karaoke filter"
+
+if [ $failed = 0 ]; then
+	echo "OK"
+fi
+exit $failed
@@ -0,0 +1,104 @@
+#!/bin/sh
+
+# A scripted stand-in for mplayer, used by check_filters.sh.
+# It answers "-input cmdlist", "plays" for FAKE_MPLAYER_LENGTH seconds
+# and writes every start and every slave command to FAKE_MPLAYER_LOG.
+# The filters listed in FAKE_MPLAYER_BAD_FILTERS fail to be added
+# with vf_add or af_add, with the messages mplayer prints in that case.
+
+log=${FAKE_MPLAYER_LOG:-/dev/null}
+length=${FAKE_MPLAYER_LENGTH:-6}
+
+echo "MPlayer SVN-r34540 (C) 2000-2012 MPlayer Team"
+
+case " $* " in
+	*" -input cmdlist "*)
+		for command in pause quit seek osd osd_show_text get_property set_property \
+                       vf_add vf_del af_add af_del
+		do
+			echo "$command                 String"
+		done
+		exit 0
+		;;
+	*" -slave "*)
+		;;
+	*)
+		# -identify -vo help ..., thumbnails and other helper runs
+		exit 0
+		;;
+esac
+
+echo "START $*" >> "$log"
+
+cat <<EOF
+ID_VIDEO_ID=0
+ID_AUDIO_ID=0
+ID_DEMUXER=lavfpref
+ID_VIDEO_FORMAT=H264
+ID_VIDEO_BITRATE=0
+ID_VIDEO_WIDTH=320
+ID_VIDEO_HEIGHT=240
+ID_VIDEO_FPS=25.000
+ID_VIDEO_ASPECT=1.3333
+ID_AUDIO_FORMAT=85
+ID_AUDIO_BITRATE=128000
+ID_AUDIO_RATE=44100
+ID_AUDIO_NCH=2
+ID_START_TIME=0.00
+ID_LENGTH=$length.00
+ID_SEEKABLE=1
+ID_VIDEO_CODEC=ffh264
+ID_AUDIO_CODEC=mpg123
+VO: [xv] 320x240 => 320x240 Planar YV12
+AO: [pulse] 44100Hz 2ch s16le (2 bytes per sample)
+Starting playback...
+EOF
+
+# Asynchronous lists get /dev/null as stdin, so the slave
+# commands are read from a copy of it
+exec 3<&0
+
+reader() {
+	while read -r command args <&3; do
+		echo "CMD $command $args" >> "$log"
+		case $command in
+			vf_add|af_add)
+				for filter in $(echo "$args" | tr ',' ' '); do
+					name=${filter%%=*}
+					case " $FAKE_MPLAYER_BAD_FILTERS " in
+						*" $name "*)
+							if [ "$command" = "vf_add" ]; then
+								echo "Couldn't open video filter '$name'."
+							else
+								echo "[libaf] Couldn't create or open audio filter '$name'"
+							fi
+							;;
+					esac
+				done
+				;;
+			quit)
+				kill $main_pid 2> /dev/null
+				exit 0
+				;;
+		esac
+	done
+}
+
+# "quit" ends the playback like in mplayer
+trap 'exit 0' TERM
+
+main_pid=$$
+reader &
+reader_pid=$!
+
+sec=0
+while [ $sec -lt $length ]; do
+	echo "A:   $sec.0 V:   $sec.0 A-V:  0.000 ct:  0.000 $((sec * 25))/$((sec * 25))  1%  1%  0.1% 0 0"
+	sleep 1
+	sec=$((sec + 1))
+done
+
+echo "Exiting... (End of file)"
+echo "ID_EXIT=EOF"
+kill $reader_pid 2> /dev/null
+exit 0